@@ -0,0 +1,109 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_BENCHMARKS_COMMON_HH
+#define DUNE_PYMOR_BENCHMARKS_COMMON_HH
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <dune/stuff/common/string.hh>
+#include <dune/stuff/la/container/common.hh>
+#include <dune/stuff/la/container/eigen.hh>
+#include <dune/stuff/la/container/istl.hh>
+#include <dune/stuff/la/container/pattern.hh>
+
+#include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/la/container/affine.hh>
+
+namespace Benchmarks {
+
+
+/**
+ * \brief A tridiagonal, diagonally dominant pattern, as obtained from a 1d finite element discretization.
+ */
+inline Dune::Stuff::LA::SparsityPatternDefault tridiagonal_pattern(const size_t size)
+{
+  Dune::Stuff::LA::SparsityPatternDefault pattern(size);
+  for (size_t ii = 0; ii < size; ++ii) {
+    if (ii > 0)
+      pattern.insert(ii, ii - 1);
+    pattern.insert(ii, ii);
+    if (ii + 1 < size)
+      pattern.insert(ii, ii + 1);
+  }
+  pattern.sort();
+  return pattern;
+} // ... tridiagonal_pattern(...)
+
+
+template< class MatrixType >
+MatrixType* create_matrix(const size_t size, const double scale = 1.0)
+{
+  auto* matrix = new MatrixType(size, size, tridiagonal_pattern(size));
+  for (size_t ii = 0; ii < size; ++ii) {
+    if (ii > 0)
+      matrix->set_entry(ii, ii - 1, -1.0*scale);
+    matrix->set_entry(ii, ii, 4.0*scale);
+    if (ii + 1 < size)
+      matrix->set_entry(ii, ii + 1, -1.0*scale);
+  }
+  return matrix;
+} // ... create_matrix(...)
+
+
+template< class VectorType >
+VectorType* create_vector(const size_t size, const double value = 1.0)
+{
+  return new VectorType(size, value);
+}
+
+
+/**
+ * \brief The parameter type "theta" of size num_components, each component q of the container has the coefficient
+ *        "theta[q]" (or an interpreted expression, if interpreted is true).
+ */
+inline Dune::Pymor::ParameterType component_parameter_type(const size_t num_components)
+{
+  return Dune::Pymor::ParameterType("theta", num_components);
+}
+
+
+inline std::string component_expression(const size_t qq, const bool interpreted)
+{
+  const std::string variable = "theta[" + Dune::Stuff::Common::toString(qq) + "]";
+  return interpreted ? "2*" + variable + " + sin(" + variable + ")" : variable;
+}
+
+
+inline Dune::Pymor::Parameter component_parameter(const size_t num_components)
+{
+  std::vector< double > values(num_components);
+  for (size_t qq = 0; qq < num_components; ++qq)
+    values[qq] = 1.0/(qq + 1.0);
+  return Dune::Pymor::Parameter("theta", values);
+}
+
+
+template< class ContainerType >
+Dune::Pymor::LA::AffinelyDecomposedContainer< ContainerType >
+create_affine_matrix(const size_t size, const size_t num_components, const bool interpreted = false)
+{
+  Dune::Pymor::LA::AffinelyDecomposedContainer< ContainerType > ret;
+  ret.register_affine_part(create_matrix< ContainerType >(size));
+  const auto type = component_parameter_type(num_components);
+  for (size_t qq = 0; qq < num_components; ++qq)
+    ret.register_component(create_matrix< ContainerType >(size, qq + 1.0),
+                           new Dune::Pymor::ParameterFunctional(type, component_expression(qq, interpreted)));
+  return ret;
+} // ... create_affine_matrix(...)
+
+
+} // namespace Benchmarks
+
+#endif // DUNE_PYMOR_BENCHMARKS_COMMON_HH
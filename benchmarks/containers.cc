@@ -0,0 +1,47 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include "common.hh"
+
+using namespace Dune;
+
+
+template< class MatrixType >
+static void AffinelyDecomposedContainer_freeze_parameter(benchmark::State& state)
+{
+  const size_t size = state.range(0);
+  const size_t num_components = state.range(1);
+  const auto container = Benchmarks::create_affine_matrix< MatrixType >(size, num_components);
+  const auto mu = Benchmarks::component_parameter(num_components);
+  for (auto _ : state) {
+    auto frozen = container.freeze_parameter(mu);
+    benchmark::DoNotOptimize(frozen);
+  }
+}
+
+
+BENCHMARK_TEMPLATE(AffinelyDecomposedContainer_freeze_parameter, Stuff::LA::CommonDenseMatrix< double >)
+    ->ArgsProduct({{100, 400}, {1, 4, 16}});
+
+#if HAVE_EIGEN
+
+BENCHMARK_TEMPLATE(AffinelyDecomposedContainer_freeze_parameter, Stuff::LA::EigenDenseMatrix< double >)
+    ->ArgsProduct({{100, 400}, {1, 4, 16}});
+BENCHMARK_TEMPLATE(AffinelyDecomposedContainer_freeze_parameter, Stuff::LA::EigenRowMajorSparseMatrix< double >)
+    ->ArgsProduct({{1000, 100000}, {1, 4, 16}});
+
+#endif // HAVE_EIGEN
+
+#if HAVE_DUNE_ISTL
+
+BENCHMARK_TEMPLATE(AffinelyDecomposedContainer_freeze_parameter, Stuff::LA::IstlRowMajorSparseMatrix< double >)
+    ->ArgsProduct({{1000, 100000}, {1, 4, 16}});
+
+#endif // HAVE_DUNE_ISTL
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,33 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include <memory>
+#include <vector>
+
+#include <stationarylinear.hh>
+
+#include "common.hh"
+
+using namespace Dune;
+
+
+static void StationaryLinear_solve(benchmark::State& state)
+{
+  const std::unique_ptr< const Example::AnalyticalProblem > problem(new Example::AnalyticalProblem(state.range(0)));
+  const Example::SimpleDiscretization discretization(problem.get());
+  const std::vector< double > ones(problem->dim(), 1.0);
+  const Pymor::Parameter mu = {{"diffusion", "dirichlet", "force", "neumann"}, {ones, ones, ones, ones}};
+  auto solution = discretization.create_vector();
+  for (auto _ : state) {
+    discretization.solve(solution, mu);
+    benchmark::DoNotOptimize(solution);
+  }
+}
+BENCHMARK(StationaryLinear_solve)->Arg(4)->Arg(16)->Arg(64);
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,123 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include <memory>
+
+#include <dune/pymor/operators/base.hh>
+#include <dune/pymor/operators/affine.hh>
+
+#include "common.hh"
+
+using namespace Dune;
+
+
+template< class MatrixType, class VectorType >
+static void MatrixBasedDefault_apply(benchmark::State& state)
+{
+  const size_t size = state.range(0);
+  const Pymor::Operators::MatrixBasedDefault< MatrixType, VectorType >
+      op(Benchmarks::create_matrix< MatrixType >(size));
+  const std::unique_ptr< VectorType > source(Benchmarks::create_vector< VectorType >(size));
+  VectorType range(size, 0.0);
+  for (auto _ : state) {
+    op.apply(*source, range);
+    benchmark::DoNotOptimize(range);
+  }
+}
+
+
+template< class MatrixType, class VectorType >
+static void MatrixBasedDefault_apply_inverse(benchmark::State& state)
+{
+  const size_t size = state.range(0);
+  const Pymor::Operators::MatrixBasedDefault< MatrixType, VectorType >
+      op(Benchmarks::create_matrix< MatrixType >(size));
+  const std::unique_ptr< VectorType > range(Benchmarks::create_vector< VectorType >(size));
+  VectorType source(size, 0.0);
+  for (auto _ : state) {
+    op.apply_inverse(*range, source);
+    benchmark::DoNotOptimize(source);
+  }
+}
+
+
+template< class MatrixType, class VectorType >
+static void LinearAffinelyDecomposedContainerBased_apply(benchmark::State& state)
+{
+  const size_t size = state.range(0);
+  const size_t num_components = state.range(1);
+  const Pymor::Operators::LinearAffinelyDecomposedContainerBased< MatrixType, VectorType >
+      op(Benchmarks::create_affine_matrix< MatrixType >(size, num_components));
+  const auto mu = Benchmarks::component_parameter(num_components);
+  const std::unique_ptr< VectorType > source(Benchmarks::create_vector< VectorType >(size));
+  VectorType range(size, 0.0);
+  for (auto _ : state) {
+    op.apply(*source, range, mu);
+    benchmark::DoNotOptimize(range);
+  }
+}
+
+
+template< class MatrixType, class VectorType >
+static void LinearAffinelyDecomposedContainerBased_apply_inverse(benchmark::State& state)
+{
+  const size_t size = state.range(0);
+  const size_t num_components = state.range(1);
+  const Pymor::Operators::LinearAffinelyDecomposedContainerBased< MatrixType, VectorType >
+      op(Benchmarks::create_affine_matrix< MatrixType >(size, num_components));
+  const auto mu = Benchmarks::component_parameter(num_components);
+  const std::unique_ptr< VectorType > range(Benchmarks::create_vector< VectorType >(size));
+  VectorType source(size, 0.0);
+  for (auto _ : state) {
+    op.apply_inverse(*range, source, op.invert_options()[0], mu);
+    benchmark::DoNotOptimize(source);
+  }
+}
+
+
+typedef Stuff::LA::CommonDenseMatrix< double > CommonDenseMatrixType;
+typedef Stuff::LA::CommonDenseVector< double > CommonDenseVectorType;
+
+BENCHMARK_TEMPLATE(MatrixBasedDefault_apply, CommonDenseMatrixType, CommonDenseVectorType)->Arg(100)->Arg(400);
+BENCHMARK_TEMPLATE(MatrixBasedDefault_apply_inverse, CommonDenseMatrixType, CommonDenseVectorType)->Arg(100)->Arg(400);
+BENCHMARK_TEMPLATE(LinearAffinelyDecomposedContainerBased_apply, CommonDenseMatrixType, CommonDenseVectorType)
+    ->ArgsProduct({{100, 400}, {1, 16}});
+BENCHMARK_TEMPLATE(LinearAffinelyDecomposedContainerBased_apply_inverse, CommonDenseMatrixType, CommonDenseVectorType)
+    ->ArgsProduct({{100, 400}, {1, 16}});
+
+#if HAVE_EIGEN
+
+typedef Stuff::LA::EigenRowMajorSparseMatrix< double > EigenSparseMatrixType;
+typedef Stuff::LA::EigenDenseVector< double >          EigenDenseVectorType;
+
+BENCHMARK_TEMPLATE(MatrixBasedDefault_apply, EigenSparseMatrixType, EigenDenseVectorType)->Arg(10000)->Arg(100000);
+BENCHMARK_TEMPLATE(MatrixBasedDefault_apply_inverse, EigenSparseMatrixType, EigenDenseVectorType)
+    ->Arg(10000)->Arg(100000);
+BENCHMARK_TEMPLATE(LinearAffinelyDecomposedContainerBased_apply, EigenSparseMatrixType, EigenDenseVectorType)
+    ->ArgsProduct({{10000, 100000}, {1, 16}});
+BENCHMARK_TEMPLATE(LinearAffinelyDecomposedContainerBased_apply_inverse, EigenSparseMatrixType, EigenDenseVectorType)
+    ->ArgsProduct({{10000, 100000}, {1, 16}});
+
+#endif // HAVE_EIGEN
+
+#if HAVE_DUNE_ISTL
+
+typedef Stuff::LA::IstlRowMajorSparseMatrix< double > IstlSparseMatrixType;
+typedef Stuff::LA::IstlDenseVector< double >          IstlDenseVectorType;
+
+BENCHMARK_TEMPLATE(MatrixBasedDefault_apply, IstlSparseMatrixType, IstlDenseVectorType)->Arg(10000)->Arg(100000);
+BENCHMARK_TEMPLATE(MatrixBasedDefault_apply_inverse, IstlSparseMatrixType, IstlDenseVectorType)
+    ->Arg(10000)->Arg(100000);
+BENCHMARK_TEMPLATE(LinearAffinelyDecomposedContainerBased_apply, IstlSparseMatrixType, IstlDenseVectorType)
+    ->ArgsProduct({{10000, 100000}, {1, 16}});
+BENCHMARK_TEMPLATE(LinearAffinelyDecomposedContainerBased_apply_inverse, IstlSparseMatrixType, IstlDenseVectorType)
+    ->ArgsProduct({{10000, 100000}, {1, 16}});
+
+#endif // HAVE_DUNE_ISTL
+
+
+BENCHMARK_MAIN();
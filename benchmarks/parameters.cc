@@ -0,0 +1,75 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include <memory>
+#include <vector>
+
+#include <dune/pymor/parameters/thetas.hh>
+
+#include "common.hh"
+
+using namespace Dune::Pymor;
+
+
+static void ParameterFunctional_evaluate_direct(benchmark::State& state)
+{
+  const size_t num_components = state.range(0);
+  const ParameterFunctional theta(Benchmarks::component_parameter_type(num_components),
+                                  Benchmarks::component_expression(num_components - 1, false));
+  const auto mu = Benchmarks::component_parameter(num_components);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(theta.evaluate(mu));
+}
+BENCHMARK(ParameterFunctional_evaluate_direct)->Arg(1)->Arg(8)->Arg(64);
+
+
+static void ParameterFunctional_evaluate_interpreted(benchmark::State& state)
+{
+  const size_t num_components = state.range(0);
+  const ParameterFunctional theta(Benchmarks::component_parameter_type(num_components),
+                                  Benchmarks::component_expression(num_components - 1, true));
+  const auto mu = Benchmarks::component_parameter(num_components);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(theta.evaluate(mu));
+}
+BENCHMARK(ParameterFunctional_evaluate_interpreted)->Arg(1)->Arg(8)->Arg(64);
+
+
+static void Parametric_map_parameter(benchmark::State& state)
+{
+  const size_t num_components = state.range(0);
+  const auto container
+      = Benchmarks::create_affine_matrix< Dune::Stuff::LA::CommonDenseMatrix< double > >(2, num_components);
+  const auto mu = Benchmarks::component_parameter(num_components);
+  const std::string id = "coefficient_" + Dune::Stuff::Common::toString(num_components - 1);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(container.map_parameter(mu, id));
+}
+BENCHMARK(Parametric_map_parameter)->Arg(1)->Arg(8)->Arg(64);
+
+
+static void ThetaBundle_evaluate(benchmark::State& state)
+{
+  const size_t num_components = state.range(0);
+  const bool interpreted = state.range(1);
+  std::vector< std::shared_ptr< const ParameterFunctional > > thetas;
+  for (size_t qq = 0; qq < num_components; ++qq)
+    thetas.emplace_back(new ParameterFunctional(Benchmarks::component_parameter_type(num_components),
+                                                Benchmarks::component_expression(qq, interpreted)));
+  const ThetaBundle bundle(thetas);
+  const auto mu = Benchmarks::component_parameter(num_components);
+  std::vector< double > values;
+  for (auto _ : state) {
+    bundle.evaluate(mu, values);
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations()*num_components);
+}
+BENCHMARK(ThetaBundle_evaluate)->ArgsProduct({{1, 8, 64}, {0, 1}});
+
+
+BENCHMARK_MAIN();
@@ -8,15 +8,24 @@
 
 #include "stuff.hh"
 
+#include <dune/pymor/common/memory.hh>
+#include <dune/pymor/common/tracing.hh>
 #include <dune/pymor/discretizations/interfaces.hh>
+#include <dune/pymor/discretizations/multiscale.hh>
 #include <dune/pymor/functionals/affine.hh>
 #include <dune/pymor/functionals/default.hh>
 #include <dune/pymor/functionals/interfaces.hh>
 #include <dune/pymor/la/container/affine.hh>
+#include <dune/pymor/la/gram_schmidt.hh>
+#include <dune/pymor/la/localization.hh>
+#include <dune/pymor/la/pod.hh>
 #include <dune/pymor/operators/base.hh>
 #include <dune/pymor/operators/affine.hh>
 #include <dune/pymor/operators/interfaces.hh>
 #include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/parameters/batch.hh>
 #include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/parameters/sampling.hh>
+#include <dune/pymor/parameters/thetas.hh>
 
 #endif // DUNE_PYMOR_BINDINGS_PYMOR_HH
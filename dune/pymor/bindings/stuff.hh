@@ -15,4 +15,6 @@
 # include <dune/stuff/la/container/istl.hh>
 # include <dune/stuff/la/container/eigen.hh>
 
+# include "threading.hh"
+
 #endif // DUNE_PYMOR_BINDINGS_STUFF_HH
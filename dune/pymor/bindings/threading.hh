@@ -0,0 +1,42 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_BINDINGS_THREADING_HH
+#define DUNE_PYMOR_BINDINGS_THREADING_HH
+
+#include <Python.h>
+
+#include <memory>
+
+#include <dune/pymor/common/threading.hh>
+
+namespace Dune {
+namespace Pymor {
+
+
+/**
+ * \brief Keeps the python object alive until result is set, \see AsyncResult::keep_alive.
+ *
+ *        The reference is released in the thread setting the result, which acquires the GIL to do so.
+ */
+template< class T >
+void keep_alive(const AsyncResult< T >& result, PyObject* object)
+{
+  Py_INCREF(object);
+  result.keep_alive(std::shared_ptr< const void >(object, [](PyObject* obj) {
+    // the interpreter may be gone once the last computation finishes
+    if (!Py_IsInitialized())
+      return;
+    const PyGILState_STATE state = PyGILState_Ensure();
+    Py_DECREF(obj);
+    PyGILState_Release(state);
+  }));
+} // ... keep_alive(...)
+
+
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_BINDINGS_THREADING_HH
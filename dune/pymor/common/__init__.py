@@ -6,3 +6,6 @@
 from __future__ import absolute_import
 
 from .exceptions import inject_exceptions
+from .tracing import inject_tracing
+from .memory import inject_memory
+from .threading import inject_AsyncResult, AsyncResult
@@ -0,0 +1,132 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#if defined(__GLIBC__)
+# include <malloc.h>
+#endif
+
+#include "memory.hh"
+
+namespace Dune {
+namespace Pymor {
+namespace {
+
+
+std::string human_readable(const size_t bytes)
+{
+  static const char* units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+  double value = bytes;
+  size_t unit = 0;
+  while (value >= 1024.0 && unit < 4) {
+    value /= 1024.0;
+    ++unit;
+  }
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(unit == 0 ? 0 : 2) << value << " " << units[unit];
+  return out.str();
+} // ... human_readable(...)
+
+
+} // namespace
+
+
+MemoryFootprint::MemoryFootprint()
+  : total_(0)
+{}
+
+void MemoryFootprint::add(const std::string& name, const void* address, const size_t bytes)
+{
+  const bool shared = (address != nullptr) && !addresses_.insert(address).second;
+  entries_.push_back({name, bytes, shared});
+  if (!shared)
+    total_ += bytes;
+} // ... add(...)
+
+size_t MemoryFootprint::total() const
+{
+  return total_;
+}
+
+DUNE_STUFF_SSIZE_T MemoryFootprint::pb_total() const
+{
+  return total_;
+}
+
+const std::vector< MemoryFootprint::Entry >& MemoryFootprint::entries() const
+{
+  return entries_;
+}
+
+std::string MemoryFootprint::report() const
+{
+  std::vector< Entry > sorted = entries_;
+  std::stable_sort(sorted.begin(), sorted.end(), [](const Entry& a, const Entry& b) { return a.bytes > b.bytes; });
+  size_t width = 5;
+  for (const auto& entry : sorted)
+    width = std::max(width, entry.name.size());
+  std::ostringstream out;
+  for (const auto& entry : sorted) {
+    out << std::left << std::setw(width) << entry.name << "  " << std::right << std::setw(12)
+        << human_readable(entry.bytes);
+    if (entry.shared)
+      out << " (shared)";
+    out << "\n";
+  }
+  out << std::left << std::setw(width) << "total" << "  " << std::right << std::setw(12) << human_readable(total_);
+  return out.str();
+} // ... report(...)
+
+std::string MemoryFootprint::join(const std::string& prefix, const std::string& name)
+{
+  return prefix.empty() ? name : prefix + "." + name;
+}
+
+ProcessMemory process_memory()
+{
+  ProcessMemory ret = {0, 0, 0, 0};
+  // see proc(5)
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    std::istringstream in(line);
+    std::string key;
+    size_t value = 0;
+    in >> key >> value;
+    if (key == "VmRSS:")
+      ret.resident = value*1024;
+    else if (key == "VmHWM:")
+      ret.peak_resident = value*1024;
+    else if (key == "VmSize:")
+      ret.virtual_size = value*1024;
+  }
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  const auto info = mallinfo2();
+  ret.heap_allocated = info.uordblks + info.hblkhd;
+#endif
+  return ret;
+} // ... process_memory(...)
+
+std::string process_memory_summary()
+{
+  const ProcessMemory memory = process_memory();
+  std::ostringstream out;
+  out << "resident:      " << human_readable(memory.resident) << "\n"
+      << "peak resident: " << human_readable(memory.peak_resident) << "\n"
+      << "virtual:       " << human_readable(memory.virtual_size);
+  if (memory.heap_allocated > 0)
+    out << "\n" << "heap (malloc): " << human_readable(memory.heap_allocated);
+  return out.str();
+} // ... process_memory_summary(...)
+
+
+} // namespace Pymor
+} // namespace Dune
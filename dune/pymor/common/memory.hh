@@ -0,0 +1,100 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_COMMON_MEMORY_HH
+#define DUNE_PYMOR_COMMON_MEMORY_HH
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <dune/stuff/common/type_utils.hh>
+
+namespace Dune {
+namespace Pymor {
+
+
+/**
+ * \brief Collects the memory used by (the components of) containers, operators, functionals and discretizations.
+ *
+ *        Each piece of storage is identified by its address and only counted the first time it is added, so that
+ *        storage which is shared between several objects (e.g. by copies of an operator or by components which are
+ *        registered in several containers) is counted once. Usage example:
+\code
+MemoryFootprint footprint;
+op.memory_footprint(footprint, "lhs");
+rhs.memory_footprint(footprint, "rhs");
+std::cout << footprint.report() << std::endl;
+\endcode
+ */
+class MemoryFootprint
+{
+public:
+  struct Entry
+  {
+    std::string name;
+    size_t bytes;
+    //! if true, this storage has already been counted for another entry and does not contribute to total()
+    bool shared;
+  }; // struct Entry
+
+  MemoryFootprint();
+
+  /**
+   * \brief Adds the storage at address with the given size in bytes.
+   */
+  void add(const std::string& name, const void* address, const size_t bytes);
+
+  /**
+   * \brief The bytes of all added storage, shared storage being counted once.
+   */
+  size_t total() const;
+
+  DUNE_STUFF_SSIZE_T pb_total() const;
+
+  const std::vector< Entry >& entries() const;
+
+  /**
+   * \brief A table of all entries, sorted by their size.
+   */
+  std::string report() const;
+
+  static std::string join(const std::string& prefix, const std::string& name);
+
+private:
+  std::set< const void* > addresses_;
+  std::vector< Entry > entries_;
+  size_t total_;
+}; // class MemoryFootprint
+
+
+/**
+ * \brief The memory used by this process.
+ */
+struct ProcessMemory
+{
+  //! the current and peak resident set size, as reported by the operating system, in bytes
+  size_t resident;
+  size_t peak_resident;
+  //! the size of the virtual memory in bytes
+  size_t virtual_size;
+  //! the bytes currently allocated by malloc (0 if this is not available)
+  size_t heap_allocated;
+}; // struct ProcessMemory
+
+
+ProcessMemory process_memory();
+
+/**
+ * \brief A human readable summary of process_memory().
+ */
+std::string process_memory_summary();
+
+
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_COMMON_MEMORY_HH
@@ -0,0 +1,21 @@
+#! /usr/bin/env python
+# This file is part of the dune-pymor project:
+#   https://github.com/pymor/dune-pymor
+# Copyright Holders: Stephan Rave, Felix Schindler
+# License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+import pybindgen
+from pybindgen import retval, param
+
+
+def inject_memory(module, exceptions, CONFIG_H):
+    assert(isinstance(module, pybindgen.module.Module))
+    assert(isinstance(exceptions, list))
+    namespace = module.add_cpp_namespace('Dune').add_cpp_namespace('Pymor')
+    Class = namespace.add_class('MemoryFootprint')
+    Class.add_constructor([])
+    Class.add_copy_constructor()
+    Class.add_method('pb_total', retval(CONFIG_H['DUNE_STUFF_SSIZE_T']), [], is_const=True, custom_name='total')
+    Class.add_method('report', retval('std::string'), [], is_const=True)
+    namespace.add_function('process_memory_summary', retval('std::string'), [], throw=exceptions)
+    return module, Class
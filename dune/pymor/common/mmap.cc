@@ -0,0 +1,83 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include "mmap.hh"
+
+namespace Dune {
+namespace Pymor {
+
+
+MappedFile::MappedFile(const std::string& filename)
+  : filename_(filename)
+  , data_(nullptr)
+  , size_(0)
+{
+  const int fd = ::open(filename_.c_str(), O_RDONLY);
+  if (fd < 0)
+    DUNE_THROW(Stuff::Exceptions::external_error,
+               "could not open '" << filename_ << "' for reading (" << std::strerror(errno) << ")!");
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    const int error = errno;
+    ::close(fd);
+    DUNE_THROW(Stuff::Exceptions::external_error,
+               "could not stat '" << filename_ << "' (" << std::strerror(error) << ")!");
+  }
+  if (info.st_size <= 0) {
+    ::close(fd);
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given, "'" << filename_ << "' is empty!");
+  }
+  size_ = info.st_size;
+  void* ptr = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  const int error = errno;
+  // the mapping stays valid after closing the file descriptor
+  ::close(fd);
+  if (ptr == MAP_FAILED)
+    DUNE_THROW(Stuff::Exceptions::external_error,
+               "could not map '" << filename_ << "' (" << std::strerror(error) << ")!");
+  data_ = static_cast< char* >(ptr);
+} // MappedFile(...)
+
+MappedFile::~MappedFile()
+{
+  if (data_)
+    ::munmap(data_, size_);
+}
+
+const std::string& MappedFile::filename() const
+{
+  return filename_;
+}
+
+const char* MappedFile::data() const
+{
+  return data_;
+}
+
+char* MappedFile::data()
+{
+  return data_;
+}
+
+size_t MappedFile::size() const
+{
+  return size_;
+}
+
+
+} // namespace Pymor
+} // namespace Dune
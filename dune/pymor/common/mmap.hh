@@ -0,0 +1,52 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_COMMON_MMAP_HH
+#define DUNE_PYMOR_COMMON_MMAP_HH
+
+#include <string>
+
+namespace Dune {
+namespace Pymor {
+
+
+/**
+ * \brief Maps a file into memory.
+ *
+ *        The pages of the file are only read upon first access and are shared with all other processes mapping the
+ *        same file (through the page cache), as long as they are not written to. Data copied out of the mapping is of
+ *        course not shared. The mapping is private, i.e. writing to data() is allowed but
+ *        only changes the pages of this process (copy on write) and never the file itself.
+ */
+class MappedFile
+{
+public:
+  explicit MappedFile(const std::string& filename);
+
+  MappedFile(const MappedFile& other) = delete;
+
+  MappedFile& operator=(const MappedFile& other) = delete;
+
+  ~MappedFile();
+
+  const std::string& filename() const;
+
+  const char* data() const;
+
+  char* data();
+
+  size_t size() const;
+
+private:
+  const std::string filename_;
+  char* data_;
+  size_t size_;
+}; // class MappedFile
+
+
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_COMMON_MMAP_HH
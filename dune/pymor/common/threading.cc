@@ -0,0 +1,240 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "threading.hh"
+
+namespace Dune {
+namespace Pymor {
+
+
+size_t default_num_threads()
+{
+  const char* value = std::getenv("DUNE_PYMOR_NUM_THREADS");
+  if (value) {
+    const long num_threads = std::strtol(value, nullptr, 10);
+    if (num_threads > 0)
+      return num_threads;
+  }
+  return std::max(1u, std::thread::hardware_concurrency());
+} // ... default_num_threads(...)
+
+void parallel_for(const size_t begin,
+                  const size_t end,
+                  const std::function< void(size_t, size_t) >& body,
+                  const size_t num_threads)
+{
+  if (end <= begin)
+    return;
+  const size_t size = end - begin;
+  const size_t num_chunks = std::min(size, num_threads > 0 ? num_threads : default_num_threads());
+  if (num_chunks == 1) {
+    body(begin, end);
+    return;
+  }
+  std::exception_ptr exception;
+  std::mutex exception_mutex;
+  const auto run = [&](const size_t chunk) {
+    try {
+      body(begin + (chunk*size)/num_chunks, begin + ((chunk + 1)*size)/num_chunks);
+    } catch (...) {
+      std::lock_guard< std::mutex > lock(exception_mutex);
+      if (!exception)
+        exception = std::current_exception();
+    }
+  };
+  std::vector< std::thread > threads;
+  threads.reserve(num_chunks - 1);
+  try {
+    for (size_t chunk = 1; chunk < num_chunks; ++chunk)
+      threads.emplace_back(run, chunk);
+  } catch (...) {
+    // a std::thread which is still joinable would call std::terminate() upon destruction
+    for (auto& thread : threads)
+      thread.join();
+    throw;
+  }
+  run(0);
+  for (auto& thread : threads)
+    thread.join();
+  if (exception)
+    std::rethrow_exception(exception);
+} // ... parallel_for(...)
+
+
+namespace {
+
+
+//! the pool the current thread is a worker of and its index in that pool
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_index = 0;
+
+
+} // namespace
+
+
+ThreadPool::ThreadPool(const size_t num_threads)
+  : pending_(0)
+  , next_queue_(0)
+  , sleeping_(0)
+  , stopping_(false)
+{
+  const size_t size = num_threads > 0 ? num_threads : default_num_threads();
+  queues_.reserve(size);
+  for (size_t ii = 0; ii < size; ++ii)
+    queues_.emplace_back(new Queue());
+  threads_.reserve(size);
+  try {
+    for (size_t ii = 0; ii < size; ++ii)
+      threads_.emplace_back(&ThreadPool::work, this, ii);
+  } catch (...) {
+    // the destructor is not called if the constructor throws
+    stop();
+    throw;
+  }
+} // ThreadPool(...)
+
+ThreadPool::~ThreadPool()
+{
+  stop();
+}
+
+size_t ThreadPool::num_threads() const
+{
+  return threads_.size();
+}
+
+void ThreadPool::submit(TaskType task)
+{
+  const size_t index = in_worker_thread() ? current_index : next_queue_++ % queues_.size();
+  {
+    std::lock_guard< std::mutex > queue_lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+    ++pending_;
+  }
+  wake(condition_, false);
+  // a worker waiting for a result may run the task as well
+  wake(waiting_condition_, false);
+} // ... submit(...)
+
+bool ThreadPool::run_pending_task()
+{
+  TaskType task;
+  if (!pop(in_worker_thread() ? current_index : 0, task))
+    return false;
+  try {
+    task();
+  } catch (...) {}
+  return true;
+} // ... run_pending_task(...)
+
+bool ThreadPool::in_worker_thread() const
+{
+  return current_pool == this;
+}
+
+void ThreadPool::wait_for_task(const std::function< bool() >& done)
+{
+  sleep(waiting_condition_, [&]() { return pending_ > 0 || done(); });
+}
+
+void ThreadPool::notify_waiters()
+{
+  wake(waiting_condition_, true);
+}
+
+void ThreadPool::sleep(std::condition_variable& condition, const std::function< bool() >& predicate)
+{
+  std::unique_lock< std::mutex > lock(mutex_);
+  // sleeping_ is incremented before predicate() is checked, so either the thread changing the outcome of predicate()
+  // sees sleeping_ > 0 and wakes this thread, or this thread sees the change
+  ++sleeping_;
+  condition.wait(lock, predicate);
+  --sleeping_;
+} // ... sleep(...)
+
+void ThreadPool::wake(std::condition_variable& condition, const bool all)
+{
+  if (sleeping_ == 0)
+    return;
+  {
+    // a thread which has checked its predicate but not started to wait yet holds mutex_
+    std::lock_guard< std::mutex > lock(mutex_);
+  }
+  if (all)
+    condition.notify_all();
+  else
+    condition.notify_one();
+} // ... wake(...)
+
+bool ThreadPool::pop(const size_t index, TaskType& task)
+{
+  {
+    auto& own = *queues_[index];
+    std::lock_guard< std::mutex > lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      --pending_;
+      return true;
+    }
+  }
+  for (size_t ii = 1; ii < queues_.size(); ++ii) {
+    auto& other = *queues_[(index + ii) % queues_.size()];
+    std::lock_guard< std::mutex > lock(other.mutex);
+    if (!other.tasks.empty()) {
+      task = std::move(other.tasks.front());
+      other.tasks.pop_front();
+      --pending_;
+      return true;
+    }
+  }
+  return false;
+} // ... pop(...)
+
+void ThreadPool::work(const size_t index)
+{
+  current_pool = this;
+  current_index = index;
+  while (true) {
+    if (run_pending_task())
+      continue;
+    sleep(condition_, [&]() { return stopping_ || pending_ > 0; });
+    std::lock_guard< std::mutex > lock(mutex_);
+    if (stopping_ && pending_ == 0)
+      return;
+  }
+} // ... work(...)
+
+void ThreadPool::stop()
+{
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    stopping_ = true;
+  }
+  condition_.notify_all();
+  for (auto& thread : threads_)
+    thread.join();
+} // ... stop(...)
+
+ThreadPool& default_thread_pool()
+{
+  static ThreadPool pool;
+  return pool;
+}
+
+
+} // namespace Pymor
+} // namespace Dune
@@ -0,0 +1,315 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_COMMON_THREADING_HH
+#define DUNE_PYMOR_COMMON_THREADING_HH
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+
+namespace Dune {
+namespace Pymor {
+
+
+/**
+ * \brief The number of threads to use if none is given: the value of the environment variable
+ *        DUNE_PYMOR_NUM_THREADS if set, the number of hardware threads otherwise (at least 1).
+ */
+size_t default_num_threads();
+
+
+/**
+ * \brief Splits [begin, end) into (at most) num_threads contiguous chunks and calls body(first, last) for each of them
+ *        in its own thread (the calling thread handles the first chunk).
+ *
+ *        If num_threads is 0, default_num_threads() is used. If body throws, the first exception is rethrown once all
+ *        threads have finished.
+ */
+void parallel_for(const size_t begin,
+                  const size_t end,
+                  const std::function< void(size_t, size_t) >& body,
+                  const size_t num_threads = 0);
+
+
+/**
+ * \brief A pool of worker threads with one task queue per worker.
+ *
+ *        Tasks submitted from outside the pool are distributed round robin, tasks submitted by a worker go to its own
+ *        queue. A worker takes the most recently submitted task of its own queue and steals the oldest task of the
+ *        other queues once its own one is empty. Exceptions thrown by a task are ignored, use run_async() to get them.
+ */
+class ThreadPool
+{
+public:
+  typedef std::function< void() > TaskType;
+
+  /**
+   * \param num_threads if 0, default_num_threads() is used
+   */
+  explicit ThreadPool(const size_t num_threads = 0);
+
+  /**
+   * \brief Runs all submitted tasks and joins the workers.
+   */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool& other) = delete;
+
+  ThreadPool& operator=(const ThreadPool& other) = delete;
+
+  size_t num_threads() const;
+
+  void submit(TaskType task);
+
+  /**
+   * \brief Runs one pending task in the calling thread (preferably one of its own queue if it is a worker of this
+   *        pool), returns false if there was none.
+   */
+  bool run_pending_task();
+
+  bool in_worker_thread() const;
+
+  /**
+   * \brief Blocks until a task is pending or done() returns true, to be used by threads waiting for a result computed
+   *        in this pool. Whoever makes done() return true has to call notify_waiters() afterwards.
+   */
+  void wait_for_task(const std::function< bool() >& done);
+
+  void notify_waiters();
+
+private:
+  struct Queue
+  {
+    std::mutex mutex;
+    std::deque< TaskType > tasks;
+  }; // struct Queue
+
+  bool pop(const size_t index, TaskType& task);
+
+  void work(const size_t index);
+
+  //! lets the workers finish all pending tasks and joins them
+  void stop();
+
+  //! blocks on condition until predicate() returns true, announcing it in sleeping_
+  void sleep(std::condition_variable& condition, const std::function< bool() >& predicate);
+
+  //! wakes the threads sleeping on condition, if there are any
+  void wake(std::condition_variable& condition, const bool all);
+
+  std::vector< std::unique_ptr< Queue > > queues_;
+  std::vector< std::thread > threads_;
+  //! the number of tasks in all queues, only changed while the respective queue is locked
+  std::atomic< size_t > pending_;
+  std::atomic< size_t > next_queue_;
+  //! the number of threads blocking in sleep(), mutex_ only has to be locked to wake them if there are any
+  std::atomic< size_t > sleeping_;
+  std::mutex mutex_;
+  //! idle workers wait on condition_, threads waiting for a result (see wait_for_task()) on waiting_condition_
+  std::condition_variable condition_;
+  std::condition_variable waiting_condition_;
+  bool stopping_;
+}; // class ThreadPool
+
+
+/**
+ * \brief The pool used by run_async() if none is given, it has default_num_threads() workers.
+ */
+ThreadPool& default_thread_pool();
+
+
+/**
+ * \brief The result of a computation running asynchronously, copies refer to the same result.
+ *
+ *        Callbacks added by then() are called once the result is set, in the thread setting it (or immediately, if it is
+ *        already set). Exceptions thrown by a callback are ignored. Waiting in a worker of the pool computing the result
+ *        runs pending tasks of that pool in the meantime, so tasks may wait for the tasks they submit, and blocks once
+ *        there are none.
+ */
+template< class T >
+class AsyncResult
+{
+public:
+  typedef T ValueType;
+  typedef std::function< void(const AsyncResult< T >&) > CallbackType;
+
+  explicit AsyncResult(ThreadPool* pool = nullptr)
+    : state_(std::make_shared< State >(pool))
+  {}
+
+  bool ready() const
+  {
+    return state_->done;
+  }
+
+  void wait() const
+  {
+    ThreadPool* pool = state_->pool;
+    if (pool && pool->in_worker_thread()) {
+      while (!ready())
+        if (!pool->run_pending_task())
+          pool->wait_for_task([&]() { return ready(); });
+      return;
+    }
+    std::unique_lock< std::mutex > lock(state_->mutex);
+    state_->condition.wait(lock, [&]() { return state_->done.load(); });
+  } // ... wait(...)
+
+  /**
+   * \return true if the result is ready after at most seconds
+   */
+  bool wait_for(const double seconds) const
+  {
+    std::unique_lock< std::mutex > lock(state_->mutex);
+    return state_->condition.wait_for(lock, std::chrono::duration< double >(seconds),
+                                      [&]() { return state_->done.load(); });
+  }
+
+  /**
+   * \brief Waits for the result, rethrows the exception of the computation if there was one.
+   */
+  const ValueType& get() const
+  {
+    wait();
+    if (state_->exception)
+      std::rethrow_exception(state_->exception);
+    return *state_->value;
+  }
+
+  ValueType* get_and_return_ptr() const
+  {
+    return new ValueType(get());
+  }
+
+  void then(const CallbackType callback) const
+  {
+    {
+      std::lock_guard< std::mutex > lock(state_->mutex);
+      if (!state_->done) {
+        state_->callbacks.push_back(callback);
+        return;
+      }
+    }
+    call(callback);
+  } // ... then(...)
+
+  /**
+   * \brief Keeps object alive until the result is set, e.g. the object the computation refers to. It is released in
+   *        the thread setting the result (right away, if the result is already set).
+   */
+  void keep_alive(std::shared_ptr< const void > object) const
+  {
+    std::lock_guard< std::mutex > lock(state_->mutex);
+    if (!state_->done)
+      state_->kept_alive.push_back(std::move(object));
+  }
+
+  void set_value(std::shared_ptr< ValueType > value)
+  {
+    if (!value)
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "value must not be empty!");
+    finish(value, nullptr);
+  }
+
+  void set_exception(std::exception_ptr exception)
+  {
+    if (!exception)
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "exception must not be empty!");
+    finish(nullptr, exception);
+  }
+
+private:
+  struct State
+  {
+    State(ThreadPool* pl)
+      : pool(pl)
+      , done(false)
+    {}
+
+    ThreadPool* const pool;
+    std::mutex mutex;
+    std::condition_variable condition;
+    //! only set while mutex is locked, but read without it by ready()
+    std::atomic< bool > done;
+    std::shared_ptr< ValueType > value;
+    std::exception_ptr exception;
+    std::vector< CallbackType > callbacks;
+    std::vector< std::shared_ptr< const void > > kept_alive;
+  }; // struct State
+
+  void finish(std::shared_ptr< ValueType > value, std::exception_ptr exception)
+  {
+    std::vector< CallbackType > callbacks;
+    std::vector< std::shared_ptr< const void > > kept_alive;
+    {
+      std::lock_guard< std::mutex > lock(state_->mutex);
+      if (state_->done)
+        DUNE_THROW(Stuff::Exceptions::you_are_using_this_wrong, "the result was already set!");
+      state_->value = value;
+      state_->exception = exception;
+      state_->done = true;
+      callbacks.swap(state_->callbacks);
+      kept_alive.swap(state_->kept_alive);
+    }
+    state_->condition.notify_all();
+    if (state_->pool)
+      state_->pool->notify_waiters();
+    for (const auto& callback : callbacks)
+      call(callback);
+  } // ... finish(...)
+
+  void call(const CallbackType& callback) const
+  {
+    try {
+      callback(*this);
+    } catch (...) {}
+  }
+
+  std::shared_ptr< State > state_;
+}; // class AsyncResult
+
+
+/**
+ * \brief Runs task in pool and takes ownership of the returned object, e.g.
+\code
+const auto result = run_async< VectorType >([&]() { return op.apply_and_return_ptr(source, mu); });
+\endcode
+ *        Everything task refers to has to outlive its execution.
+ */
+template< class T >
+AsyncResult< T > run_async(const std::function< T*() > task, ThreadPool& pool = default_thread_pool())
+{
+  AsyncResult< T > result(&pool);
+  pool.submit([task, result]() mutable {
+    std::shared_ptr< T > value;
+    try {
+      value.reset(task());
+      if (!value)
+        DUNE_THROW(Stuff::Exceptions::internal_error, "the task did not return a result!");
+    } catch (...) {
+      result.set_exception(std::current_exception());
+      return;
+    }
+    result.set_value(value);
+  });
+  return result;
+} // ... run_async(...)
+
+
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_COMMON_THREADING_HH
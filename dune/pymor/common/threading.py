@@ -0,0 +1,89 @@
+#! /usr/bin/env python
+# This file is part of the dune-pymor project:
+#   https://github.com/pymor/dune-pymor
+# Copyright Holders: Stephan Rave, Felix Schindler
+# License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+from __future__ import absolute_import
+
+import threading
+import time
+
+import pybindgen
+from pybindgen import retval, param
+
+
+def inject_AsyncResult(module, exceptions, CONFIG_H, ValueType):
+    """Injects Dune::Pymor::AsyncResult< ValueType >, as returned by solve_async and apply_async."""
+    assert(isinstance(module, pybindgen.module.Module))
+    assert(isinstance(exceptions, list))
+    assert(isinstance(ValueType, str))
+    namespace = module.add_cpp_namespace('Dune').add_cpp_namespace('Pymor')
+    Class = namespace.add_class('AsyncResult', template_parameters=[ValueType])
+    Class.add_copy_constructor()
+    Class.add_method('ready', retval('bool'), [], is_const=True)
+    Class.add_method('wait', None, [], is_const=True, unblock_threads=True)
+    Class.add_method('wait_for', retval('bool'), [param('const double', 'seconds')],
+                     is_const=True, unblock_threads=True)
+    Class.add_method('get_and_return_ptr',
+                     retval(ValueType + ' *', caller_owns_return=True),
+                     [], is_const=True, throw=exceptions, unblock_threads=True, custom_name='get')
+    # see dune/pymor/bindings/threading.hh
+    Class.add_function_as_method('Dune::Pymor::keep_alive', None,
+                                 [param('const ' + Class.full_name + '&', 'result'),
+                                  param('PyObject*', 'object', transfer_ownership=False)],
+                                 custom_name='keep_alive')
+    return module, Class
+
+
+class AsyncResult(object):
+    """Wraps a list of Dune::Pymor::AsyncResult, following the interface of concurrent.futures.Future.
+
+    convert turns the list of C++ results into the python result, owner (e.g. the wrapped discretization) is kept alive
+    by the C++ results until all computations are finished. Callbacks are called with this AsyncResult once the result
+    is ready, in a thread of their own, so they may call result() without blocking the caller.
+    """
+
+    def __init__(self, impls, convert, owner=None):
+        self._impls = list(impls)
+        self._convert = convert
+        if owner is not None:
+            # the computations refer to the C++ object of owner, even if this AsyncResult is gone
+            for impl in self._impls:
+                impl.keep_alive(owner)
+        self._lock = threading.Lock()
+        self._converted = False
+        self._result = None
+
+    def done(self):
+        return all(impl.ready() for impl in self._impls)
+
+    def wait(self, timeout=None):
+        if timeout is None:
+            for impl in self._impls:
+                impl.wait()
+            return True
+        deadline = time.time() + timeout
+        return all(impl.wait_for(max(deadline - time.time(), 0.)) for impl in self._impls)
+
+    def result(self, timeout=None):
+        if not self.wait(timeout):
+            raise RuntimeError('the result was not ready within {} seconds'.format(timeout))
+        with self._lock:
+            if not self._converted:
+                self._result = self._convert([impl.get() for impl in self._impls])
+                self._converted = True
+            return self._result
+
+    def add_done_callback(self, fn):
+        if self.done():
+            fn(self)
+            return
+
+        def wait_and_call():
+            self.wait()
+            fn(self)
+
+        thread = threading.Thread(target=wait_and_call)
+        thread.daemon = True
+        thread.start()
@@ -0,0 +1,199 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#include <unistd.h>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include "tracing.hh"
+
+namespace Dune {
+namespace Pymor {
+namespace Tracing {
+namespace internal {
+
+
+std::atomic< bool > enabled(false);
+
+
+namespace {
+
+
+/**
+ * \brief The ring buffer of one thread, only the owning thread writes to it.
+ */
+struct ThreadBuffer
+{
+  ThreadBuffer(const size_t tt, const size_t size)
+    : thread(tt)
+    , events(size)
+    , next(0)
+    , wrapped(false)
+  {}
+
+  const size_t thread;
+  std::vector< Event > events;
+  size_t next;
+  bool wrapped;
+  std::mutex mutex;
+}; // struct ThreadBuffer
+
+
+struct Registry
+{
+  Registry()
+    : buffer_size(DUNE_PYMOR_TRACING_BUFFER_SIZE)
+  {}
+
+  std::mutex mutex;
+  size_t buffer_size;
+  std::vector< std::shared_ptr< ThreadBuffer > > buffers;
+}; // struct Registry
+
+
+Registry& registry()
+{
+  // never destroyed, since threads may record events during shutdown
+  static Registry* registry_ = new Registry();
+  return *registry_;
+}
+
+
+ThreadBuffer& thread_buffer()
+{
+  // the registry keeps the buffer alive after the thread has finished, to allow for exporting its events
+  thread_local std::shared_ptr< ThreadBuffer > buffer = nullptr;
+  if (!buffer) {
+    Registry& reg = registry();
+    std::lock_guard< std::mutex > lock(reg.mutex);
+    buffer = std::make_shared< ThreadBuffer >(reg.buffers.size(), reg.buffer_size);
+    reg.buffers.push_back(buffer);
+  }
+  return *buffer;
+} // ... thread_buffer(...)
+
+
+void escape(std::ostream& out, const char* str)
+{
+  for (const char* cc = str; *cc != '\0'; ++cc) {
+    if (*cc == '"' || *cc == '\\')
+      out << '\\';
+    out << *cc;
+  }
+} // ... escape(...)
+
+
+} // namespace
+
+
+int64_t now()
+{
+  typedef std::chrono::steady_clock ClockType;
+  static const ClockType::time_point epoch = ClockType::now();
+  return std::chrono::duration_cast< std::chrono::nanoseconds >(ClockType::now() - epoch).count();
+}
+
+
+void record(const char* id, const int64_t begin, const int64_t end)
+{
+  ThreadBuffer& buffer = thread_buffer();
+  std::lock_guard< std::mutex > lock(buffer.mutex);
+  if (buffer.events.empty())
+    return;
+  buffer.events[buffer.next] = {id, begin, end};
+  ++buffer.next;
+  if (buffer.next == buffer.events.size()) {
+    buffer.next = 0;
+    buffer.wrapped = true;
+  }
+} // ... record(...)
+
+
+} // namespace internal
+
+
+void enable(const size_t buffer_size)
+{
+  internal::Registry& reg = internal::registry();
+  {
+    std::lock_guard< std::mutex > lock(reg.mutex);
+    if (buffer_size != reg.buffer_size) {
+      reg.buffer_size = buffer_size;
+      for (auto& buffer : reg.buffers) {
+        std::lock_guard< std::mutex > buffer_lock(buffer->mutex);
+        buffer->events = std::vector< Event >(buffer_size);
+        buffer->next = 0;
+        buffer->wrapped = false;
+      }
+    }
+  }
+  internal::now();
+  internal::enabled.store(true);
+} // ... enable(...)
+
+void disable()
+{
+  internal::enabled.store(false);
+}
+
+void clear()
+{
+  internal::Registry& reg = internal::registry();
+  std::lock_guard< std::mutex > lock(reg.mutex);
+  for (auto& buffer : reg.buffers) {
+    std::lock_guard< std::mutex > buffer_lock(buffer->mutex);
+    buffer->next = 0;
+    buffer->wrapped = false;
+  }
+} // ... clear(...)
+
+std::string chrome_trace()
+{
+  const auto pid = getpid();
+  std::ostringstream out;
+  out.precision(3);
+  out << std::fixed;
+  out << "{\"traceEvents\":[";
+  bool first = true;
+  internal::Registry& reg = internal::registry();
+  std::lock_guard< std::mutex > lock(reg.mutex);
+  for (auto& buffer : reg.buffers) {
+    std::lock_guard< std::mutex > buffer_lock(buffer->mutex);
+    const size_t num_events = buffer->wrapped ? buffer->events.size() : buffer->next;
+    const size_t start = buffer->wrapped ? buffer->next : 0;
+    for (size_t ii = 0; ii < num_events; ++ii) {
+      const Event& event = buffer->events[(start + ii) % buffer->events.size()];
+      if (!first)
+        out << ",";
+      first = false;
+      out << "\n{\"name\":\"";
+      internal::escape(out, event.id);
+      out << "\",\"cat\":\"dune-pymor\",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << buffer->thread
+          << ",\"ts\":" << 1e-3*event.begin << ",\"dur\":" << 1e-3*(event.end - event.begin) << "}";
+    }
+  }
+  out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+  return out.str();
+} // ... chrome_trace(...)
+
+void write_chrome_trace(const std::string& filename)
+{
+  std::ofstream file(filename);
+  if (!file)
+    DUNE_THROW(Stuff::Exceptions::external_error, "could not open '" << filename << "' for writing!");
+  file << chrome_trace();
+} // ... write_chrome_trace(...)
+
+
+} // namespace Tracing
+} // namespace Pymor
+} // namespace Dune
@@ -0,0 +1,153 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_COMMON_TRACING_HH
+#define DUNE_PYMOR_COMMON_TRACING_HH
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifndef DUNE_PYMOR_TRACING_BUFFER_SIZE
+# define DUNE_PYMOR_TRACING_BUFFER_SIZE 65536
+#endif
+
+namespace Dune {
+namespace Pymor {
+
+/**
+ * \brief Lightweight tracing of scopes, to obtain per call timelines.
+ *
+ *        Each thread records (id, begin, end) of all traced scopes into its own ring buffer of fixed size (the oldest
+ *        events are overwritten), which can be exported in the Chrome trace event format (to be viewed with
+ *        chrome://tracing or https://ui.perfetto.dev). Usage example:
+\code
+void foo()
+{
+  DUNE_PYMOR_TRACE_SCOPE("pymor.foo");
+  ...
+}
+
+Tracing::enable();
+foo();
+Tracing::write_chrome_trace("trace.json");
+\endcode
+ *        The ids are not copied, they thus have to be string literals (or otherwise live forever, see
+ *        DUNE_PYMOR_TRACE_SCOPE_STATIC). If tracing is disabled (the default), a traced scope costs one relaxed atomic
+ *        load, define DUNE_PYMOR_DISABLE_TRACING to remove the traced scopes at compile time.
+ */
+namespace Tracing {
+
+
+struct Event
+{
+  const char* id;
+  int64_t begin;
+  int64_t end;
+}; // struct Event
+
+
+namespace internal {
+
+
+extern std::atomic< bool > enabled;
+
+
+/**
+ * \brief Nanoseconds since the first call of this function.
+ */
+int64_t now();
+
+
+void record(const char* id, const int64_t begin, const int64_t end);
+
+
+} // namespace internal
+
+
+/**
+ * \param buffer_size the number of events to store per thread
+ */
+void enable(const size_t buffer_size = DUNE_PYMOR_TRACING_BUFFER_SIZE);
+
+void disable();
+
+inline bool enabled()
+{
+  return internal::enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * \brief Removes all recorded events of all threads.
+ */
+void clear();
+
+/**
+ * \brief The recorded events of all threads, in the Chrome trace event format.
+ */
+std::string chrome_trace();
+
+void write_chrome_trace(const std::string& filename);
+
+
+class Scope
+{
+public:
+  explicit Scope(const char* id)
+    : id_(enabled() ? id : nullptr)
+    , begin_(id_ ? internal::now() : 0)
+  {}
+
+  ~Scope()
+  {
+    if (id_)
+      internal::record(id_, begin_, internal::now());
+  }
+
+  Scope(const Scope& other) = delete;
+
+  Scope& operator=(const Scope& other) = delete;
+
+private:
+  const char* id_;
+  const int64_t begin_;
+}; // class Scope
+
+
+} // namespace Tracing
+} // namespace Pymor
+} // namespace Dune
+
+
+#define DUNE_PYMOR_TRACING_CONCAT_IMPL(a, b) a ## b
+#define DUNE_PYMOR_TRACING_CONCAT(a, b) DUNE_PYMOR_TRACING_CONCAT_IMPL(a, b)
+
+#ifndef DUNE_PYMOR_DISABLE_TRACING
+
+/**
+ * \brief Traces the current scope, id has to be a string literal.
+ */
+# define DUNE_PYMOR_TRACE_SCOPE(id) \
+  const Dune::Pymor::Tracing::Scope DUNE_PYMOR_TRACING_CONCAT(dune_pymor_tracing_scope_, __LINE__)(id)
+
+/**
+ * \brief Traces the current scope, where id is a std::string expression which is evaluated only once (per
+ *        instantiation of the surrounding function), e.g. DUNE_PYMOR_TRACE_SCOPE_STATIC(static_id() + ".apply").
+ */
+# define DUNE_PYMOR_TRACE_SCOPE_STATIC(id) \
+  static const std::string DUNE_PYMOR_TRACING_CONCAT(dune_pymor_tracing_id_, __LINE__) = id; \
+  const Dune::Pymor::Tracing::Scope DUNE_PYMOR_TRACING_CONCAT(dune_pymor_tracing_scope_, __LINE__)( \
+      DUNE_PYMOR_TRACING_CONCAT(dune_pymor_tracing_id_, __LINE__).c_str())
+
+#else // DUNE_PYMOR_DISABLE_TRACING
+
+# define DUNE_PYMOR_TRACE_SCOPE(id)
+# define DUNE_PYMOR_TRACE_SCOPE_STATIC(id)
+
+#endif // DUNE_PYMOR_DISABLE_TRACING
+
+#endif // DUNE_PYMOR_COMMON_TRACING_HH
@@ -0,0 +1,22 @@
+#! /usr/bin/env python
+# This file is part of the dune-pymor project:
+#   https://github.com/pymor/dune-pymor
+# Copyright Holders: Stephan Rave, Felix Schindler
+# License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+import pybindgen
+from pybindgen import retval, param
+
+
+def inject_tracing(module, exceptions, CONFIG_H):
+    assert(isinstance(module, pybindgen.module.Module))
+    assert(isinstance(exceptions, list))
+    namespace = module.add_cpp_namespace('Dune').add_cpp_namespace('Pymor').add_cpp_namespace('Tracing')
+    namespace.add_function('enable', None, [])
+    namespace.add_function('enable', None, [param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'buffer_size')])
+    namespace.add_function('disable', None, [])
+    namespace.add_function('enabled', retval('bool'), [])
+    namespace.add_function('clear', None, [])
+    namespace.add_function('chrome_trace', retval('std::string'), [])
+    namespace.add_function('write_chrome_trace', None, [param('const std::string&', 'filename')], throw=exceptions)
+    return module
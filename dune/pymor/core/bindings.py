@@ -11,6 +11,7 @@ from pybindgen import param, retval
 import dune.pymor
 import dune.pymor.common
 import dune.pymor.parameters
+import dune.pymor.la.algorithms
 import dune.pymor.la.container
 import dune.pymor.functionals
 import dune.pymor.operators
@@ -207,6 +208,9 @@ def inject_lib_dune_stuff(module, config_h_filename):
                 'ScalarType': 'double'},
         template_parameters='double',
         provides_data=True)
+    module.add_container('std::vector< Dune::Stuff::LA::CommonDenseVector< double > >', 'Dune::Stuff::LA::CommonDenseVector< double >', 'list')
+    module.add_container('std::vector< std::vector< Dune::Stuff::LA::CommonDenseVector< double > > >',
+                         'std::vector< Dune::Stuff::LA::CommonDenseVector< double > >', 'list')
     if CONFIG_H['HAVE_EIGEN']:
         module, _ = dune.pymor.la.container.inject_VectorImplementation(
             module,
@@ -219,6 +223,8 @@ def inject_lib_dune_stuff(module, config_h_filename):
             template_parameters='double',
             provides_data=True)
         module.add_container('std::vector< Dune::Stuff::LA::EigenDenseVector< double > >', 'Dune::Stuff::LA::EigenDenseVector< double >', 'list')
+        module.add_container('std::vector< std::vector< Dune::Stuff::LA::EigenDenseVector< double > > >',
+                             'std::vector< Dune::Stuff::LA::EigenDenseVector< double > >', 'list')
         module, _ = dune.pymor.la.container.inject_VectorImplementation(
             module,
             exceptions,
@@ -228,7 +234,11 @@ def inject_lib_dune_stuff(module, config_h_filename):
             Traits={'ThisType': EigenMappedDenseVector,
                     'ScalarType': 'double'},
             template_parameters='double',
-            provides_data=False)
+            provides_data=False,
+            maps_data=True)
+        module.add_container('std::vector< Dune::Stuff::LA::EigenMappedDenseVector< double > >', 'Dune::Stuff::LA::EigenMappedDenseVector< double >', 'list')
+        module.add_container('std::vector< std::vector< Dune::Stuff::LA::EigenMappedDenseVector< double > > >',
+                             'std::vector< Dune::Stuff::LA::EigenMappedDenseVector< double > >', 'list')
     if CONFIG_H['HAVE_DUNE_ISTL']:
         module, _ = dune.pymor.la.container.inject_VectorImplementation(
             module,
@@ -241,6 +251,8 @@ def inject_lib_dune_stuff(module, config_h_filename):
             template_parameters='double',
             provides_data=True)
         module.add_container('std::vector< Dune::Stuff::LA::IstlDenseVector< double > >', 'Dune::Stuff::LA::IstlDenseVector< double >', 'list')
+        module.add_container('std::vector< std::vector< Dune::Stuff::LA::IstlDenseVector< double > > >',
+                             'std::vector< Dune::Stuff::LA::IstlDenseVector< double > >', 'list')
     #   and the matrices
     module, _ = dune.pymor.la.container.inject_MatrixImplementation(
         module, exceptions, interfaces, CONFIG_H,
@@ -279,6 +291,13 @@ def inject_lib_dune_stuff(module, config_h_filename):
 def inject_lib_dune_pymor(module, config_h_filename):
     module, exceptions, interfaces, CONFIG_H = inject_lib_dune_stuff(module, config_h_filename)
 
+    # tracing
+    module = dune.pymor.common.inject_tracing(module, exceptions, CONFIG_H)
+
+    # memory accounting
+    (module, interfaces['Dune::Pymor::MemoryFootprint']
+     ) = dune.pymor.common.inject_memory(module, exceptions, CONFIG_H)
+
     # all of parameters
     (module, interfaces['Dune::Pymor::ParameterType']
      ) = dune.pymor.parameters.inject_ParameterType(module, exceptions, CONFIG_H)
@@ -288,6 +307,12 @@ def inject_lib_dune_pymor(module, config_h_filename):
      ) = dune.pymor.parameters.inject_Parametric(module, exceptions, CONFIG_H)
     (module, interfaces['Dune::Pymor::ParameterFunctional']
      ) = dune.pymor.parameters.inject_ParameterFunctional(module, exceptions, interfaces, CONFIG_H)
+    (module, interfaces['Dune::Pymor::ParameterBatch']
+     ) = dune.pymor.parameters.inject_ParameterBatch(module, exceptions, CONFIG_H)
+    (module, interfaces['Dune::Pymor::ParameterSampler']
+     ) = dune.pymor.parameters.inject_ParameterSampler(module, exceptions, CONFIG_H)
+    (module, interfaces['Dune::Pymor::ThetaBundle']
+     ) = dune.pymor.parameters.inject_ThetaBundle(module, exceptions, interfaces, CONFIG_H)
     # next we add what we need of the functionals
     (module, interfaces['Dune::Pymor::Tags::FunctionalInterface']
             ) = inject_Class(module, 'Dune::Pymor::Tags::FunctionalInterface')
@@ -381,6 +406,10 @@ def inject_lib_dune_pymor(module, config_h_filename):
             operator_template_parameters=(matrix, vector),
             inverse_template_parameters=(matrix, vector),
             container_based=True)
+        dune.pymor.la.algorithms.inject_gram_schmidt(module, exceptions, CONFIG_H, vector,
+                                                     product=BaseOperatorName + '< ' + matrix + ', ' + vector + ' >')
+        dune.pymor.la.algorithms.inject_pod(module, exceptions, CONFIG_H, vector,
+                                            product=BaseOperatorName + '< ' + matrix + ', ' + vector + ' >')
     def inject_affinelydecomposed_operator(matrix, vector):
         _ = dune.pymor.operators.inject_LinearAffinelyDecomposedContainerBasedImplementation(
             module, exceptions, interfaces, CONFIG_H,
@@ -391,6 +420,24 @@ def inject_lib_dune_pymor(module, config_h_filename):
                     'ComponentType': BaseOperatorName + '< ' + matrix + ', ' + vector + ' >',
                     'InverseType': BaseOperatorInverseName + '< ' + matrix + ', ' + vector + ' >'},
             template_parameters=(matrix, vector))
+        dune.pymor.la.algorithms.inject_gram_schmidt(
+            module, exceptions, CONFIG_H, vector,
+            product='Dune::Pymor::Operators::LinearAffinelyDecomposedContainerBased< ' + matrix + ', ' + vector + ' >')
+        dune.pymor.la.algorithms.inject_pod(
+            module, exceptions, CONFIG_H, vector,
+            product='Dune::Pymor::Operators::LinearAffinelyDecomposedContainerBased< ' + matrix + ', ' + vector + ' >')
+    #   the euclidean orthonormalization and POD for each vector type
+    dune.pymor.la.algorithms.inject_gram_schmidt(module, exceptions, CONFIG_H, CommonDenseVector)
+    dune.pymor.la.algorithms.inject_pod(module, exceptions, CONFIG_H, CommonDenseVector, name='CommonDenseVectorPod')
+    if CONFIG_H['HAVE_EIGEN']:
+        dune.pymor.la.algorithms.inject_gram_schmidt(module, exceptions, CONFIG_H, EigenDenseVector)
+        dune.pymor.la.algorithms.inject_gram_schmidt(module, exceptions, CONFIG_H, EigenMappedDenseVector)
+        dune.pymor.la.algorithms.inject_pod(module, exceptions, CONFIG_H, EigenDenseVector, name='EigenDenseVectorPod')
+        dune.pymor.la.algorithms.inject_pod(module, exceptions, CONFIG_H, EigenMappedDenseVector,
+                                            name='EigenMappedDenseVectorPod')
+    if CONFIG_H['HAVE_DUNE_ISTL']:
+        dune.pymor.la.algorithms.inject_gram_schmidt(module, exceptions, CONFIG_H, IstlDenseVector)
+        dune.pymor.la.algorithms.inject_pod(module, exceptions, CONFIG_H, IstlDenseVector, name='IstlDenseVectorPod')
     #   the Dune::CommonDense backend
     inject_operator_inverse_combo(CommonDenseMatrix, CommonDenseVector)
     inject_affinelydecomposed_operator(CommonDenseMatrix, CommonDenseVector)
@@ -0,0 +1,76 @@
+#! /usr/bin/env python
+# This file is part of the dune-pymor project:
+#   https://github.com/pymor/dune-pymor
+# Copyright Holders: Stephan Rave, Felix Schindler
+# License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+from pybindgen.typehandlers.base import Parameter, ForwardWrapperBase
+
+
+DoubleBuffer = 'Dune::Pymor::DoubleBuffer'
+MutableDoubleBuffer = 'Dune::Pymor::MutableDoubleBuffer'
+
+
+def _get_double_buffer(wrapper, name, flags):
+    """Declares a Py_buffer, which is filled from the python argument name and released after the call."""
+    py_name = wrapper.declarations.declare_variable('PyObject*', 'py_' + name)
+    buffer_name = wrapper.declarations.declare_variable('Py_buffer', name + '_buffer')
+    wrapper.parse_params.add_parameter('O', ['&' + py_name], name)
+    wrapper.before_call.write_error_check('PyObject_GetBuffer(%s, &%s, %s) < 0' % (py_name, buffer_name, flags))
+    wrapper.before_call.add_cleanup_code('PyBuffer_Release(&%s);' % buffer_name)
+    # the values are used as they are, so only doubles in native byte order are accepted, e.g. '<d' but not '>d' on a
+    # little endian host
+    probe_name = wrapper.declarations.declare_variable('const int', name + '_byte_order_probe', '1')
+    wrapper.before_call.write_error_check(
+        '%(b)s.itemsize != sizeof(double) || %(b)s.format == NULL'
+        ' || !(strcmp(%(b)s.format, "d") == 0 || strcmp(%(b)s.format, "@d") == 0 || strcmp(%(b)s.format, "=d") == 0'
+        ' || (*reinterpret_cast< const char* >(&%(p)s) == 1'
+        ' ? strcmp(%(b)s.format, "<d") == 0'
+        ' : (strcmp(%(b)s.format, ">d") == 0 || strcmp(%(b)s.format, "!d") == 0)))' % {'b': buffer_name,
+                                                                                        'p': probe_name},
+        'PyErr_SetString(PyExc_TypeError, "%s has to be a contiguous buffer of doubles in native byte order");' % name)
+    return buffer_name
+
+
+class DoubleBufferParam(Parameter):
+    """Passes any C-contiguous buffer of native doubles (e.g. a NumPy array) as `const std::vector< double >&`.
+
+    The values are copied with a single memcpy instead of being converted element by element from a python list. Use
+    it as `param(DoubleBuffer, 'values')`, importing this module registers the type with pybindgen.
+    """
+
+    DIRECTIONS = [Parameter.DIRECTION_IN]
+    CTYPES = [DoubleBuffer]
+
+    def convert_c_to_python(self, wrapper):
+        raise NotImplementedError('a DoubleBuffer can only be passed from python to C++')
+
+    def convert_python_to_c(self, wrapper):
+        assert isinstance(wrapper, ForwardWrapperBase)
+        buffer_name = _get_double_buffer(wrapper, self.name, 'PyBUF_C_CONTIGUOUS | PyBUF_FORMAT')
+        values_name = wrapper.declarations.declare_variable('std::vector< double >', self.name)
+        wrapper.before_call.write_code(
+            '%(v)s.assign(static_cast< const double* >(%(b)s.buf),'
+            ' static_cast< const double* >(%(b)s.buf) + %(b)s.len/sizeof(double));'
+            % {'v': values_name, 'b': buffer_name})
+        wrapper.call_params.append(values_name)
+
+
+class MutableDoubleBufferParam(Parameter):
+    """Passes a writable C-contiguous buffer of native doubles as the two arguments `double* data, size_t size`.
+
+    Nothing is copied, so the python object providing the buffer (e.g. a NumPy array or an mmap) has to be kept alive
+    as long as the C++ side refers to its memory.
+    """
+
+    DIRECTIONS = [Parameter.DIRECTION_IN]
+    CTYPES = [MutableDoubleBuffer]
+
+    def convert_c_to_python(self, wrapper):
+        raise NotImplementedError('a MutableDoubleBuffer can only be passed from python to C++')
+
+    def convert_python_to_c(self, wrapper):
+        assert isinstance(wrapper, ForwardWrapperBase)
+        buffer_name = _get_double_buffer(wrapper, self.name, 'PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | PyBUF_WRITABLE')
+        wrapper.call_params.append('static_cast< double* >(%s.buf)' % buffer_name)
+        wrapper.call_params.append('static_cast< size_t >(%s.len/sizeof(double))' % buffer_name)
@@ -18,6 +18,37 @@ from dune.pymor.functionals import wrap_affinely_decomposed_functional, wrap_fun
 from dune.pymor.operators import wrap_affinely_decomposed_operator, wrap_operator
 
 
+class LazyModule(ModuleType):
+    """A module whose lazily added attributes are created by their factory upon first access.
+
+    __all__ lists the names of all lazily added attributes, so `from module import *` creates all of them.
+    """
+
+    def __init__(self, name):
+        ModuleType.__init__(self, name)
+        self._factories = {}
+        self.__all__ = []
+
+    def add_lazy(self, name, factory):
+        self._factories[name] = factory
+        if name not in self.__all__:
+            self.__all__.append(name)
+
+    def __getattr__(self, name):
+        factories = self.__dict__.get('_factories', {})
+        factory = factories.get(name)
+        if factory is None:
+            raise AttributeError("'{}' module has no attribute '{}'".format(self.__name__, name))
+        # the factories return the same object when called repeatedly, e.g. from several threads
+        value = factory()
+        setattr(self, name, value)
+        factories.pop(name, None)
+        return value
+
+    def __dir__(self):
+        return sorted(set(self.__dict__.keys()) | set(self.__dict__.get('_factories', {}).keys()))
+
+
 def get_StationaryMultiscaleDiscretiztionInterface(mod):
     try:
         return mod.Dune.Pymor.Tags.StationaryMultiscaleDiscretiztionInterface
@@ -34,19 +65,26 @@ def wrap_dune_stuff_module(mod):
     wrapper = DuneStuffWrapper()
 
     def create_modules(mod):
-        wrapped_mod = ModuleType(mod.__name__.lower())
+        wrapped_mod = LazyModule(mod.__name__.lower())
         wrapped_modules[mod] = {'wrapped': wrapped_mod, 'empty': True}
         for k, v in mod.__dict__.iteritems():
             if isinstance(v, ModuleType):
                 create_modules(v)
 
-    def add_to_module(k, v, mod):
+    def add_to_module(k, v, wrap, mod):
+        # v is wrapped by wrap(v) when it is first looked up, either in the wrapper or in the wrapped module
         wrapped_mod = wrapped_modules[mod]['wrapped']
-        try:
-            v.__module__ = wrapped_mod.__name__
-        except AttributeError:
-            pass
-        wrapped_mod.__dict__[k] = v
+
+        def factory():
+            wrapped_cls = wrap(v)
+            try:
+                wrapped_cls.__module__ = wrapped_mod.__name__
+            except AttributeError:
+                pass
+            return wrapped_cls
+
+        wrapper.add_lazy_class(v, factory)
+        wrapped_mod.add_lazy(k, lambda: wrapper[v])
         wrapped_modules[mod]['empty'] = False
 
     def add_modules(mod):
@@ -67,9 +105,7 @@ def wrap_dune_stuff_module(mod):
             elif v == VectorInterface:
                 continue
             elif isclass(v) and issubclass(v, VectorInterface):
-                wrapped_vector = wrap_vector(v)
-                add_to_module(k, wrapped_vector, mod)
-                wrapper.add_vector_class(v, wrapped_vector)
+                add_to_module(k, v, wrap_vector, mod)
 
     create_modules(mod)
     wrap_vectors(mod)
@@ -86,30 +122,41 @@ def wrap_module(mod):
     OperatorInterface = mod.Dune.Pymor.Tags.OperatorInterface
     Parameter = mod.Dune.Pymor.Parameter
     ParameterFunctional = mod.Dune.Pymor.ParameterFunctional
+    ParameterBatch = mod.Dune.Pymor.ParameterBatch
     ParameterType = mod.Dune.Pymor.ParameterType
     StationaryDiscretizationInterface = mod.Dune.Pymor.Tags.StationaryDiscretizationInterface
     StationaryMultiscaleDiscretiztionInterface = get_StationaryMultiscaleDiscretiztionInterface(mod)
+    extract_subdomain_blocks = getattr(mod.Dune.Pymor, 'extract_subdomain_blocks', None)
+    PymorNamespace = mod.Dune.Pymor
 
     wrapped_modules = {}
 
     wrapper = Wrapper(DuneParameterType = ParameterType,
                       DuneParameter = Parameter,
-                      DuneParameterFunctional = ParameterFunctional)
+                      DuneParameterFunctional = ParameterFunctional,
+                      DuneParameterBatch = ParameterBatch)
 
     def create_modules(mod):
-        wrapped_mod = ModuleType(mod.__name__.lower())
+        wrapped_mod = LazyModule(mod.__name__.lower())
         wrapped_modules[mod] = {'wrapped': wrapped_mod, 'empty': True}
         for k, v in mod.__dict__.iteritems():
             if isinstance(v, ModuleType):
                 create_modules(v)
 
-    def add_to_module(k, v, mod):
+    def add_to_module(k, v, wrap, mod):
+        # v is wrapped by wrap(v) when it is first looked up, either in the wrapper or in the wrapped module
         wrapped_mod = wrapped_modules[mod]['wrapped']
-        try:
-            v.__module__ = wrapped_mod.__name__
-        except AttributeError:
-            pass
-        wrapped_mod.__dict__[k] = v
+
+        def factory():
+            wrapped_cls = wrap(v)
+            try:
+                wrapped_cls.__module__ = wrapped_mod.__name__
+            except AttributeError:
+                pass
+            return wrapped_cls
+
+        wrapper.add_lazy_class(v, factory)
+        wrapped_mod.add_lazy(k, lambda: wrapper[v])
         wrapped_modules[mod]['empty'] = False
 
     def add_modules(mod):
@@ -130,9 +177,7 @@ def wrap_module(mod):
             elif v == VectorInterface:
                 continue
             elif isclass(v) and issubclass(v, VectorInterface):
-                wrapped_vector = wrap_vector(v)
-                add_to_module(k, wrapped_vector, mod)
-                wrapper.add_vector_class(v, wrapped_vector)
+                add_to_module(k, v, wrap_vector, mod)
 
     def wrap_classes(mod):
         for k, v in mod.__dict__.iteritems():
@@ -142,21 +187,24 @@ def wrap_module(mod):
                 continue
             elif isclass(v):
                 if issubclass(v, AffinelyDecomposedFunctionalInterface):
-                    wrapped_class = wrap_affinely_decomposed_functional(v, wrapper)
+                    wrap = lambda cls: wrap_affinely_decomposed_functional(cls, wrapper)
                 elif issubclass(v, AffinelyDecomposedOperatorInterface):
-                    wrapped_class = wrap_affinely_decomposed_operator(v, wrapper)
+                    wrap = lambda cls: wrap_affinely_decomposed_operator(cls, wrapper)
                 elif issubclass(v, FunctionalInterface):
-                    wrapped_class = wrap_functional(v, wrapper)
+                    wrap = lambda cls: wrap_functional(cls, wrapper)
                 elif issubclass(v, OperatorInterface):
-                    wrapped_class = wrap_operator(v, wrapper)
+                    wrap = lambda cls: wrap_operator(cls, wrapper)
                 elif MULTISCALE_PRESENT and issubclass(v, StationaryMultiscaleDiscretiztionInterface):
-                    wrapped_class = wrap_multiscale_discretization(v, wrapper)
+                    # only the classes injected with subdomain_blocks=True have their SubdomainBlocks bound
+                    wrap = lambda cls: wrap_multiscale_discretization(
+                        cls, wrapper,
+                        extract_subdomain_blocks if hasattr(PymorNamespace, cls.__name__ + 'SubdomainBlocks')
+                        else None)
                 elif issubclass(v, StationaryDiscretizationInterface):
-                    wrapped_class = wrap_stationary_discretization(v, wrapper)
+                    wrap = lambda cls: wrap_stationary_discretization(cls, wrapper)
                 else:
                     continue
-                add_to_module(k, wrapped_class, mod)
-                wrapper.add_class(v, wrapped_class)
+                add_to_module(k, v, wrap, mod)
 
     create_modules(mod)
     wrap_vectors(mod)
@@ -8,6 +8,7 @@ from __future__ import absolute_import, division, print_function
 from inspect import isclass
 from itertools import izip
 from types import ModuleType
+import threading
 
 import numpy as np
 
@@ -16,55 +17,99 @@ from pymor.parameters.base import Parameter, ParameterType
 from pymor.parameters.functionals import ExpressionParameterFunctional
 
 
-class DuneStuffWrapper(object):
+class LazyClassRegistry(object):
+    """Maps classes of a bindings module to their wrapper classes, which may be created upon first use.
+
+    Lazily added classes are wrapped by their factory when they are looked up, either directly or by their type_this.
+    Lookups may happen from several threads, each class is wrapped only once.
+    """
 
     def __init__(self):
         self.wrapped_classes = {}
         self.wrapped_classes_by_type_this = {}
+        self.lazy_classes = {}
+        # reentrant, since a factory may look up other classes
+        self._lock = threading.RLock()
 
     def add_class(self, cls, wrapped_cls):
-        self.wrapped_classes[cls] = wrapped_cls
-        if hasattr(cls, 'type_this'):
-            try:
-                self.wrapped_classes_by_type_this[cls.type_this()] = wrapped_cls
-            except TypeError:
-                logger = getLogger('dune.pymor.core')
-                logger.warn('Could not call type_this on {}. (Not a static method?)'.format(cls.__name__))
+        with self._lock:
+            self.lazy_classes.pop(cls, None)
+            self.wrapped_classes[cls] = wrapped_cls
+            if hasattr(cls, 'type_this'):
+                try:
+                    self.wrapped_classes_by_type_this[cls.type_this()] = wrapped_cls
+                except TypeError:
+                    logger = getLogger('dune.pymor.core')
+                    logger.warn('Could not call type_this on {}. (Not a static method?)'.format(cls.__name__))
 
     def add_vector_class(self, cls, wrapped_cls):
         self.add_class(cls, wrapped_cls)
 
+    def add_lazy_class(self, cls, factory):
+        """Registers cls, factory() is called to create its wrapper class when it is looked up the first time."""
+        with self._lock:
+            if cls not in self.wrapped_classes:
+                self.lazy_classes[cls] = factory
+
+    def wrapped_class(self, cls):
+        try:
+            return self.wrapped_classes[cls]
+        except KeyError:
+            pass
+        with self._lock:
+            # another thread may have wrapped cls in the meantime
+            try:
+                return self.wrapped_classes[cls]
+            except KeyError:
+                if cls not in self.lazy_classes:
+                    raise
+            # the factory may look up other classes, so cls is only removed from lazy_classes once it is wrapped
+            wrapped_cls = self.lazy_classes[cls]()
+            self.add_class(cls, wrapped_cls)
+            return wrapped_cls
+
+    def wrapped_class_by_type_this(self, type_this):
+        try:
+            return self.wrapped_classes_by_type_this[type_this]
+        except KeyError:
+            pass
+        with self._lock:
+            try:
+                return self.wrapped_classes_by_type_this[type_this]
+            except KeyError:
+                for cls in list(self.lazy_classes.keys()):
+                    try:
+                        if cls.type_this() == type_this:
+                            return self.wrapped_class(cls)
+                    except (AttributeError, TypeError):
+                        continue
+                raise KeyError(type_this)
+
+
+class DuneStuffWrapper(LazyClassRegistry):
+
     def __getitem__(self, obj):
         if isclass(obj):
-            return self.wrapped_classes[obj]
+            return self.wrapped_class(obj)
         elif isinstance(obj, str):
-            return self.wrapped_classes_by_type_this[obj]
+            return self.wrapped_class_by_type_this(obj)
         else:
-            return self.wrapped_classes[type(obj)](obj)
+            return self.wrapped_class(type(obj))(obj)
 
 
-class Wrapper(object):
+class Wrapper(LazyClassRegistry):
 
-    def __init__(self, DuneParameterType, DuneParameter, DuneParameterFunctional):
-        self.wrapped_classes = {}
-        self.wrapped_classes_by_type_this = {}
+    def __init__(self, DuneParameterType, DuneParameter, DuneParameterFunctional, DuneParameterBatch=None):
+        LazyClassRegistry.__init__(self)
         self.DuneParameterType = DuneParameterType
         self.DuneParameter = DuneParameter
+        self.DuneParameterBatch = DuneParameterBatch
+        self._dune_parameter_types = {}
         self.instance_wrappers = {DuneParameterType: self._parameter_type,
                                   DuneParameter: self._parameter,
                                   DuneParameterFunctional: self._parameter_functional}
-
-    def add_class(self, cls, wrapped_cls):
-        self.wrapped_classes[cls] = wrapped_cls
-        if hasattr(cls, 'type_this'):
-            try:
-                self.wrapped_classes_by_type_this[cls.type_this()] = wrapped_cls
-            except TypeError:
-                logger = getLogger('dune.pymor.core')
-                logger.warn('Could not call type_this on {}. (Not a static method?)'.format(cls.__name__))
-
-    def add_vector_class(self, cls, wrapped_cls):
-        self.add_class(cls, wrapped_cls)
+        if DuneParameterBatch is not None:
+            self.instance_wrappers[DuneParameterBatch] = self._parameter_batch
 
     def _parameter_type(self, dune_parameter_type):
         return ParameterType({k: v for k, v in izip(list(dune_parameter_type.keys()),
@@ -75,25 +120,73 @@ class Wrapper(object):
         return Parameter({k: np.array(v) for k, v in izip(list(dune_parameter.keys()),
                                                           [list(p) for p in list(dune_parameter.values())])})
 
+    def _parameter_batch(self, dune_batch):
+        pt = self._parameter_type(dune_batch.type())
+        keys = sorted(pt.keys())
+        values = np.array(list(dune_batch.values())).reshape((dune_batch.size(), dune_batch.serialized_size()))
+        # the values of pyMOR parameter types are shapes, not lengths
+        offsets = np.cumsum([0] + [int(np.prod(pt[k])) for k in keys])
+        return [Parameter({k: row[offsets[i]:offsets[i + 1]] for i, k in enumerate(keys)}) for row in values]
+
     def _parameter_functional(self, dune_functional):
         pt = self[dune_functional.parameter_type()]
         expression = dune_functional.expression() + '.reshape(tuple())'
         return ExpressionParameterFunctional(expression, pt)
 
+    def _dune_parameter_type(self, shapes):
+        # shapes is a tuple of (key, length) pairs with sorted keys, the dune types are created once per shape
+        try:
+            return self._dune_parameter_types[shapes]
+        except KeyError:
+            dune_type = self.DuneParameterType([k for k, _ in shapes], [l for _, l in shapes])
+            self._dune_parameter_types[shapes] = dune_type
+            return dune_type
+
     def dune_parameter(self, parameter):
         assert isinstance(parameter, Parameter)
-        dune_parameter = self.DuneParameter()
-        for k, v in parameter.iteritems():
-            assert v.ndim == 1
-            dune_parameter.set(k, list(v))
-        return dune_parameter
+        if self.DuneParameterBatch is None or len(parameter) == 0:
+            dune_parameter = self.DuneParameter()
+            for k, v in parameter.iteritems():
+                assert v.ndim == 1
+                dune_parameter.set(k, list(v))
+            return dune_parameter
+        keys = sorted(parameter.keys())
+        for k in keys:
+            assert parameter[k].ndim == 1
+        dune_type = self._dune_parameter_type(tuple((k, len(parameter[k])) for k in keys))
+        values = np.ascontiguousarray(np.hstack([parameter[k] for k in keys]), dtype=np.float64)
+        return self.DuneParameterBatch.deserialize(dune_type, values)
+
+    def dune_parameter_batch(self, parameters):
+        """Converts a list of |Parameters| of the same type into one `ParameterBatch` at once."""
+        assert self.DuneParameterBatch is not None
+        parameters = list(parameters)
+        assert len(parameters) > 0
+        keys = sorted(parameters[0].keys())
+        for k in keys:
+            assert parameters[0][k].ndim == 1
+        dune_type = self._dune_parameter_type(tuple((k, len(parameters[0][k])) for k in keys))
+        values = np.ascontiguousarray(np.hstack([mu[k] for mu in parameters for k in keys]), dtype=np.float64)
+        return self.DuneParameterBatch(dune_type, values)
+
+    def dune_parameter_array(self, parameter_type, values):
+        """Converts a 2-D array with one parameter of type `parameter_type` per row into one `ParameterBatch`.
+
+        Each row holds the values of all keys of `parameter_type` in sorted order, as in `ParameterBatch.values()`.
+        """
+        assert self.DuneParameterBatch is not None
+        keys = sorted(parameter_type.keys())
+        shapes = tuple((k, int(np.prod(parameter_type[k]))) for k in keys)
+        values = np.ascontiguousarray(values, dtype=np.float64)
+        assert values.ndim == 2 and values.shape[1] == sum(l for _, l in shapes)
+        return self.DuneParameterBatch(self._dune_parameter_type(shapes), values.ravel())
 
     def __getitem__(self, obj):
         if isclass(obj):
-            return self.wrapped_classes[obj]
+            return self.wrapped_class(obj)
         elif type(obj) in self.instance_wrappers:
             return self.instance_wrappers[type(obj)](obj)
         elif isinstance(obj, str):
-            return self.wrapped_classes_by_type_this[obj]
+            return self.wrapped_class_by_type_this(obj)
         else:
-            return self.wrapped_classes[type(obj)](obj)
+            return self.wrapped_class(type(obj))(obj)
@@ -12,6 +12,7 @@ import pybindgen
 from pybindgen import retval, param
 import numpy as np
 
+from dune.pymor.common.threading import AsyncResult
 from dune.pymor.la.container import make_listvectorarray
 
 from pymor.discretizations.interfaces import DiscretizationInterface
@@ -124,52 +125,68 @@ def inject_StationaryDiscretizationImplementation(module, exceptions, interfaces
                      [param('const std::string&', 'type'),
                       param(VectorType + ' &', 'vector'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('solve',
                      None,
                      [param('const Dune::Stuff::Common::Configuration&', 'options'),
                       param(VectorType + ' &', 'vector'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('solve',
                      None,
                      [param(VectorType + ' &', 'vector'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('solve',
                      None,
                      [param(VectorType + ' &', 'vector')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('solve_and_return_ptr',
                      retval(VectorType + ' *', caller_owns_return=True),
                      [param('const std::string&', 'type'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('solve_and_return_ptr',
                      retval(VectorType + ' *', caller_owns_return=True),
                      [param('const Dune::Stuff::Common::Configuration&', 'options'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('solve_and_return_ptr',
                      retval(VectorType + ' *', caller_owns_return=True),
                      [param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('solve_and_return_ptr',
                      retval(VectorType + ' *', caller_owns_return=True),
-                     [], is_const=True, throw=exceptions)
+                     [], is_const=True, throw=exceptions, unblock_threads=True)
+    AsyncResultType = 'Dune::Pymor::AsyncResult< ' + VectorType + ' > *'
+    Class.add_method('solve_async_and_return_ptr',
+                     retval(AsyncResultType, caller_owns_return=True),
+                     [param('const std::string', 'type'),
+                      param('Dune::Pymor::Parameter', 'mu')],
+                     is_const=True, throw=exceptions, custom_name='solve_async')
+    Class.add_method('solve_async_and_return_ptr',
+                     retval(AsyncResultType, caller_owns_return=True),
+                     [param('const Dune::Stuff::Common::Configuration', 'options'),
+                      param('Dune::Pymor::Parameter', 'mu')],
+                     is_const=True, throw=exceptions, custom_name='solve_async')
+    Class.add_method('solve_async_and_return_ptr',
+                     retval(AsyncResultType, caller_owns_return=True),
+                     [param('Dune::Pymor::Parameter', 'mu')],
+                     is_const=True, throw=exceptions, custom_name='solve_async')
     Class.add_method('visualize',
                      None,
                      [param('const ' + VectorType + ' &', 'vector'),
                       param('const std::string', 'filename'),
                       param('const std::string', 'name')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('visualize',
                      None,
                      [param('const ' + VectorType + ' &', 'vector'),
                       param('const std::string', 'filename'),
                       param('const std::string', 'name'),
                       param('const bool', 'add_dirichlet')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
+    Class.add_method('memory_footprint', retval('Dune::Pymor::MemoryFootprint'), [], is_const=True, throw=exceptions)
     return Class
 
 
@@ -252,6 +269,19 @@ def wrap_stationary_discretization(cls, wrapper):
 
         _solve = solve
 
+        def solve_async(self, mu=None):
+            """Starts the solve in C++ and returns an AsyncResult, whose result() is the solution.
+
+            Other work (e.g. estimating the error of the previous snapshot) can be done while the solve is running.
+            """
+            mu = self.parse_parameter(mu)
+            if not self.logging_disabled:
+                self.logger.info('Solving {} for {} asynchronously ...'.format(self.name, mu))
+            mu = self._wrapper.dune_parameter(mu)
+            return AsyncResult([self._impl.solve_async(self.solver_options, mu)],
+                               lambda solutions: ListVectorArray([self._wrapper[s] for s in solutions]),
+                               owner=self)
+
         def visualize(self, U, file_name=None, name='solution', delete=True, legend=None, separate_colorbars=None):
             if isinstance(U, tuple) or isinstance(U, list):
                 Us = [V._list[0] for V in U]
@@ -279,7 +309,22 @@ def wrap_stationary_discretization(cls, wrapper):
 def inject_StationaryMultiscaleDiscretizationImplementation(module, exceptions, interfaces, CONFIG_H,
                                                             name,
                                                             Traits,
-                                                            template_parameters=None):
+                                                            template_parameters=None,
+                                                            batched_localization=False,
+                                                            cached_oversampling=False,
+                                                            subdomain_blocks=False):
+    '''
+    If batched_localization is True, the class has to provide localize_vectors and globalize_vectors for all
+    subdomains at once (see Dune::Pymor::LA::SubdomainLocalization), which are then used by the wrapper.
+
+    If cached_oversampling is True, the class has to provide
+    prebuild_oversampled_discretizations(subdomains, boundary_value_type), which builds the oversampled
+    discretizations of all given subdomains in parallel into its cache (see Dune::Pymor::DiscretizationCache).
+
+    If subdomain_blocks is True, Dune::Pymor::SubdomainBlocks is injected for the class (see inject_SubdomainBlocks) and
+    the wrapper extracts all blocks concurrently. This requires the local and coupling getters of the class to be safe
+    to be called concurrently.
+    '''
     Class = inject_StationaryDiscretizationImplementation(module, exceptions, interfaces, CONFIG_H, name, Traits,
                                                           template_parameters=template_parameters,
                                                           derives_from_multiscale=True)
@@ -300,51 +345,126 @@ def inject_StationaryMultiscaleDiscretizationImplementation(module, exceptions,
     Class.add_method('pb_get_local_discretization',
                      retval(LocalDiscretizationType + '*', caller_owns_return=True),
                      [param('const ' + ssize_t, 'subdomain')],
-                     is_const=True, throw=exceptions,
+                     is_const=True, throw=exceptions, unblock_threads=True,
                      custom_name='get_local_discretization')
     Class.add_method('pb_get_oversampled_discretization',
                      retval(OversampledDiscretizationType + '*', caller_owns_return=True),
                      [param('const ' + ssize_t, 'subdomain'),
                       param('const std::string', 'boundary_value_type')],
-                     is_const=True, throw=exceptions,
+                     is_const=True, throw=exceptions, unblock_threads=True,
                      custom_name='get_oversampled_discretization')
     Class.add_method('get_local_operator_and_return_ptr',
                                  retval(OperatorType + ' *', caller_owns_return=True),
                                  [param('const '+ CONFIG_H['DUNE_STUFF_SSIZE_T'], 'ss')],
-                                 is_const=True, throw=exceptions,
+                                 is_const=True, throw=exceptions, unblock_threads=True,
                                  custom_name='get_local_operator')
     Class.add_method('get_local_product_and_return_ptr',
                                  retval(ProductType + ' *', caller_owns_return=True),
                                  [param('const ' + CONFIG_H['DUNE_STUFF_SSIZE_T'], 'ss'),
                                   param('const std::string', 'id')],
-                                 is_const=True, throw=exceptions,
+                                 is_const=True, throw=exceptions, unblock_threads=True,
                                  custom_name='get_local_product')
     Class.add_method('get_coupling_operator_and_return_ptr',
                                  retval(OperatorType + ' *', caller_owns_return=True),
                                  [param('const ' + CONFIG_H['DUNE_STUFF_SSIZE_T'], 'ss'),
                                   param('const ' + CONFIG_H['DUNE_STUFF_SSIZE_T'], 'nn')],
-                                 is_const=True, throw=exceptions,
+                                 is_const=True, throw=exceptions, unblock_threads=True,
                                  custom_name='get_coupling_operator')
     Class.add_method('get_local_functional_and_return_ptr',
                                  retval(FunctionalType + ' *', caller_owns_return=True),
                                  [param('const ' + CONFIG_H['DUNE_STUFF_SSIZE_T'], 'ss')],
-                                 is_const=True, throw=exceptions,
+                                 is_const=True, throw=exceptions, unblock_threads=True,
                                  custom_name='get_local_functional')
     Class.add_method('localize_vector_and_return_ptr',
                                  retval(VectorType + ' *', caller_owns_return=True),
                                  [param('const ' + VectorType + ' &',  'global_vector'),
                                   param('const ' + CONFIG_H['DUNE_STUFF_SSIZE_T'], 'ss')],
-                                 is_const=True, throw=exceptions,
+                                 is_const=True, throw=exceptions, unblock_threads=True,
                                  custom_name='localize_vector')
     Class.add_method('globalize_vectors_and_return_ptr',
                      retval(VectorType + '*', caller_owns_return=True),
                      [param('const std::vector< ' + VectorType + ' >&', 'local_vectors')],
-                     is_const=True, throw=exceptions,
+                     is_const=True, throw=exceptions, unblock_threads=True,
                      custom_name='globalize_vectors')
+    if batched_localization:
+        Class.add_method('localize_vectors',
+                         retval('std::vector< std::vector< ' + VectorType + ' > >'),
+                         [param('const std::vector< ' + VectorType + ' >&', 'global_vectors')],
+                         is_const=True, throw=exceptions, unblock_threads=True)
+        Class.add_method('globalize_vectors',
+                         retval('std::vector< ' + VectorType + ' >'),
+                         [param('const std::vector< std::vector< ' + VectorType + ' > >&', 'blocks')],
+                         is_const=True, throw=exceptions, unblock_threads=True,
+                         custom_name='globalize_block_vectors')
+    if cached_oversampling:
+        Class.add_method('prebuild_oversampled_discretizations',
+                         None,
+                         [param('const std::vector< ' + ssize_t + ' >&', 'subdomains'),
+                          param('const std::string', 'boundary_value_type')],
+                         is_const=True, throw=exceptions, unblock_threads=True)
+    if subdomain_blocks:
+        inject_SubdomainBlocks(module, exceptions, CONFIG_H, Class, Traits)
     return Class
 
 
-def wrap_multiscale_discretization(cls, wrapper):
+def inject_SubdomainBlocks(module, exceptions, CONFIG_H, DiscretizationClass, Traits):
+    '''
+    Injects Dune::Pymor::SubdomainBlocks for the given multiscale discretization class and the
+    extract_subdomain_blocks function, which extracts all blocks of a discretization concurrently.
+    '''
+    OperatorType = Traits['OperatorType']
+    FunctionalType = Traits['FunctionalType']
+    ProductType = Traits['ProductType']
+    ssize_t = CONFIG_H['DUNE_STUFF_SSIZE_T']
+    namespace = module.add_cpp_namespace('Dune').add_cpp_namespace('Pymor')
+    Class = namespace.add_class('SubdomainBlocks',
+                                template_parameters=[DiscretizationClass.full_name],
+                                custom_name=DiscretizationClass.mangled_name + 'SubdomainBlocks')
+    Class.add_method('num_subdomains', retval(ssize_t), [], is_const=True, throw=exceptions)
+    Class.add_method('product_ids', retval('std::vector< std::string >'), [], is_const=True, throw=exceptions)
+    Class.add_method('pb_neighbours',
+                     retval('std::vector< ' + ssize_t + ' >'),
+                     [param('const ' + ssize_t, 'ss')],
+                     is_const=True, throw=exceptions,
+                     custom_name='neighbours')
+    Class.add_method('local_operator_and_return_ptr',
+                     retval(OperatorType + ' *', caller_owns_return=True),
+                     [param('const ' + ssize_t, 'ss')],
+                     is_const=True, throw=exceptions,
+                     custom_name='local_operator')
+    Class.add_method('coupling_operator_and_return_ptr',
+                     retval(OperatorType + ' *', caller_owns_return=True),
+                     [param('const ' + ssize_t, 'ss'),
+                      param('const ' + ssize_t, 'nn')],
+                     is_const=True, throw=exceptions,
+                     custom_name='coupling_operator')
+    Class.add_method('local_functional_and_return_ptr',
+                     retval(FunctionalType + ' *', caller_owns_return=True),
+                     [param('const ' + ssize_t, 'ss')],
+                     is_const=True, throw=exceptions,
+                     custom_name='local_functional')
+    Class.add_method('local_product_and_return_ptr',
+                     retval(ProductType + ' *', caller_owns_return=True),
+                     [param('const ' + ssize_t, 'ss'),
+                      param('const std::string', 'id')],
+                     is_const=True, throw=exceptions,
+                     custom_name='local_product')
+    namespace.add_function('extract_subdomain_blocks_and_return_ptr',
+                           retval(Class.full_name + ' *', caller_owns_return=True),
+                           [param('const ' + DiscretizationClass.full_name + '&', 'discretization'),
+                            param('const std::vector< std::string >', 'product_ids')],
+                           template_parameters=[DiscretizationClass.full_name],
+                           custom_name='extract_subdomain_blocks',
+                           throw=exceptions, unblock_threads=True)
+    return Class
+
+
+def wrap_multiscale_discretization(cls, wrapper, extract_subdomain_blocks=None):
+    '''
+    If given, extract_subdomain_blocks (see inject_SubdomainBlocks) is used to extract all blocks of the
+    discretization concurrently and in one call. It must only be given for classes which were injected with
+    subdomain_blocks=True.
+    '''
 
     class WrappedDiscretization(DiscretizationInterface):
 
@@ -354,11 +474,25 @@ def wrap_multiscale_discretization(cls, wrapper):
 
         def __init__(self, d):
             self._impl = d
-            lhs_op = BlockOperator([[wrapper[d.get_local_operator(ss)] if ss == nn
-                                     else wrapper[d.get_coupling_operator(ss, nn)] if nn in list(d.neighbouring_subdomains(ss))
-                                     else None
-                                     for nn in np.arange(d.num_subdomains())] for ss in np.arange(d.num_subdomains())])
-            rhs_op = BlockOperator.hstack([wrapper[d.get_local_functional(ss)] for ss in np.arange(d.num_subdomains())])
+            if extract_subdomain_blocks is not None:
+                blocks = extract_subdomain_blocks(d, list(d.available_products()))
+                num_subdomains = blocks.num_subdomains()
+                lhs_blocks = [[None]*num_subdomains for ss in np.arange(num_subdomains)]
+                for ss in np.arange(num_subdomains):
+                    lhs_blocks[ss][ss] = wrapper[blocks.local_operator(ss)]
+                    for nn in blocks.neighbours(ss):
+                        lhs_blocks[ss][nn] = wrapper[blocks.coupling_operator(ss, nn)]
+                lhs_op = BlockOperator(lhs_blocks)
+                rhs_op = BlockOperator.hstack([wrapper[blocks.local_functional(ss)]
+                                               for ss in np.arange(num_subdomains)])
+                local_products = lambda ss, k: wrapper[blocks.local_product(ss, k)]
+            else:
+                lhs_op = BlockOperator([[wrapper[d.get_local_operator(ss)] if ss == nn
+                                         else wrapper[d.get_coupling_operator(ss, nn)] if nn in list(d.neighbouring_subdomains(ss))
+                                         else None
+                                         for nn in np.arange(d.num_subdomains())] for ss in np.arange(d.num_subdomains())])
+                rhs_op = BlockOperator.hstack([wrapper[d.get_local_functional(ss)] for ss in np.arange(d.num_subdomains())])
+                local_products = lambda ss, k: wrapper[d.get_local_product(ss, k)]
             operators = {'operator': lhs_op}
             functionals = {'rhs': rhs_op}
             vector_operators = {}
@@ -368,7 +502,7 @@ def wrap_multiscale_discretization(cls, wrapper):
             self.operator = operators['operator']
             self.solution_space = self.operator.source
             self.rhs = functionals['rhs']
-            self.products = {k: BlockDiagonalOperator([wrapper[d.get_local_product(ss, k)]
+            self.products = {k: BlockDiagonalOperator([local_products(ss, k)
                                                        for ss in np.arange(d.num_subdomains())])
                              for k in list(d.available_products())}
             if self.products:
@@ -377,6 +511,7 @@ def wrap_multiscale_discretization(cls, wrapper):
                     setattr(self, '{}_norm'.format(k), induced_norm(v))
             self.linear = all(op.linear for op in operators.itervalues())
             self.num_subdomains = self._impl.num_subdomains()
+            self._batched_localization = hasattr(self._impl, 'localize_vectors')
             self.neighboring_subdomains = [self._impl.neighbouring_subdomains(ss)
                                            for ss in np.arange(self.num_subdomains)]
             self.build_parameter_type(inherits=operators.values())
@@ -418,11 +553,20 @@ def wrap_multiscale_discretization(cls, wrapper):
             global_solution = self._impl.solve_and_return_ptr(mu)
             assert global_solution.valid()
             global_solution = make_listvectorarray(self._wrapper[global_solution])
-            return BlockVectorArray([self.localize_vector(global_solution, ss)
-                                     for ss in np.arange(self._impl.num_subdomains())])
+            return self.localize_vectors(global_solution)
 
         _solve = solve
 
+        def solve_async(self, mu=None):
+            """Starts the global solve in C++ and returns an AsyncResult, whose result() is the localized solution."""
+            mu = self.parse_parameter(mu)
+            if not self.logging_disabled:
+                self.logger.info('Solving {} for {} asynchronously ...'.format(self.name, mu))
+            mu = self._wrapper.dune_parameter(mu)
+            return AsyncResult([self._impl.solve_async(mu)],
+                               lambda solutions: self.localize_vectors(make_listvectorarray(self._wrapper[solutions[0]])),
+                               owner=self)
+
         def visualize(self, U, file_name=None, name='solution', delete=True):
             raise Exception('Not implemented yet!')
             assert len(U) == 1
@@ -440,8 +584,22 @@ def wrap_multiscale_discretization(cls, wrapper):
             return make_listvectorarray([self._wrapper[self._impl.localize_vector(global_vector._list[ii]._impl,
                                                                                   subdomain)]
                                          for ii in np.arange(len(global_vector))])
+        def localize_vectors(self, global_vectors):
+            '''Localizes all global_vectors to all subdomains, in one call if the discretization supports it.'''
+            if not self._batched_localization:
+                return BlockVectorArray([self.localize_vector(global_vectors, ss)
+                                         for ss in np.arange(self.num_subdomains)])
+            blocks = self._impl.localize_vectors([global_vectors._list[ii]._impl
+                                                  for ii in np.arange(len(global_vectors))])
+            return BlockVectorArray([make_listvectorarray([self._wrapper[vector] for vector in block])
+                                     for block in blocks])
+
         def globalize_vectors(self, local_vectors):
             assert isinstance(local_vectors, BlockVectorArray)
+            if self._batched_localization:
+                return ListVectorArray([self._wrapper[vector] for vector in self._impl.globalize_block_vectors(
+                    [[block._list[ii]._impl for ii in np.arange(len(local_vectors))]
+                     for block in local_vectors._blocks])])
             return ListVectorArray([self._wrapper[self._impl.globalize_vectors([block._list[ii]._impl
                                                                                 for block in local_vectors._blocks])]
                                     for ii in np.arange(len(local_vectors))])
@@ -473,6 +631,16 @@ def wrap_multiscale_discretization(cls, wrapper):
         def get_oversampled_discretization(self, subdomain, boundary_value_type):
             return self._wrapper[self._impl.get_oversampled_discretization(subdomain, boundary_value_type)]
 
+        def prebuild_oversampled_discretizations(self, subdomains, boundary_value_type):
+            '''Builds the oversampled discretizations of all subdomains in parallel into the cache of the discretization.
+
+            Only available if the class was injected with cached_oversampling=True.
+            '''
+            if not hasattr(self._impl, 'prebuild_oversampled_discretizations'):
+                raise NotImplementedError('{} does not cache oversampled discretizations (it was not injected with '
+                                          'cached_oversampling=True)!'.format(type(self._impl).__name__))
+            self._impl.prebuild_oversampled_discretizations(list(subdomains), boundary_value_type)
+
 
     WrappedDiscretization.__name__ = cls.__name__
     return WrappedDiscretization
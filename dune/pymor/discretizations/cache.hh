@@ -0,0 +1,291 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_DISCRETIZATIONS_CACHE_HH
+#define DUNE_PYMOR_DISCRETIZATIONS_CACHE_HH
+
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/common/memory.hh>
+#include <dune/pymor/common/threading.hh>
+#include <dune/pymor/common/tracing.hh>
+
+namespace Dune {
+namespace Pymor {
+
+
+/**
+ * \brief Caches discretizations which are expensive to build, e.g. the oversampled local discretizations of a
+ *        multiscale discretization (keyed by subdomain and boundary value type, the default KeyImp).
+ *
+ *        The builder is expected to return a discretization with all its affine containers assembled. If the
+ *        memory used by all cached discretizations (as given by size, their memory_footprint() by default) exceeds
+ *        the memory budget, the least recently used ones are evicted; discretizations which are still in use somewhere
+ *        else are kept alive by their shared_ptr. Concurrent requests of the same key build the discretization once.
+ *        Usage example:
+\code
+DiscretizationCache< OversampledDiscretizationType > cache(
+    [&](const std::pair< size_t, std::string >& key) {
+      return std::make_shared< OversampledDiscretizationType >(build_oversampled(key.first, key.second));
+    },
+    2*1024*1024*1024ul);
+cache.prebuild(keys);
+const auto discretization = cache.get(std::make_pair(subdomain, "dirichlet"));
+\endcode
+ */
+template< class DiscretizationImp, class KeyImp = std::pair< size_t, std::string > >
+class DiscretizationCache
+{
+public:
+  typedef DiscretizationImp DiscretizationType;
+  typedef KeyImp            KeyType;
+
+  typedef std::function< std::shared_ptr< DiscretizationType >(const KeyType&) > BuilderType;
+  typedef std::function< size_t(const DiscretizationType&) >                    SizeType;
+
+  /**
+   * \param memory_budget in bytes, 0 for no limit
+   */
+  DiscretizationCache(const BuilderType builder, const size_t memory_budget = 0)
+    : builder_(builder)
+    , size_(&DiscretizationCache::footprint)
+    , memory_budget_(memory_budget)
+    , memory_used_(0)
+    , hits_(0)
+    , misses_(0)
+    , evictions_(0)
+  {}
+
+  DiscretizationCache(const BuilderType builder, const SizeType size, const size_t memory_budget)
+    : builder_(builder)
+    , size_(size)
+    , memory_budget_(memory_budget)
+    , memory_used_(0)
+    , hits_(0)
+    , misses_(0)
+    , evictions_(0)
+  {}
+
+  /**
+   * \brief Returns the discretization for key, builds it if it is not cached.
+   */
+  std::shared_ptr< const DiscretizationType > get(const KeyType& key)
+  {
+    std::unique_lock< std::mutex > lock(mutex_);
+    const auto result = entries_.find(key);
+    if (result != entries_.end()) {
+      ++hits_;
+      touch(result->second);
+      const auto discretization = result->second.discretization;
+      lock.unlock();
+      // wait for the build if it is still in progress
+      return discretization.get();
+    }
+    ++misses_;
+    return build(key, lock);
+  } // ... get(...)
+
+  /**
+   * \brief Builds all not yet cached discretizations in keys concurrently.
+   * \note  The memory budget is applied after each build, so more discretizations than fit into the budget are built
+   *        but not kept.
+   */
+  void prebuild(const std::vector< KeyType >& keys, const size_t num_threads = 0)
+  {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.discretizations.cache.prebuild");
+    parallel_for(0, keys.size(), [&](const size_t first, const size_t last) {
+      for (size_t ii = first; ii < last; ++ii) {
+        std::unique_lock< std::mutex > lock(mutex_);
+        if (entries_.find(keys[ii]) == entries_.end())
+          build(keys[ii], lock);
+      }
+    }, num_threads);
+  } // ... prebuild(...)
+
+  bool contains(const KeyType& key) const
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    return entries_.find(key) != entries_.end();
+  }
+
+  void erase(const KeyType& key)
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    const auto result = entries_.find(key);
+    if (result != entries_.end() && result->second.ready) {
+      memory_used_ -= result->second.bytes;
+      usage_.erase(result->second.position);
+      entries_.erase(result);
+    }
+  } // ... erase(...)
+
+  /**
+   * \brief Removes all discretizations which are not being built at the moment.
+   */
+  void clear()
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    for (auto entry = entries_.begin(); entry != entries_.end();) {
+      if (entry->second.ready) {
+        memory_used_ -= entry->second.bytes;
+        usage_.erase(entry->second.position);
+        entry = entries_.erase(entry);
+      } else
+        ++entry;
+    }
+  } // ... clear(...)
+
+  size_t size() const
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    return entries_.size();
+  }
+
+  size_t memory_budget() const
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    return memory_budget_;
+  }
+
+  void set_memory_budget(const size_t memory_budget)
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    memory_budget_ = memory_budget;
+    evict();
+  }
+
+  size_t memory_used() const
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    return memory_used_;
+  }
+
+  size_t hits() const
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    return hits_;
+  }
+
+  size_t misses() const
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    return misses_;
+  }
+
+  size_t evictions() const
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    return evictions_;
+  }
+
+private:
+  typedef std::shared_future< std::shared_ptr< const DiscretizationType > > FutureType;
+  typedef std::list< KeyType >                                            UsageType;
+
+  struct Entry
+  {
+    FutureType discretization;
+    //! the position in usage_, the most recently used key is at the front
+    typename UsageType::iterator position;
+    size_t bytes;
+    bool ready;
+  }; // struct Entry
+
+  static size_t footprint(const DiscretizationType& discretization)
+  {
+    return discretization.memory_footprint().total();
+  }
+
+  void touch(Entry& entry)
+  {
+    usage_.splice(usage_.begin(), usage_, entry.position);
+  }
+
+  /**
+   * \brief Builds the discretization for key (which is not in entries_ yet), lock is locked on entry and on return.
+   */
+  std::shared_ptr< const DiscretizationType > build(const KeyType& key, std::unique_lock< std::mutex >& lock)
+  {
+    std::promise< std::shared_ptr< const DiscretizationType > > promise;
+    usage_.push_front(key);
+    entries_[key] = Entry{promise.get_future().share(), usage_.begin(), 0, false};
+    lock.unlock();
+    std::shared_ptr< const DiscretizationType > discretization;
+    size_t bytes = 0;
+    try {
+      DUNE_PYMOR_TRACE_SCOPE("pymor.discretizations.cache.build");
+      discretization = builder_(key);
+      if (!discretization)
+        DUNE_THROW(Stuff::Exceptions::internal_error, "the builder did not return a discretization!");
+      bytes = size_(*discretization);
+    } catch (...) {
+      // waiting requests get the exception, later ones try again
+      promise.set_exception(std::current_exception());
+      lock.lock();
+      const auto result = entries_.find(key);
+      usage_.erase(result->second.position);
+      entries_.erase(result);
+      throw;
+    }
+    promise.set_value(discretization);
+    lock.lock();
+    auto& entry = entries_.find(key)->second;
+    entry.bytes = bytes;
+    entry.ready = true;
+    memory_used_ += bytes;
+    evict();
+    return discretization;
+  } // ... build(...)
+
+  /**
+   * \brief Removes least recently used discretizations until the memory budget is met, the most recently used one is
+   *        always kept.
+   */
+  void evict()
+  {
+    if (memory_budget_ == 0)
+      return;
+    auto position = usage_.end();
+    while (memory_used_ > memory_budget_ && position != usage_.begin()) {
+      --position;
+      if (position == usage_.begin())
+        break;
+      const auto result = entries_.find(*position);
+      if (!result->second.ready)
+        continue;
+      memory_used_ -= result->second.bytes;
+      entries_.erase(result);
+      position = usage_.erase(position);
+      ++evictions_;
+    }
+  } // ... evict(...)
+
+  const BuilderType builder_;
+  const SizeType size_;
+  mutable std::mutex mutex_;
+  std::map< KeyType, Entry > entries_;
+  UsageType usage_;
+  size_t memory_budget_;
+  size_t memory_used_;
+  size_t hits_;
+  size_t misses_;
+  size_t evictions_;
+}; // class DiscretizationCache
+
+
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_DISCRETIZATIONS_CACHE_HH
@@ -7,8 +7,13 @@
 #define DUNE_PYMOR_DISCRETIZATIONS_DEFAULT_HH
 
 #include <map>
+#include <mutex>
 
 #include <dune/stuff/common/crtp.hh>
+#include <dune/stuff/common/string.hh>
+
+#include <dune/pymor/common/memory.hh>
+#include <dune/pymor/la/container/memory.hh>
 
 #include "interfaces.hh"
 
@@ -34,18 +39,60 @@ public:
     : BaseType(other)
   {}
 
+  CachingDefault(const CachingDefault& other)
+    : BaseType(other)
+    , cache_(other.cached_solutions())
+  {}
+
+  CachingDefault& operator=(const CachingDefault& other)
+  {
+    if (this != &other) {
+      BaseType::operator=(other);
+      auto cache = other.cached_solutions();
+      std::lock_guard< std::mutex > lock(mutex_);
+      cache_ = std::move(cache);
+    }
+    return *this;
+  }
+
+  /**
+   * \note May be called concurrently, the cache is locked only for lookup and insertion, so concurrent solves for the
+   *       same mu may both compute the solution.
+   */
   void solve(VectorType& vector, const Parameter mu = Parameter()) const
   {
-    const auto search_result = cache_.find(mu);
-    if (search_result == cache_.end()) {
-      uncached_solve(vector, mu);
-      cache_.insert(std::make_pair(mu, std::shared_ptr< VectorType >(new VectorType(vector.copy()))));
+    std::shared_ptr< VectorType > cached;
+    {
+      std::lock_guard< std::mutex > lock(mutex_);
+      const auto search_result = cache_.find(mu);
+      if (search_result != cache_.end())
+        cached = search_result->second;
+    }
+    if (cached) {
+      vector = *cached;
     } else {
-      const auto& result = *(search_result->second);
-      vector = result;
+      uncached_solve(vector, mu);
+      const std::shared_ptr< VectorType > solution(new VectorType(vector.copy()));
+      std::lock_guard< std::mutex > lock(mutex_);
+      cache_.insert(std::make_pair(mu, solution));
     }
   } // ... solve(...)
 
+  /**
+   * \brief Adds the cached solutions to the footprint of the discretization.
+   */
+  void memory_footprint(MemoryFootprint& footprint, const std::string prefix = "") const
+  {
+    BaseType::memory_footprint(footprint, prefix);
+    size_t ii = 0;
+    for (const auto& element : cached_solutions())
+      Pymor::LA::memory_footprint(*element.second,
+                                  footprint,
+                                  MemoryFootprint::join(prefix, "cache.solution_" + Stuff::Common::toString(ii++)));
+  } // ... memory_footprint(...)
+
+  using BaseType::memory_footprint;
+
 protected:
   void uncached_solve(VectorType& vector, const Parameter mu = Parameter()) const
   {
@@ -53,7 +100,16 @@ protected:
   }
 
 private:
-  mutable std::map< Parameter, std::shared_ptr< VectorType > > cache_;
+  typedef std::map< Parameter, std::shared_ptr< VectorType > > CacheType;
+
+  CacheType cached_solutions() const
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    return cache_;
+  }
+
+  mutable std::mutex mutex_;
+  mutable CacheType cache_;
 }; // class CachingDefault
 
 
@@ -8,13 +8,18 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 
 #include <dune/stuff/common/crtp.hh>
 #include <dune/stuff/common/configuration.hh>
 #include <dune/stuff/common/exceptions.hh>
 #include <dune/stuff/la/container/interfaces.hh>
 
+#include <dune/pymor/common/memory.hh>
+#include <dune/pymor/common/threading.hh>
+#include <dune/pymor/common/tracing.hh>
 #include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/parameters/batch.hh>
 #include <dune/pymor/operators/interfaces.hh>
 #include <dune/pymor/functionals/interfaces.hh>
 #include <dune/pymor/la/container/affine.hh>
@@ -130,6 +135,7 @@ public:
 
   void solve(const DSC::Configuration options, VectorType& vector, const Parameter mu = Parameter()) const
   {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.discretizations.stationary.solve");
     CHECK_AND_CALL_CRTP(this->as_imp().solve(options, vector, mu));
   }
 
@@ -154,11 +160,51 @@ public:
     return ret;
   }
 
+  /**
+   * \brief Solves for each parameter in mus, vectors is resized to mus.size().
+   */
+  void solve(const ParameterBatch& mus, std::vector< VectorType >& vectors) const
+  {
+    solve(solver_options(solver_types()[0]), mus, vectors);
+  }
+
+  void solve(const DSC::Configuration options, const ParameterBatch& mus, std::vector< VectorType >& vectors) const
+  {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.discretizations.stationary.solve_batch");
+    vectors.clear();
+    vectors.reserve(mus.size());
+    for (DUNE_STUFF_SSIZE_T ii = 0; ii < mus.size(); ++ii) {
+      vectors.emplace_back(create_vector());
+      solve(options, vectors.back(), mus.parameter(ii));
+    }
+  } // ... solve(...)
+
   void visualize(const VectorType& vector, const std::string filename, const std::string name) const
   {
     CHECK_AND_CALL_CRTP(this->as_imp().visualize(vector, filename, name));
   }
 
+  /**
+   * \brief Adds the storage of the operator, the rhs, all products and all vectors to footprint.
+   * \note  This default implementation may be extended by derived classes holding additional data.
+   */
+  void memory_footprint(MemoryFootprint& footprint, const std::string prefix = "") const
+  {
+    get_operator().memory_footprint(footprint, MemoryFootprint::join(prefix, "operator"));
+    get_rhs().memory_footprint(footprint, MemoryFootprint::join(prefix, "rhs"));
+    for (const auto& id : available_products())
+      get_product(id).memory_footprint(footprint, MemoryFootprint::join(prefix, "product." + id));
+    for (const auto& id : available_vectors())
+      get_vector(id).memory_footprint(footprint, MemoryFootprint::join(prefix, "vector." + id));
+  } // ... memory_footprint(...)
+
+  MemoryFootprint memory_footprint() const
+  {
+    MemoryFootprint footprint;
+    this->as_imp().memory_footprint(footprint, "");
+    return footprint;
+  }
+
   OperatorType* get_operator_and_return_ptr() const
   {
     return new OperatorType(get_operator());
@@ -189,17 +235,59 @@ public:
 
   VectorType* solve_and_return_ptr(const Parameter mu = Parameter()) const
   {
-    return new VectorType(solve(mu));
+    std::unique_ptr< VectorType > vector(new VectorType(create_vector()));
+    solve(*vector, mu);
+    return vector.release();
   }
 
   VectorType* solve_and_return_ptr(const std::string type, const Parameter mu = Parameter()) const
   {
-    return new VectorType(solve(type, mu));
+    std::unique_ptr< VectorType > vector(new VectorType(create_vector()));
+    solve(type, *vector, mu);
+    return vector.release();
   }
 
   VectorType* solve_and_return_ptr(const DSC::Configuration options, const Parameter mu = Parameter()) const
   {
-    return new VectorType(solve(options, mu));
+    std::unique_ptr< VectorType > vector(new VectorType(create_vector()));
+    solve(options, *vector, mu);
+    return vector.release();
+  }
+
+  /**
+   * \brief Solves on the default_thread_pool(), so that the caller can go on (e.g. with estimating the error of the
+   *        previous snapshot) in the meantime. The discretization has to outlive the solve.
+   */
+  AsyncResult< VectorType > solve_async(const Parameter mu = Parameter()) const
+  {
+    return solve_async(solver_options(), mu);
+  }
+
+  AsyncResult< VectorType > solve_async(const std::string type, const Parameter mu = Parameter()) const
+  {
+    return solve_async(solver_options(type), mu);
+  }
+
+  AsyncResult< VectorType > solve_async(const DSC::Configuration options, const Parameter mu = Parameter()) const
+  {
+    const auto* self = this;
+    return run_async< VectorType >([self, options, mu]() { return self->solve_and_return_ptr(options, mu); });
+  }
+
+  AsyncResult< VectorType >* solve_async_and_return_ptr(const Parameter mu = Parameter()) const
+  {
+    return new AsyncResult< VectorType >(solve_async(mu));
+  }
+
+  AsyncResult< VectorType >* solve_async_and_return_ptr(const std::string type, const Parameter mu = Parameter()) const
+  {
+    return new AsyncResult< VectorType >(solve_async(type, mu));
+  }
+
+  AsyncResult< VectorType >* solve_async_and_return_ptr(const DSC::Configuration options,
+                                                        const Parameter mu = Parameter()) const
+  {
+    return new AsyncResult< VectorType >(solve_async(options, mu));
   }
 }; // class StationaryDiscretizationInterface
 
@@ -0,0 +1,216 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_DISCRETIZATIONS_MULTISCALE_HH
+#define DUNE_PYMOR_DISCRETIZATIONS_MULTISCALE_HH
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/common/threading.hh>
+#include <dune/pymor/common/tracing.hh>
+
+namespace Dune {
+namespace Pymor {
+
+
+/**
+ * \brief All local operators, coupling operators, local functionals and local products of a multiscale
+ *        discretization, extracted for all subdomains at once.
+ *
+ *        The blocks are extracted concurrently, one task per subdomain on the given pool, so the
+ *        get_local_*_and_return_ptr(), get_coupling_operator_and_return_ptr() and neighbouring_subdomains() methods of the
+ *        discretization (the ones required by the python bindings of a multiscale discretization) have to be safe to be
+ *        called concurrently. The coupling operators are stored sparsely, only for neighbouring subdomains.
+ */
+template< class DiscretizationImp >
+class SubdomainBlocks
+{
+public:
+  typedef DiscretizationImp                          DiscretizationType;
+  typedef typename DiscretizationType::OperatorType   OperatorType;
+  typedef typename DiscretizationType::FunctionalType FunctionalType;
+  typedef typename DiscretizationType::ProductType    ProductType;
+
+  SubdomainBlocks(const DiscretizationType& discretization,
+                  const std::vector< std::string > product_ids = std::vector< std::string >(),
+                  ThreadPool& pool = default_thread_pool())
+    : product_ids_(product_ids)
+    , num_subdomains_(discretization.num_subdomains())
+    , local_operators_(num_subdomains_)
+    , coupling_operators_(num_subdomains_)
+    , local_functionals_(num_subdomains_)
+    , local_products_(num_subdomains_)
+  {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.discretizations.multiscale.subdomain_blocks");
+    std::vector< AsyncResult< size_t > > extracted;
+    extracted.reserve(num_subdomains_);
+    // all tasks refer to this, so they have to be finished before any exception is rethrown
+    try {
+      for (size_t ss = 0; ss < num_subdomains_; ++ss)
+        extracted.push_back(run_async< size_t >([this, &discretization, ss]() {
+                                                  extract(discretization, ss);
+                                                  return new size_t(ss);
+                                                }, pool));
+    } catch (...) {
+      for (const auto& result : extracted)
+        result.wait();
+      throw;
+    }
+    for (const auto& result : extracted)
+      result.wait();
+    for (const auto& result : extracted)
+      result.get();
+  } // SubdomainBlocks(...)
+
+  size_t num_subdomains() const
+  {
+    return num_subdomains_;
+  }
+
+  const std::vector< std::string >& product_ids() const
+  {
+    return product_ids_;
+  }
+
+  /**
+   * \brief The subdomains coupled to ss, in ascending order.
+   */
+  std::vector< size_t > neighbours(const size_t ss) const
+  {
+    check_subdomain(ss);
+    std::vector< size_t > ret;
+    ret.reserve(coupling_operators_[ss].size());
+    for (const auto& coupling : coupling_operators_[ss])
+      ret.push_back(coupling.first);
+    return ret;
+  }
+
+  const OperatorType& local_operator(const size_t ss) const
+  {
+    check_subdomain(ss);
+    return *local_operators_[ss];
+  }
+
+  const OperatorType& coupling_operator(const size_t ss, const size_t nn) const
+  {
+    check_subdomain(ss);
+    const auto& couplings = coupling_operators_[ss];
+    const auto result = std::lower_bound(couplings.begin(), couplings.end(), nn,
+                                         [](const CouplingType& coupling, const size_t value) {
+                                           return coupling.first < value;
+                                         });
+    if (result == couplings.end() || result->first != nn)
+      DUNE_THROW(Stuff::Exceptions::index_out_of_range, "subdomains " << ss << " and " << nn << " are not coupled!");
+    return *result->second;
+  } // ... coupling_operator(...)
+
+  const FunctionalType& local_functional(const size_t ss) const
+  {
+    check_subdomain(ss);
+    return *local_functionals_[ss];
+  }
+
+  const ProductType& local_product(const size_t ss, const std::string id) const
+  {
+    check_subdomain(ss);
+    const auto result = std::find(product_ids_.begin(), product_ids_.end(), id);
+    if (result == product_ids_.end())
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "Product '" << id << "' was not extracted!");
+    return *local_products_[ss][std::distance(product_ids_.begin(), result)];
+  }
+
+  std::vector< DUNE_STUFF_SSIZE_T > pb_neighbours(const DUNE_STUFF_SSIZE_T ss) const
+  {
+    const auto neighbours_of_ss = neighbours(to_index(ss));
+    return std::vector< DUNE_STUFF_SSIZE_T >(neighbours_of_ss.begin(), neighbours_of_ss.end());
+  }
+
+  OperatorType* local_operator_and_return_ptr(const DUNE_STUFF_SSIZE_T ss) const
+  {
+    return new OperatorType(local_operator(to_index(ss)));
+  }
+
+  OperatorType* coupling_operator_and_return_ptr(const DUNE_STUFF_SSIZE_T ss, const DUNE_STUFF_SSIZE_T nn) const
+  {
+    return new OperatorType(coupling_operator(to_index(ss), to_index(nn)));
+  }
+
+  FunctionalType* local_functional_and_return_ptr(const DUNE_STUFF_SSIZE_T ss) const
+  {
+    return new FunctionalType(local_functional(to_index(ss)));
+  }
+
+  ProductType* local_product_and_return_ptr(const DUNE_STUFF_SSIZE_T ss, const std::string id) const
+  {
+    return new ProductType(local_product(to_index(ss), id));
+  }
+
+private:
+  typedef std::pair< size_t, std::shared_ptr< OperatorType > > CouplingType;
+
+  void extract(const DiscretizationType& discretization, const size_t ss)
+  {
+    typedef DUNE_STUFF_SSIZE_T IndexType;
+    const IndexType subdomain = static_cast< IndexType >(ss);
+    local_operators_[ss].reset(discretization.get_local_operator_and_return_ptr(subdomain));
+    local_functionals_[ss].reset(discretization.get_local_functional_and_return_ptr(subdomain));
+    for (const auto& id : product_ids_)
+      local_products_[ss].emplace_back(discretization.get_local_product_and_return_ptr(subdomain, id));
+    auto& couplings = coupling_operators_[ss];
+    for (const auto& neighbour : discretization.neighbouring_subdomains(subdomain)) {
+      const size_t nn = static_cast< size_t >(neighbour);
+      if (nn != ss)
+        couplings.emplace_back(nn, std::shared_ptr< OperatorType >(
+                                     discretization.get_coupling_operator_and_return_ptr(subdomain, neighbour)));
+    }
+    std::sort(couplings.begin(), couplings.end(),
+              [](const CouplingType& lhs, const CouplingType& rhs) { return lhs.first < rhs.first; });
+  } // ... extract(...)
+
+  void check_subdomain(const size_t ss) const
+  {
+    if (ss >= num_subdomains_)
+      DUNE_THROW(Stuff::Exceptions::index_out_of_range,
+                 "ss has to be smaller than " << num_subdomains_ << " (is " << ss << ")!");
+  }
+
+  static size_t to_index(const DUNE_STUFF_SSIZE_T ii)
+  {
+    if (ii < 0)
+      DUNE_THROW(Stuff::Exceptions::index_out_of_range, "subdomain indices have to be nonnegative (is " << ii << ")!");
+    return static_cast< size_t >(ii);
+  }
+
+  const std::vector< std::string > product_ids_;
+  const size_t num_subdomains_;
+  std::vector< std::shared_ptr< OperatorType > > local_operators_;
+  std::vector< std::vector< CouplingType > > coupling_operators_;
+  std::vector< std::shared_ptr< FunctionalType > > local_functionals_;
+  std::vector< std::vector< std::shared_ptr< ProductType > > > local_products_;
+}; // class SubdomainBlocks
+
+
+/**
+ * \brief Extracts all blocks of discretization concurrently, \see SubdomainBlocks.
+ */
+template< class DiscretizationType >
+SubdomainBlocks< DiscretizationType >* extract_subdomain_blocks_and_return_ptr(
+    const DiscretizationType& discretization,
+    const std::vector< std::string > product_ids)
+{
+  return new SubdomainBlocks< DiscretizationType >(discretization, product_ids);
+}
+
+
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_DISCRETIZATIONS_MULTISCALE_HH
@@ -59,19 +59,24 @@ def inject_VectorBasedImplementation(module, exceptions, interfaces, CONFIG_H, T
                      retval(ScalarType),
                      [param('const ' + SourceType + ' &', 'source')],
                      is_const=True,
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('apply',
                      retval(ScalarType),
                      [param('const ' + SourceType + ' &', 'source'),
                       param('const Dune::Pymor::Parameter', 'mu')],
                      is_const=True,
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('as_vector_and_return_ptr',
                      retval(ContainerType + ' *', caller_owns_return=True),
                      [],
                      is_const=True,
                      throw=exceptions,
                      custom_name='as_vector')
+    Class.add_method('memory_footprint',
+                     retval('Dune::Pymor::MemoryFootprint'),
+                     [],
+                     is_const=True,
+                     throw=exceptions)
     return Class
 
 
@@ -214,19 +219,24 @@ def inject_LinearAffinelyDecomposedVectorBasedImplementation(module,
                      retval(ScalarType),
                      [param('const ' + SourceType + ' &', 'source')],
                      is_const=True,
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('apply',
                      retval(ScalarType),
                      [param('const ' + SourceType + ' &', 'source'),
                       param('const Dune::Pymor::Parameter', 'mu')],
                      is_const=True,
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('freeze_parameter_and_return_ptr',
                      retval(FrozenType + ' *', caller_owns_return=True),
                      [param('const Dune::Pymor::Parameter', 'mu')],
                      is_const=True,
-                     throw=exceptions,
+                     throw=exceptions, unblock_threads=True,
                      custom_name='freeze_parameter')
+    Class.add_method('memory_footprint',
+                     retval('Dune::Pymor::MemoryFootprint'),
+                     [],
+                     is_const=True,
+                     throw=exceptions)
     return Class
 
 
@@ -12,6 +12,7 @@
 
 #include <dune/stuff/la/container/interfaces.hh>
 
+#include <dune/pymor/common/tracing.hh>
 #include <dune/pymor/parameters/functional.hh>
 #include <dune/pymor/la/container/affine.hh>
 
@@ -143,6 +144,7 @@ public:
 
   FrozenType freeze_parameter(const Parameter mu = Parameter()) const
   {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.functionals.linearaffinelydecomposedvectorbased.freeze_parameter");
     if (!Parametric::parametric())
       DUNE_THROW(Exceptions::this_is_not_parametric, "do not call freeze_parameter(" << mu << ")"
                  << "if parametric() == false!");
@@ -150,7 +152,7 @@ public:
       DUNE_THROW(Exceptions::wrong_parameter_type,
                  "the type of mu (" << mu.type() << ") does not match the parameter_type of this ("
                  << Parametric::parameter_type() << ")!");
-    return FrozenType(new VectorType(affinelyDecomposedVector_.freeze_parameter(mu)));
+    return FrozenType(affinelyDecomposedVector_.freeze_parameter_ptr(mu));
   }
 
   FrozenType* freeze_parameter_and_return_ptr(const Parameter mu = Parameter()) const
@@ -158,6 +160,13 @@ public:
     return new FrozenType(freeze_parameter(mu));
   }
 
+  void memory_footprint(MemoryFootprint& footprint, const std::string prefix = "") const
+  {
+    affinelyDecomposedVector_.memory_footprint(footprint, prefix);
+  }
+
+  using BaseType::memory_footprint;
+
 private:
   const AffinelyDecomposedVectorType affinelyDecomposedVector_;
   DUNE_STUFF_SSIZE_T dim_;
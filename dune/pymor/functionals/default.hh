@@ -12,7 +12,9 @@
 
 #include <dune/stuff/la/container/interfaces.hh>
 
+#include <dune/pymor/common/memory.hh>
 #include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/la/container/memory.hh>
 #include "interfaces.hh"
 
 namespace Dune {
@@ -100,6 +102,13 @@ public:
     return new ContainerType(vector_->copy());
   }
 
+  void memory_footprint(MemoryFootprint& footprint, const std::string prefix = "") const
+  {
+    Pymor::LA::memory_footprint(*vector_, footprint, MemoryFootprint::join(prefix, "vector"));
+  }
+
+  using FunctionalInterface< Traits >::memory_footprint;
+
 private:
   std::shared_ptr< const ContainerType > vector_;
 }; // class VectorBased
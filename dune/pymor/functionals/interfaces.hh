@@ -11,6 +11,7 @@
 
 #include <dune/pymor/common/exceptions.hh>
 #include <dune/pymor/common/crtp.hh>
+#include <dune/pymor/common/memory.hh>
 #include <dune/pymor/parameters/base.hh>
 #include <dune/pymor/parameters/functional.hh>
 
@@ -80,6 +81,20 @@ public:
     CHECK_INTERFACE_IMPLEMENTATION(CRTP::as_imp(*this).freeze_parameter(mu));
     return CRTP::as_imp(*this).freeze_parameter(mu);
   }
+
+  /**
+   * \brief Adds the storage of this functional to footprint, the names of all entries are prefixed by prefix.
+   * \note  This default reports nothing, derived classes owning storage should implement it.
+   */
+  void memory_footprint(MemoryFootprint& /*footprint*/, const std::string /*prefix*/ = "") const
+  {}
+
+  MemoryFootprint memory_footprint() const
+  {
+    MemoryFootprint footprint;
+    CRTP::as_imp(*this).memory_footprint(footprint, "");
+    return footprint;
+  }
 }; // class FunctionalInterface
 
 
@@ -0,0 +1,88 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_FUNCTIONS_BATCHED_HH
+#define DUNE_PYMOR_FUNCTIONS_BATCHED_HH
+
+#include <vector>
+
+#include <dune/stuff/functions/interfaces.hh>
+
+namespace Dune {
+namespace Pymor {
+namespace internal {
+
+
+/**
+ * \brief Implemented by local functions which evaluate a set of points (e.g. all points of a quadrature) faster at
+ *        once than one by one.
+ * \see   Pymor::evaluate() and Pymor::jacobian()
+ * \note  The local functions of PiecewiseConstant, of the cell indicators of Checkerboard and of with_mu() (if it does
+ *        not collapse) implement this.
+ */
+template< class E, class D, int d, class R, int r, int rC >
+class BatchedLocalfunctionInterface
+{
+  typedef Stuff::LocalfunctionInterface< E, D, d, R, r, rC > LocalfunctionType;
+public:
+  typedef typename LocalfunctionType::DomainType        DomainType;
+  typedef typename LocalfunctionType::RangeType         RangeType;
+  typedef typename LocalfunctionType::JacobianRangeType JacobianRangeType;
+
+  virtual ~BatchedLocalfunctionInterface() {}
+
+  virtual void evaluate(const std::vector< DomainType >& xx, std::vector< RangeType >& ret) const = 0;
+
+  virtual void jacobian(const std::vector< DomainType >& xx, std::vector< JacobianRangeType >& ret) const = 0;
+}; // class BatchedLocalfunctionInterface
+
+
+} // namespace internal
+
+
+/**
+ * \brief Evaluates local_function at all points xx, at once if local_function supports this.
+ */
+template< class E, class D, int d, class R, int r, int rC >
+void evaluate(const Stuff::LocalfunctionInterface< E, D, d, R, r, rC >& local_function,
+              const std::vector< typename Stuff::LocalfunctionInterface< E, D, d, R, r, rC >::DomainType >& xx,
+              std::vector< typename Stuff::LocalfunctionInterface< E, D, d, R, r, rC >::RangeType >& ret)
+{
+  typedef internal::BatchedLocalfunctionInterface< E, D, d, R, r, rC > BatchedType;
+  const auto* batched = dynamic_cast< const BatchedType* >(&local_function);
+  if (batched)
+    batched->evaluate(xx, ret);
+  else {
+    ret.resize(xx.size());
+    for (size_t pp = 0; pp < xx.size(); ++pp)
+      local_function.evaluate(xx[pp], ret[pp]);
+  }
+} // ... evaluate(...)
+
+
+/**
+ * \brief Evaluates the jacobian of local_function at all points xx, at once if local_function supports this.
+ */
+template< class E, class D, int d, class R, int r, int rC >
+void jacobian(const Stuff::LocalfunctionInterface< E, D, d, R, r, rC >& local_function,
+              const std::vector< typename Stuff::LocalfunctionInterface< E, D, d, R, r, rC >::DomainType >& xx,
+              std::vector< typename Stuff::LocalfunctionInterface< E, D, d, R, r, rC >::JacobianRangeType >& ret)
+{
+  typedef internal::BatchedLocalfunctionInterface< E, D, d, R, r, rC > BatchedType;
+  const auto* batched = dynamic_cast< const BatchedType* >(&local_function);
+  if (batched)
+    batched->jacobian(xx, ret);
+  else {
+    ret.resize(xx.size());
+    for (size_t pp = 0; pp < xx.size(); ++pp)
+      local_function.jacobian(xx[pp], ret[pp]);
+  }
+} // ... jacobian(...)
+
+
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_FUNCTIONS_BATCHED_HH
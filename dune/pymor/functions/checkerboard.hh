@@ -6,32 +6,49 @@
 #ifndef DUNE_PYMOR_FUNCTIONS_CHECKERBOARD_HH
 #define DUNE_PYMOR_FUNCTIONS_CHECKERBOARD_HH
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <vector>
 #include <memory>
+#include <mutex>
 
-#include <dune/stuff/functions/checkerboard.hh>
 #include <dune/stuff/common/configuration.hh>
 #include <dune/stuff/common/memory.hh>
 #include <dune/stuff/common/fvector.hh>
 
 #include <dune/pymor/common/exceptions.hh>
 #include <dune/pymor/parameters/functional.hh>
-#include <dune/pymor/functions/default.hh>
 
 #include "interfaces.hh"
+#include "default.hh"
+#include "piecewiseconstant.hh"
 
 namespace Dune {
 namespace Pymor {
 namespace Functions {
 
 
+/**
+ * \brief A parametric function which is constant on each cell of a checkerboard, the value on cell ii being given by
+ *        parameterName[ii].
+ *
+ *        All components share the same cells and only the ones which are actually accessed are created, so the memory
+ *        is linear in the number of cells. with_mu() returns a PiecewiseConstant on the same cells, which evaluates
+ *        with a single cell lookup per entity.
+ *
+ *        Further components (and an affine part) may be registered as with any AffinelyDecomposableDefault, they are
+ *        numbered after the num_cells() cell indicators.
+ */
 template< class EntityImp, class DomainFieldImp, int domainDim, class RangeFieldImp, int rangeDim, int rangeDimCols = 1 >
 class Checkerboard
-  : public AffinelyDecomposableDefault < EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols >
+  : public AffinelyDecomposableDefault< EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols >
 {
   typedef Checkerboard< EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols > ThisType;
   typedef AffinelyDecomposableDefault
       < EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols >                 BaseType;
+  typedef AffinelyDecomposableFunctionInterface
+      < EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols >                 InterfaceType;
 public:
   typedef typename BaseType::NonparametricType  NonparametricType;
   typedef typename BaseType::EntityType         EntityType;
@@ -45,11 +62,14 @@ public:
   static const unsigned int                 dimRangeCols = BaseType::dimRangeCols;
   typedef typename BaseType::RangeType      RangeType;
 
+  typedef typename BaseType::SupportType                            SupportType;
+  typedef internal::CheckerboardCells< DomainFieldType, domainDim > CellsType;
+
   static const bool available = true;
 
   static std::string static_id()
   {
-    return BaseType::BaseType::static_id() + ".checkerboard";
+    return InterfaceType::static_id() + ".checkerboard";
   }
 
   static Stuff::Common::Configuration default_config(const std::string sub_name = "")
@@ -92,42 +112,225 @@ public:
                const std::string parameterName = "value",
                const std::string name = static_id())
     : BaseType(name)
+    , cells_(std::make_shared< CellsType >(lowerLeft, upperRight, numElements))
+    , parameterName_(parameterName)
+    , cellsParameterType_(parameterName_.empty() ? ParameterType() : ParameterType(parameterName_, cells_->size()))
+    , components_(cells_->size())
+    , coefficients_(cells_->size())
   {
-    size_t parameterSize = 1;
-    for (size_t dd = 0; dd < dimDomain; ++dd) {
-      if (lowerLeft[dd] >= upperRight[dd])
-        DUNE_THROW(Stuff::Exceptions::wrong_input_given,
-                   "lowerLeft[" << dd << "] = " << lowerLeft[dd] << " has to be smaller than upperRight[" << dd << "]!");
-      if (numElements[dd] <= 0)
-        DUNE_THROW(Stuff::Exceptions::wrong_input_given,
-                   "numElements[" << dd << "] has to be positive (is " << numElements[dd] << ")!");
-      parameterSize *= numElements[dd];
-    }
-    if (parameterName.empty())
+    if (parameterName_.empty())
       DUNE_THROW(Stuff::Exceptions::wrong_input_given, "parameterName must not be empty!");
-    // build parameter
-    const ParameterType parameterType(parameterName, parameterSize);
-    // create the coefficients and components
-    typedef Dune::Stuff::Functions::Checkerboard
-        < EntityType, DomainFieldType, dimDomain, RangeFieldType, dimRange, dimRangeCols >
-      NonparametricCheckerboardType;
-    for (size_t ii = 0; ii < parameterSize; ++ii) {
-      std::vector< RangeType > indicator(parameterSize, RangeType(0));
-      indicator[ii] = RangeType(1);
-      BaseType::register_component(new NonparametricCheckerboardType(lowerLeft,
-                                                                     upperRight,
-                                                                     numElements,
-                                                                     std::move(indicator),
-                                                                     name + "_component_" + DSC::toString(ii)),
-                                   new ParameterFunctional(parameterType,
-                                                           parameterName + "[" + DSC::toString(ii) + "]"));
-    } // create the coefficients and components
+    this->inherit_parameter_type(cellsParameterType_, "cells");
   } // Checkerboard()
 
   virtual std::string type() const override
   {
-    return BaseType::BaseType::static_id() + ".checkerboard";
+    return InterfaceType::static_id() + ".checkerboard";
+  }
+
+  size_t num_cells() const
+  {
+    return cells_->size();
+  }
+
+  /**
+   * \brief Restricts the support of the registered component qq (which has to be at least num_cells()).
+   */
+  void set_component_support(const DUNE_STUFF_SSIZE_T qq, const SupportType& support)
+  {
+    if (qq >= 0 && size_t(qq) < num_cells())
+      DUNE_THROW(Stuff::Exceptions::you_are_using_this_wrong,
+                 "the support of the indicator of cell " << qq << " is fixed!");
+    BaseType::set_component_support(qq - num_cells(), support);
+  } // ... set_component_support(...)
+
+  virtual DUNE_STUFF_SSIZE_T num_components() const override
+  {
+    return num_cells() + BaseType::num_components();
+  }
+
+  /**
+   * \brief The indicator of cell qq (created upon first access) or the registered component qq - num_cells().
+   */
+  virtual const std::shared_ptr< const NonparametricType >& component(const DUNE_STUFF_SSIZE_T qq) const override
+  {
+    check_index(qq);
+    if (size_t(qq) >= num_cells())
+      return BaseType::component(qq - num_cells());
+    std::lock_guard< std::mutex > lock(mutex_);
+    if (!components_[qq])
+      components_[qq] = std::make_shared< IndicatorType >(cells_, qq, this->name() + "_component_" + DSC::toString(qq));
+    return components_[qq];
+  } // ... component(...)
+
+  /**
+   * \brief parameterName[qq] (created upon first access) or the registered coefficient qq - num_cells().
+   */
+  virtual const std::shared_ptr< const ParameterFunctional >& coefficient(const DUNE_STUFF_SSIZE_T qq) const override
+  {
+    check_index(qq);
+    if (size_t(qq) >= num_cells())
+      return BaseType::coefficient(qq - num_cells());
+    std::lock_guard< std::mutex > lock(mutex_);
+    if (!coefficients_[qq])
+      coefficients_[qq] = std::make_shared< ParameterFunctional >(cellsParameterType_,
+                                                                  parameterName_ + "[" + DSC::toString(qq) + "]");
+    return coefficients_[qq];
+  } // ... coefficient(...)
+
+  /**
+   * \brief The closure of cell qq or the support of the registered component qq - num_cells().
+   */
+  virtual SupportType component_support(const DUNE_STUFF_SSIZE_T qq) const override
+  {
+    check_index(qq);
+    if (size_t(qq) >= num_cells())
+      return BaseType::component_support(qq - num_cells());
+    return SupportType(cells_->lower_left(qq), cells_->upper_right(qq));
   }
+
+  /**
+   * \brief Of the cell indicators only the one of the cell containing the center of entity is active.
+   */
+  virtual void active_components(const EntityType& entity, std::vector< size_t >& ret) const override
+  {
+    BaseType::active_components(entity, ret);
+    for (auto& qq : ret)
+      qq += num_cells();
+    ret.insert(ret.begin(), cells_->find(entity.geometry().center()));
+  } // ... active_components(...)
+
+  virtual std::shared_ptr< const NonparametricType > with_mu(const Parameter mu = Parameter()) const override
+  {
+    if (registered())
+      return InterfaceType::with_mu(mu);
+    if (mu.type() != this->parameter_type())
+      DUNE_THROW(Pymor::Exceptions::wrong_parameter_type,
+                 "mu is " << mu.type() << ", should be " << this->parameter_type() << "!");
+    const auto& values = mu.get(parameterName_);
+    std::vector< RangeType > cell_values(values.size());
+    for (size_t ii = 0; ii < values.size(); ++ii)
+      cell_values[ii] = RangeType(values[ii]);
+    return std::make_shared< PiecewiseConstantType >(cells_, std::move(cell_values), this->name());
+  } // ... with_mu(...)
+
+  virtual double gamma(const Parameter& mu_1, const Parameter& mu_2) const override
+  {
+    if (registered())
+      return InterfaceType::gamma(mu_1, mu_2);
+    check_types(mu_1, mu_2);
+    if (mu_1 == mu_2)
+      return 1.0;
+    const auto& values_1 = mu_1.get(parameterName_);
+    const auto& values_2 = mu_2.get(parameterName_);
+    double ret = std::numeric_limits< double >::min();
+    for (size_t qq = 0; qq < values_1.size(); ++qq)
+      ret = std::max(ret, values_1[qq]/values_2[qq]);
+    return ret;
+  } // ... gamma(...)
+
+  virtual double alpha(const Parameter& mu_1, const Parameter& mu_2) const override
+  {
+    if (registered())
+      return InterfaceType::alpha(mu_1, mu_2);
+    check_types(mu_1, mu_2);
+    if (mu_1 == mu_2)
+      return 1.0;
+    const auto& values_1 = mu_1.get(parameterName_);
+    const auto& values_2 = mu_2.get(parameterName_);
+    double ret = std::numeric_limits< double >::max();
+    for (size_t qq = 0; qq < values_1.size(); ++qq)
+      ret = std::min(ret, values_1[qq]/values_2[qq]);
+    return ret;
+  } // ... alpha(...)
+
+  virtual void gamma(const std::vector< Parameter >& mus_1,
+                     const Parameter& mu_2,
+                     std::vector< double >& ret) const override
+  {
+    if (registered())
+      InterfaceType::gamma(mus_1, mu_2, ret);
+    else
+      value_ratio_bounds(mus_1, mu_2, true, ret);
+  }
+
+  virtual void alpha(const std::vector< Parameter >& mus_1,
+                     const Parameter& mu_2,
+                     std::vector< double >& ret) const override
+  {
+    if (registered())
+      InterfaceType::alpha(mus_1, mu_2, ret);
+    else
+      value_ratio_bounds(mus_1, mu_2, false, ret);
+  }
+
+  const CellsType& cells() const
+  {
+    return *cells_;
+  }
+
+private:
+  typedef internal::CheckerboardIndicator
+      < EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols > IndicatorType;
+  typedef PiecewiseConstant
+      < EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols >   PiecewiseConstantType;
+
+  //! whether anything besides the cell indicators was registered, which the shortcuts below do not know about
+  bool registered() const
+  {
+    return BaseType::has_affine_part() || BaseType::num_components() > 0;
+  }
+
+  void check_index(const DUNE_STUFF_SSIZE_T qq) const
+  {
+    if (qq < 0 || qq >= num_components())
+      DUNE_THROW(Stuff::Exceptions::index_out_of_range,
+                 "the condition 0 < " << qq << " < num_components() = " << num_components() << " is not satisfied!");
+  }
+
+  void value_ratio_bounds(const std::vector< Parameter >& mus_1,
+                          const Parameter& mu_2,
+                          const bool maximum,
+                          std::vector< double >& ret) const
+  {
+    for (const auto& mu_1 : mus_1)
+      check_types(mu_1, mu_2);
+    const auto& values_2 = mu_2.get(parameterName_);
+    ret.resize(mus_1.size());
+    for (size_t ii = 0; ii < mus_1.size(); ++ii) {
+      if (mus_1[ii] == mu_2) {
+        ret[ii] = 1.0;
+        continue;
+      }
+      const auto& values_1 = mus_1[ii].get(parameterName_);
+      double bound = maximum ? std::numeric_limits< double >::min() : std::numeric_limits< double >::max();
+      if (maximum)
+        for (size_t qq = 0; qq < values_1.size(); ++qq)
+          bound = std::max(bound, values_1[qq]/values_2[qq]);
+      else
+        for (size_t qq = 0; qq < values_1.size(); ++qq)
+          bound = std::min(bound, values_1[qq]/values_2[qq]);
+      ret[ii] = bound;
+    }
+  } // ... value_ratio_bounds(...)
+
+  void check_types(const Parameter& mu_1, const Parameter& mu_2) const
+  {
+    if (mu_1.type() != this->parameter_type())
+      DUNE_THROW(Exceptions::wrong_parameter_type,
+                 "The type of mu_1 is " << mu_1 << " and should be " << this->parameter_type());
+    if (mu_2.type() != this->parameter_type())
+      DUNE_THROW(Exceptions::wrong_parameter_type,
+                 "The type of mu_2 is " << mu_2 << " and should be " << this->parameter_type());
+  } // ... check_types(...)
+
+  const std::shared_ptr< const CellsType > cells_;
+  const std::string parameterName_;
+  const ParameterType cellsParameterType_;
+  //! guards the lazy creation of components_ and coefficients_
+  mutable std::mutex mutex_;
+  mutable std::vector< std::shared_ptr< const NonparametricType > > components_;
+  mutable std::vector< std::shared_ptr< const ParameterFunctional > > coefficients_;
 }; // class Checkerboard
 
 
@@ -111,6 +111,7 @@ public:
   typedef typename BaseType::RangeType      RangeType;
 
   typedef typename BaseType::JacobianRangeType JacobianRangeType;
+  typedef typename BaseType::SupportType       SupportType;
 
   static const bool available = true;
 
@@ -253,6 +254,7 @@ public:
   {
     components_.emplace_back(comp_ptr);
     coefficients_.emplace_back(coeff_ptr);
+    supports_.emplace_back();
     this->inherit_parameter_type(coeff_ptr->parameter_type(), "coefficient_0");
   }
 
@@ -269,6 +271,7 @@ public:
   {
     components_.emplace_back(comp_ptr);
     coefficients_.push_back(coeff_ptr);
+    supports_.emplace_back();
     this->inherit_parameter_type(coeff_ptr->parameter_type(), "coefficient_0");
   }
 
@@ -285,6 +288,7 @@ public:
   {
     components_.push_back(comp_ptr);
     coefficients_.emplace_back(coeff_ptr);
+    supports_.emplace_back();
     this->inherit_parameter_type(coeff_ptr->parameter_type(), "coefficient_0");
   }
 
@@ -298,6 +302,7 @@ public:
   {
     components_.push_back(comp_ptr);
     coefficients_.push_back(coeff_ptr);
+    supports_.emplace_back();
     this->inherit_parameter_type(coeff_ptr->parameter_type(), "coefficient_0");
   }
 
@@ -357,9 +362,22 @@ public:
     Parametric::inherit_parameter_type(coeff_ptr->parameter_type(), "coefficient_" + Dune::Stuff::Common::toString(num_components_));
     components_.push_back(comp_ptr);
     coefficients_.push_back(coeff_ptr);
+    supports_.emplace_back();
     ++num_components_;
   } // ... register_component(...)
 
+  /**
+   * \brief Restricts the support of component qq (which is the whole domain by default) to support.
+   */
+  void set_component_support(const DUNE_STUFF_SSIZE_T qq, const SupportType& support)
+  {
+    if (qq < 0 || qq >= int(num_components_))
+      DUNE_THROW(Stuff::Exceptions::index_out_of_range,
+                 "the condition 0 < " << qq << " < num_components() = " << num_components_
+                 << " is not satisfied!");
+    supports_[qq] = support;
+  } // ... set_component_support(...)
+
   virtual std::string name() const override
   {
     return name_;
@@ -407,12 +425,30 @@ public:
     return coefficients_[qq];
   }
 
+  virtual SupportType component_support(const DUNE_STUFF_SSIZE_T qq) const override
+  {
+    if (qq < 0 || qq >= int(num_components_))
+      DUNE_THROW(Stuff::Exceptions::index_out_of_range,
+                 "the condition 0 < " << qq << " < num_components() = " << num_components_
+                 << " is not satisfied!");
+    return supports_[qq];
+  }
+
+  virtual void active_components(const EntityType& entity, std::vector< size_t >& ret) const override
+  {
+    ret.clear();
+    for (size_t qq = 0; qq < num_components_; ++qq)
+      if (supports_[qq].everywhere() || supports_[qq].intersects(entity))
+        ret.push_back(qq);
+  } // ... active_components(...)
+
 public:
   std::string name_;
   size_t num_components_;
   bool hasAffinePart_;
   std::vector< std::shared_ptr< const NonparametricType > > components_;
   std::vector< std::shared_ptr< const ParameterFunctional > > coefficients_;
+  std::vector< SupportType > supports_;
   std::shared_ptr< const NonparametricType > affinePart_;
 }; // class AffinelyDecomposableDefault
 
@@ -6,9 +6,12 @@
 #ifndef DUNE_PYMOR_FUNCTIONS_INTERFACES_HH
 #define DUNE_PYMOR_FUNCTIONS_INTERFACES_HH
 
+#include <algorithm>
 #include <memory>
 #include <ostream>
 #include <limits>
+#include <mutex>
+#include <vector>
 
 #include <dune/stuff/common/disable_warnings.hh>
 # include <dune/common/fmatrix.hh>
@@ -21,8 +24,13 @@
 
 #include <dune/pymor/parameters/base.hh>
 #include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/parameters/thetas.hh>
 #include <dune/pymor/common/exceptions.hh>
 
+#include "support.hh"
+#include "batched.hh"
+#include "piecewiseconstant.hh"
+
 namespace Dune {
 namespace Pymor {
 namespace internal {
@@ -32,6 +40,39 @@ template< class ParametricFunctionType >
 class FunctionWithParameter;
 
 
+/**
+ * \brief The ThetaBundle of the coefficients of a function, which is only rebuilt if the coefficients change (copies
+ *        start empty).
+ */
+class ThetaBundleCache
+{
+public:
+  ThetaBundleCache() {}
+
+  ThetaBundleCache(const ThetaBundleCache& /*other*/) {}
+
+  ThetaBundleCache& operator=(const ThetaBundleCache& /*other*/)
+  {
+    return *this;
+  }
+
+  std::shared_ptr< const ThetaBundle > get(const std::vector< ThetaBundle::ThetaType >& coefficients) const
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    if (!bundle_ || coefficients != coefficients_) {
+      bundle_ = std::make_shared< const ThetaBundle >(coefficients);
+      coefficients_ = coefficients;
+    }
+    return bundle_;
+  } // ... get(...)
+
+private:
+  mutable std::mutex mutex_;
+  mutable std::vector< ThetaBundle::ThetaType > coefficients_;
+  mutable std::shared_ptr< const ThetaBundle > bundle_;
+}; // class ThetaBundleCache
+
+
 } // namespace internal
 
 
@@ -60,6 +101,8 @@ public:
 
   typedef typename NonparametricType::JacobianRangeType JacobianRangeType;
 
+  typedef FunctionSupport< EntityType, DomainFieldType, dimDomain > SupportType;
+
   static const bool available = false;
 
   static std::string static_id()
@@ -150,6 +193,29 @@ public:
     return nullptr_2_;
   } // ... coefficient(...)
 
+  /**
+   * \brief A set containing the support of component qq, the whole domain by default.
+   */
+  virtual SupportType component_support(const DUNE_STUFF_SSIZE_T qq) const
+  {
+    if (qq < 0 || qq >= num_components())
+      DUNE_THROW(Stuff::Exceptions::index_out_of_range,
+                 "the condition 0 < " << qq << " < num_components() = " << num_components() << " is not satisfied!");
+    return SupportType();
+  }
+
+  /**
+   * \brief Fills ret with the indices of all components which do not vanish on entity (according to their support).
+   * \note  Implementations which know their supports better than by checking each of them should override this.
+   */
+  virtual void active_components(const EntityType& entity, std::vector< size_t >& ret) const
+  {
+    ret.clear();
+    for (DUNE_STUFF_SSIZE_T qq = 0; qq < num_components(); ++qq)
+      if (component_support(qq).intersects(entity))
+        ret.push_back(qq);
+  } // ... active_components(...)
+
   virtual void report(std::ostream& out, const std::string prefix = "") const
   {
     out << prefix << "affinely decomposable function '" << name() << "' (of type " << type() << "):";
@@ -172,6 +238,9 @@ public:
       if (mu.type() != this->parameter_type())
         DUNE_THROW(Pymor::Exceptions::wrong_parameter_type,
                    "mu is " << mu.type() << ", should be " << this->parameter_type() << "!");
+      const auto collapsed = collapse(mu);
+      if (collapsed)
+        return collapsed;
       return std::make_shared< internal::FunctionWithParameter< ThisType > >(*this, mu);
     } else {
       assert(has_affine_part());
@@ -231,12 +300,103 @@ public:
     }
   } // ... alpha(...)
 
+  /**
+   * \brief Computes ret[ii] = gamma(mus_1[ii], mu_2) for all ii, the coefficients are evaluated for mu_2 only once.
+   */
+  virtual void gamma(const std::vector< Parameter >& mus_1, const Parameter& mu_2, std::vector< double >& ret) const
+  {
+    theta_ratio_bounds(mus_1, mu_2, true, ret);
+  }
+
+  /**
+   * \brief Computes ret[ii] = alpha(mus_1[ii], mu_2) for all ii, the coefficients are evaluated for mu_2 only once.
+   */
+  virtual void alpha(const std::vector< Parameter >& mus_1, const Parameter& mu_2, std::vector< double >& ret) const
+  {
+    theta_ratio_bounds(mus_1, mu_2, false, ret);
+  }
+
 private:
+  /**
+   * \brief The maximum (or minimum) over all qq of theta_qq(mus_1[ii])/theta_qq(mu_2), for each ii (1 if
+   *        mus_1[ii] == mu_2, like gamma(mu_1, mu_2) and alpha(mu_1, mu_2)).
+   */
+  void theta_ratio_bounds(const std::vector< Parameter >& mus_1,
+                          const Parameter& mu_2,
+                          const bool maximum,
+                          std::vector< double >& ret) const
+  {
+    ret.assign(mus_1.size(), 1.0);
+    if (!parametric())
+      return;
+    if (mu_2.type() != this->parameter_type())
+      DUNE_THROW(Exceptions::wrong_parameter_type,
+                 "The type of mu_2 is " << mu_2 << " and should be " << this->parameter_type());
+    for (const auto& mu_1 : mus_1)
+      if (mu_1.type() != this->parameter_type())
+        DUNE_THROW(Exceptions::wrong_parameter_type,
+                   "The type of mu_1 is " << mu_1 << " and should be " << this->parameter_type());
+    assert(num_components() > 0);
+    const size_t num_thetas = num_components();
+    std::vector< ThetaBundle::ThetaType > coefficients(num_thetas);
+    for (size_t qq = 0; qq < num_thetas; ++qq)
+      coefficients[qq] = coefficient(qq);
+    const auto thetas = theta_bundle_.get(coefficients);
+    std::vector< double > thetas_1;
+    std::vector< double > thetas_2;
+    if (thetas->parameter_type() == this->parameter_type()) {
+      thetas->evaluate(mu_2, thetas_2);
+      thetas->evaluate(mus_1, thetas_1);
+    } else {
+      // the coefficients do not depend on all components of the parameter
+      thetas_2.resize(num_thetas);
+      thetas_1.resize(mus_1.size()*num_thetas);
+      for (size_t qq = 0; qq < num_thetas; ++qq) {
+        thetas_2[qq] = coefficients[qq]->evaluate(mu_2);
+        for (size_t ii = 0; ii < mus_1.size(); ++ii)
+          thetas_1[ii*num_thetas + qq] = coefficients[qq]->evaluate(mus_1[ii]);
+      }
+    }
+    for (size_t ii = 0; ii < mus_1.size(); ++ii) {
+      if (mus_1[ii] == mu_2)
+        continue;
+      const double* theta_1 = thetas_1.data() + ii*num_thetas;
+      double bound = maximum ? std::numeric_limits< double >::min() : std::numeric_limits< double >::max();
+      if (maximum)
+        for (size_t qq = 0; qq < num_thetas; ++qq)
+          bound = std::max(bound, theta_1[qq]/thetas_2[qq]);
+      else
+        for (size_t qq = 0; qq < num_thetas; ++qq)
+          bound = std::min(bound, theta_1[qq]/thetas_2[qq]);
+      if (has_affine_part())
+        bound = maximum ? std::max(bound, 1.0) : std::min(bound, 1.0);
+      ret[ii] = bound;
+    }
+  } // ... theta_ratio_bounds(...)
+
+
+  /**
+   * \brief If all parts are piecewise constant on the same checkerboard (or constant), returns their linear
+   *        combination as a single function storing one value per cell, nullptr otherwise.
+   */
+  std::shared_ptr< const NonparametricType > collapse(const Parameter& mu) const
+  {
+    Functions::internal::PiecewiseConstantCollapser
+        < EntityImp, DomainFieldImp, domainDim, RangeFieldImp, rangeDim, rangeDimCols > collapser;
+    if (has_affine_part() && !collapser.add(*affine_part(), 1.0))
+      return nullptr;
+    for (DUNE_STUFF_SSIZE_T qq = 0; qq < num_components(); ++qq)
+      if (!collapser.add(*component(qq), coefficient(qq)->evaluate(mu)))
+        return nullptr;
+    return collapser.result(name());
+  } // ... collapse(...)
+
   template< class T >
   friend std::ostream& operator<<(std::ostream& /*out*/, const ThisType& /*function*/);
 
   const std::shared_ptr< const NonparametricType > nullptr_1_;
   const std::shared_ptr< const ParameterFunctional > nullptr_2_;
+  internal::ThetaBundleCache theta_bundle_;
 }; // class AffinelyDecomposableFunctionInterface
 
 
@@ -272,6 +432,7 @@ class FunctionWithParameter
 
   class LocalFunction
     : public Stuff::LocalfunctionInterface< EE, DD, dd, RR, rr, rC >
+    , public BatchedLocalfunctionInterface< EE, DD, dd, RR, rr, rC >
   {
     typedef Stuff::LocalfunctionInterface< EE, DD, dd, RR, rr, rC > BaseType;
     typedef typename BaseType::DomainType DomainType;
@@ -279,17 +440,26 @@ class FunctionWithParameter
     typedef typename BaseType::JacobianRangeType JacobianRangeType;
 
   public:
+    using BaseType::evaluate;
+    using BaseType::jacobian;
+
+    /**
+     * \brief Only the components which do not vanish on entity are localized and evaluated.
+     */
     LocalFunction(const EE& entity, const ParametricFunctionType& function, const std::vector< double >& coefficients)
       : BaseType(entity)
-      , coefficients_(coefficients)
-      , local_components_(function.num_components(), nullptr)
       , order_(0)
       , tmp_range_(0)
       , tmp_jacobian_range_(0)
     {
-      for (DUNE_STUFF_SSIZE_T qq = 0; qq < function.num_components(); ++qq) {
-        local_components_[qq] = function.component(qq)->local_function(entity);
-        order_ = std::max(order_, local_components_[qq]->order());
+      std::vector< size_t > active;
+      function.active_components(entity, active);
+      local_components_.reserve(active.size());
+      coefficients_.reserve(active.size());
+      for (const size_t& qq : active) {
+        local_components_.emplace_back(function.component(qq)->local_function(entity));
+        coefficients_.push_back(coefficients[qq]);
+        order_ = std::max(order_, local_components_.back()->order());
       }
       if (function.has_affine_part())
         affine_part_.push_back(function.affine_part()->local_function(entity));
@@ -332,12 +502,59 @@ class FunctionWithParameter
       }
     } // ... jacobian(...)
 
+    /**
+     * \brief Evaluates each component at all points (at once, if it supports this) before combining the results.
+     */
+    virtual void evaluate(const std::vector< DomainType >& xx, std::vector< RangeType >& ret) const override
+    {
+      const size_t num_points = xx.size();
+      ret.resize(num_points);
+      std::fill(ret.begin(), ret.end(), RangeType(0));
+      tmp_ranges_.resize(num_points);
+      for (size_t qq = 0; qq < local_components_.size(); ++qq) {
+        Pymor::evaluate(*local_components_[qq], xx, tmp_ranges_);
+        const double coefficient = coefficients_[qq];
+        for (size_t pp = 0; pp < num_points; ++pp) {
+          tmp_ranges_[pp] *= coefficient;
+          ret[pp] += tmp_ranges_[pp];
+        }
+      }
+      if (affine_part_.size() > 0) {
+        Pymor::evaluate(*affine_part_[0], xx, tmp_ranges_);
+        for (size_t pp = 0; pp < num_points; ++pp)
+          ret[pp] += tmp_ranges_[pp];
+      }
+    } // ... evaluate(...)
+
+    virtual void jacobian(const std::vector< DomainType >& xx, std::vector< JacobianRangeType >& ret) const override
+    {
+      const size_t num_points = xx.size();
+      ret.resize(num_points);
+      std::fill(ret.begin(), ret.end(), JacobianRangeType(0));
+      tmp_jacobian_ranges_.resize(num_points);
+      for (size_t qq = 0; qq < local_components_.size(); ++qq) {
+        Pymor::jacobian(*local_components_[qq], xx, tmp_jacobian_ranges_);
+        const double coefficient = coefficients_[qq];
+        for (size_t pp = 0; pp < num_points; ++pp) {
+          tmp_jacobian_ranges_[pp] *= coefficient;
+          ret[pp] += tmp_jacobian_ranges_[pp];
+        }
+      }
+      if (affine_part_.size() > 0) {
+        Pymor::jacobian(*affine_part_[0], xx, tmp_jacobian_ranges_);
+        for (size_t pp = 0; pp < num_points; ++pp)
+          ret[pp] += tmp_jacobian_ranges_[pp];
+      }
+    } // ... jacobian(...)
+
   private:
-    const std::vector< double >& coefficients_;
+    std::vector< double > coefficients_;
     std::vector< std::shared_ptr< BaseType > > local_components_;
     size_t order_;
     mutable RangeType tmp_range_;
     mutable JacobianRangeType tmp_jacobian_range_;
+    mutable std::vector< RangeType > tmp_ranges_;
+    mutable std::vector< JacobianRangeType > tmp_jacobian_ranges_;
     std::vector< std::shared_ptr< BaseType > > affine_part_;
   }; // class LocalFunction
 
@@ -392,6 +609,8 @@ private:
 
 
 } // namespace internal
+
+
 } // namespace Pymor
 } // namespace Dune
 
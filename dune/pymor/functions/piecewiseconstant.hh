@@ -0,0 +1,425 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_FUNCTIONS_PIECEWISECONSTANT_HH
+#define DUNE_PYMOR_FUNCTIONS_PIECEWISECONSTANT_HH
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dune/stuff/functions/interfaces.hh>
+#include <dune/stuff/functions/constant.hh>
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/common/memory.hh>
+#include <dune/stuff/common/fvector.hh>
+
+#include "batched.hh"
+
+namespace Dune {
+namespace Pymor {
+namespace Functions {
+namespace internal {
+
+
+/**
+ * \brief The cells of a checkerboard, numbered like in Stuff::Functions::Checkerboard.
+ */
+template< class DomainFieldType, int dimDomain >
+class CheckerboardCells
+{
+public:
+  typedef Stuff::Common::FieldVector< DomainFieldType, dimDomain > DomainType;
+  typedef Stuff::Common::FieldVector< size_t, dimDomain >          SizeType;
+
+  CheckerboardCells(const DomainType& lowerLeft, const DomainType& upperRight, const SizeType& numElements)
+    : lowerLeft_(lowerLeft)
+    , upperRight_(upperRight)
+    , numElements_(numElements)
+    , size_(1)
+  {
+    for (int dd = 0; dd < dimDomain; ++dd) {
+      if (lowerLeft_[dd] >= upperRight_[dd])
+        DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+                   "lowerLeft[" << dd << "] = " << lowerLeft_[dd] << " has to be smaller than upperRight[" << dd
+                   << "]!");
+      if (numElements_[dd] <= 0)
+        DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+                   "numElements[" << dd << "] has to be positive (is " << numElements_[dd] << ")!");
+      size_ *= numElements_[dd];
+    }
+  } // CheckerboardCells(...)
+
+  const DomainType& lower_left() const
+  {
+    return lowerLeft_;
+  }
+
+  const DomainType& upper_right() const
+  {
+    return upperRight_;
+  }
+
+  const SizeType& num_elements() const
+  {
+    return numElements_;
+  }
+
+  size_t size() const
+  {
+    return size_;
+  }
+
+  /**
+   * \brief Whether other describes the same cells.
+   */
+  bool same_as(const CheckerboardCells& other) const
+  {
+    if (&other == this)
+      return true;
+    for (int dd = 0; dd < dimDomain; ++dd)
+      if (lowerLeft_[dd] != other.lowerLeft_[dd]
+          || upperRight_[dd] != other.upperRight_[dd]
+          || numElements_[dd] != other.numElements_[dd])
+        return false;
+    return true;
+  } // ... same_as(...)
+
+  /**
+   * \brief The lower left corner of cell ii.
+   */
+  DomainType lower_left(size_t ii) const
+  {
+    DomainType ret;
+    for (int dd = 0; dd < dimDomain; ++dd) {
+      const size_t index = ii % numElements_[dd];
+      ii /= numElements_[dd];
+      ret[dd] = lowerLeft_[dd] + index*(upperRight_[dd] - lowerLeft_[dd])/numElements_[dd];
+    }
+    return ret;
+  } // ... lower_left(...)
+
+  DomainType upper_right(size_t ii) const
+  {
+    DomainType ret;
+    for (int dd = 0; dd < dimDomain; ++dd) {
+      const size_t index = ii % numElements_[dd];
+      ii /= numElements_[dd];
+      ret[dd] = lowerLeft_[dd] + (index + 1)*(upperRight_[dd] - lowerLeft_[dd])/numElements_[dd];
+    }
+    return ret;
+  } // ... upper_right(...)
+
+  /**
+   * \brief The index of the cell containing xx (points outside of the checkerboard are mapped to the nearest cell).
+   */
+  template< class PointType >
+  size_t find(const PointType& xx) const
+  {
+    size_t ret = 0;
+    size_t stride = 1;
+    for (int dd = 0; dd < dimDomain; ++dd) {
+      const DomainFieldType relative = (xx[dd] - lowerLeft_[dd])/(upperRight_[dd] - lowerLeft_[dd]);
+      size_t index = relative > 0 ? size_t(std::floor(numElements_[dd]*relative)) : 0;
+      index = std::min(index, numElements_[dd] - 1);
+      ret += index*stride;
+      stride *= numElements_[dd];
+    }
+    return ret;
+  } // ... find(...)
+
+private:
+  const DomainType lowerLeft_;
+  const DomainType upperRight_;
+  const SizeType numElements_;
+  size_t size_;
+}; // class CheckerboardCells
+
+
+/**
+ * \brief A local function with the same value everywhere on its entity, which evaluates a set of points without looking
+ *        at them.
+ */
+template< class E, class D, int d, class R, int r, int rC >
+class ConstantLocalfunction
+  : public Stuff::LocalfunctionInterface< E, D, d, R, r, rC >
+  , public Pymor::internal::BatchedLocalfunctionInterface< E, D, d, R, r, rC >
+{
+  typedef Stuff::LocalfunctionInterface< E, D, d, R, r, rC > BaseType;
+public:
+  typedef typename BaseType::DomainType        DomainType;
+  typedef typename BaseType::RangeType         RangeType;
+  typedef typename BaseType::JacobianRangeType JacobianRangeType;
+
+  ConstantLocalfunction(const E& entity, const RangeType& value)
+    : BaseType(entity)
+    , value_(value)
+  {}
+
+  ConstantLocalfunction(const ConstantLocalfunction& /*other*/) = delete;
+
+  ConstantLocalfunction& operator=(const ConstantLocalfunction& /*other*/) = delete;
+
+  virtual size_t order() const override
+  {
+    return 0;
+  }
+
+  virtual void evaluate(const DomainType& /*xx*/, RangeType& ret) const override
+  {
+    ret = value_;
+  }
+
+  virtual void jacobian(const DomainType& /*xx*/, JacobianRangeType& ret) const override
+  {
+    ret *= 0.0;
+  }
+
+  virtual void evaluate(const std::vector< DomainType >& xx, std::vector< RangeType >& ret) const override
+  {
+    ret.assign(xx.size(), value_);
+  }
+
+  virtual void jacobian(const std::vector< DomainType >& xx, std::vector< JacobianRangeType >& ret) const override
+  {
+    ret.assign(xx.size(), JacobianRangeType(0));
+  }
+
+private:
+  const RangeType value_;
+}; // class ConstantLocalfunction
+
+
+/**
+ * \brief The indicator of a single cell of a checkerboard, which only references the cells.
+ */
+template< class E, class D, int d, class R, int r, int rC >
+class CheckerboardIndicator
+  : public Stuff::LocalizableFunctionInterface< E, D, d, R, r, rC >
+{
+  typedef Stuff::LocalizableFunctionInterface< E, D, d, R, r, rC > BaseType;
+public:
+  typedef typename BaseType::EntityType        EntityType;
+  typedef typename BaseType::RangeType         RangeType;
+  typedef typename BaseType::LocalfunctionType LocalfunctionType;
+  typedef CheckerboardCells< D, d >            CellsType;
+
+  CheckerboardIndicator(const std::shared_ptr< const CellsType > cells, const size_t cell, const std::string nm)
+    : cells_(cells)
+    , cell_(cell)
+    , name_(nm)
+  {}
+
+  virtual std::string type() const override
+  {
+    return "pymor.function.checkerboard.indicator";
+  }
+
+  virtual std::string name() const override
+  {
+    return name_;
+  }
+
+  virtual std::unique_ptr< LocalfunctionType > local_function(const EntityType& entity) const override
+  {
+    const R value = (cells_->find(entity.geometry().center()) == cell_) ? R(1) : R(0);
+    return Stuff::Common::make_unique< ConstantLocalfunction< E, D, d, R, r, rC > >(entity, RangeType(value));
+  }
+
+  const std::shared_ptr< const CellsType >& cells() const
+  {
+    return cells_;
+  }
+
+  size_t cell() const
+  {
+    return cell_;
+  }
+
+private:
+  const std::shared_ptr< const CellsType > cells_;
+  const size_t cell_;
+  const std::string name_;
+}; // class CheckerboardIndicator
+
+
+} // namespace internal
+
+
+/**
+ * \brief A nonparametric function which is constant on each cell of a checkerboard, storing one value per cell.
+ *
+ *        This is what the with_mu() of affinely decomposable functions with piecewise constant parts collapses to, the
+ *        cells are shared with the parametric function.
+ */
+template< class E, class D, int d, class R, int r, int rC = 1 >
+class PiecewiseConstant
+  : public Stuff::LocalizableFunctionInterface< E, D, d, R, r, rC >
+{
+  typedef Stuff::LocalizableFunctionInterface< E, D, d, R, r, rC > BaseType;
+public:
+  typedef typename BaseType::EntityType           EntityType;
+  typedef typename BaseType::RangeType            RangeType;
+  typedef typename BaseType::LocalfunctionType    LocalfunctionType;
+  typedef internal::CheckerboardCells< D, d >     CellsType;
+
+  static std::string static_id()
+  {
+    return "pymor.function.piecewiseconstant";
+  }
+
+  PiecewiseConstant(const std::shared_ptr< const CellsType > cells,
+                    std::vector< RangeType >&& values,
+                    const std::string nm = static_id())
+    : cells_(cells)
+    , values_(std::move(values))
+    , name_(nm)
+  {
+    if (!cells_)
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "cells must not be empty!");
+    if (values_.size() != cells_->size())
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "values has length " << values_.size() << ", there are " << cells_->size() << " cells!");
+  } // PiecewiseConstant(...)
+
+  virtual std::string type() const override
+  {
+    return static_id();
+  }
+
+  virtual std::string name() const override
+  {
+    return name_;
+  }
+
+  virtual std::unique_ptr< LocalfunctionType > local_function(const EntityType& entity) const override
+  {
+    return Stuff::Common::make_unique< internal::ConstantLocalfunction< E, D, d, R, r, rC > >(
+          entity, values_[cells_->find(entity.geometry().center())]);
+  }
+
+  const std::shared_ptr< const CellsType >& cells() const
+  {
+    return cells_;
+  }
+
+  const std::vector< RangeType >& values() const
+  {
+    return values_;
+  }
+
+private:
+  const std::shared_ptr< const CellsType > cells_;
+  const std::vector< RangeType > values_;
+  const std::string name_;
+}; // class PiecewiseConstant
+
+
+namespace internal {
+
+
+/**
+ * \brief Sums up functions which are constant on the cells of a common checkerboard (or constant everywhere) into a
+ *        single PiecewiseConstant (or Stuff::Functions::Constant).
+ *
+ *        Functions are recognized by their type only (PiecewiseConstant, CheckerboardIndicator and
+ *        Stuff::Functions::Constant), an order of 0 does not imply that a function is constant.
+ */
+template< class E, class D, int d, class R, int r, int rC >
+class PiecewiseConstantCollapser
+{
+  typedef Stuff::LocalizableFunctionInterface< E, D, d, R, r, rC > FunctionType;
+  typedef PiecewiseConstant< E, D, d, R, r, rC >                   PiecewiseConstantType;
+  typedef CheckerboardIndicator< E, D, d, R, r, rC >               IndicatorType;
+  typedef Stuff::Functions::Constant< E, D, d, R, r, rC >          ConstantType;
+  typedef CheckerboardCells< D, d >                                CellsType;
+  typedef typename FunctionType::RangeType                         RangeType;
+
+public:
+  PiecewiseConstantCollapser()
+    : constant_(0)
+    , failed_(false)
+  {}
+
+  /**
+   * \brief Adds coefficient*function, returns false if function is not recognized as piecewise constant.
+   */
+  bool add(const FunctionType& function, const double coefficient)
+  {
+    if (failed_)
+      return false;
+    if (const auto* piecewise = dynamic_cast< const PiecewiseConstantType* >(&function)) {
+      if (!use_cells(piecewise->cells()))
+        return fail();
+      const auto& values = piecewise->values();
+      RangeType tmp;
+      for (size_t ii = 0; ii < values.size(); ++ii) {
+        tmp = values[ii];
+        tmp *= coefficient;
+        values_[ii] += tmp;
+      }
+    } else if (const auto* indicator = dynamic_cast< const IndicatorType* >(&function)) {
+      if (!use_cells(indicator->cells()))
+        return fail();
+      values_[indicator->cell()] += RangeType(coefficient);
+    } else if (const auto* constant = dynamic_cast< const ConstantType* >(&function)) {
+      RangeType tmp;
+      constant->evaluate(typename ConstantType::DomainType(0), tmp);
+      tmp *= coefficient;
+      constant_ += tmp;
+    } else
+      return fail();
+    return true;
+  } // ... add(...)
+
+  /**
+   * \brief The sum of all added functions, nullptr if one of them was not recognized.
+   */
+  std::shared_ptr< const FunctionType > result(const std::string nm)
+  {
+    if (failed_)
+      return nullptr;
+    if (!cells_)
+      return std::make_shared< ConstantType >(constant_, nm);
+    for (auto& value : values_)
+      value += constant_;
+    return std::make_shared< PiecewiseConstantType >(cells_, std::move(values_), nm);
+  } // ... result(...)
+
+private:
+  bool use_cells(const std::shared_ptr< const CellsType >& cells)
+  {
+    if (!cells_) {
+      cells_ = cells;
+      values_.assign(cells_->size(), RangeType(0));
+      return true;
+    }
+    return cells_->same_as(*cells);
+  } // ... use_cells(...)
+
+  bool fail()
+  {
+    failed_ = true;
+    cells_ = nullptr;
+    values_.clear();
+    return false;
+  }
+
+  std::shared_ptr< const CellsType > cells_;
+  std::vector< RangeType > values_;
+  RangeType constant_;
+  bool failed_;
+}; // class PiecewiseConstantCollapser
+
+
+} // namespace internal
+} // namespace Functions
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_FUNCTIONS_PIECEWISECONSTANT_HH
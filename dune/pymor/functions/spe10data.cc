@@ -0,0 +1,240 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/common/threading.hh>
+
+#include "spe10data.hh"
+
+namespace Dune {
+namespace Pymor {
+namespace Functions {
+namespace Spe10 {
+namespace {
+
+
+/**
+ * \brief The header of the cache file, the values follow at offset sizeof(CacheHeader).
+ */
+struct CacheHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint64_t source_size;
+  int64_t source_mtime;
+  uint64_t num_values;
+  uint64_t reserved[3];
+}; // struct CacheHeader
+
+static_assert(sizeof(CacheHeader) == 64, "the values have to be aligned!");
+
+const char cache_magic[8] = {'D', 'P', 'Y', 'S', 'P', 'E', '1', '0'};
+const uint32_t cache_version = 1;
+const uint32_t cache_byte_order = 0x01020304;
+
+
+std::mutex registry_mutex;
+std::map< std::string, std::weak_ptr< const Model2Data > > registry;
+
+
+} // namespace
+
+
+const size_t Model2Data::num_elements_x = 60;
+const size_t Model2Data::num_elements_y = 220;
+const size_t Model2Data::num_elements_z = 85;
+const size_t Model2Data::num_cells = 60*220*85;
+
+Model2Data::Model2Data()
+  : data_(nullptr)
+{}
+
+std::shared_ptr< const Model2Data > Model2Data::load(const std::string& filename)
+{
+  return load(filename, filename + ".cache");
+}
+
+std::shared_ptr< const Model2Data > Model2Data::load(const std::string& filename, const std::string& cache_filename)
+{
+  struct stat info;
+  if (::stat(filename.c_str(), &info) != 0)
+    DUNE_THROW(Stuff::Exceptions::external_error,
+               "could not stat '" << filename << "' (" << std::strerror(errno) << ")!");
+  const size_t source_size = info.st_size;
+  const long long source_mtime = info.st_mtime;
+  // the registry key contains the modification time, so changed files are reloaded
+  const std::string key = filename + "@" + std::to_string(source_size) + "@" + std::to_string(source_mtime);
+  std::lock_guard< std::mutex > lock(registry_mutex);
+  auto ret = registry[key].lock();
+  if (ret)
+    return ret;
+  if (!cache_filename.empty())
+    ret = read_cache(cache_filename, source_size, source_mtime);
+  if (!ret) {
+    ret = parse(filename);
+    if (!cache_filename.empty())
+      ret->write_cache(cache_filename, source_size, source_mtime);
+  }
+  registry[key] = ret;
+  return ret;
+} // ... load(...)
+
+const double* Model2Data::permeability(const size_t direction) const
+{
+  if (direction > 2)
+    DUNE_THROW(Stuff::Exceptions::index_out_of_range, "direction has to be 0, 1 or 2 (is " << direction << ")!");
+  return data_ + direction*num_cells;
+}
+
+bool Model2Data::from_cache() const
+{
+  return bool(mapped_);
+}
+
+std::shared_ptr< const Model2Data > Model2Data::read_cache(const std::string& cache_filename,
+                                                           const size_t source_size,
+                                                           const long long source_mtime)
+{
+  if (::access(cache_filename.c_str(), R_OK) != 0)
+    return nullptr;
+  std::unique_ptr< MappedFile > mapped;
+  try {
+    mapped.reset(new MappedFile(cache_filename));
+  } catch (Stuff::Exceptions::external_error&) {
+    return nullptr;
+  } catch (Stuff::Exceptions::wrong_input_given&) {
+    return nullptr;
+  }
+  if (mapped->size() != sizeof(CacheHeader) + 3*num_cells*sizeof(double))
+    return nullptr;
+  CacheHeader header;
+  std::memcpy(&header, mapped->data(), sizeof(CacheHeader));
+  if (std::memcmp(header.magic, cache_magic, sizeof(cache_magic)) != 0
+      || header.version != cache_version
+      || header.byte_order != cache_byte_order
+      || header.source_size != source_size
+      || header.source_mtime != source_mtime
+      || header.num_values != 3*num_cells)
+    return nullptr;
+  std::shared_ptr< Model2Data > ret(new Model2Data());
+  ret->data_ = reinterpret_cast< const double* >(mapped->data() + sizeof(CacheHeader));
+  ret->mapped_ = std::move(mapped);
+  return ret;
+} // ... read_cache(...)
+
+std::shared_ptr< const Model2Data > Model2Data::parse(const std::string& filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  if (!file)
+    DUNE_THROW(Stuff::Exceptions::external_error, "could not open '" << filename << "' for reading!");
+  file.seekg(0, std::ios::end);
+  std::string text(size_t(file.tellg()), '\0');
+  file.seekg(0, std::ios::beg);
+  file.read(&text[0], text.size());
+  if (!file)
+    DUNE_THROW(Stuff::Exceptions::external_error, "could not read '" << filename << "'!");
+  // split the text into chunks which begin at the beginning of a number
+  const size_t num_chunks = default_num_threads();
+  std::vector< size_t > chunk_begin(num_chunks + 1, text.size());
+  for (size_t cc = 0; cc < num_chunks; ++cc) {
+    size_t pos = (cc*text.size())/num_chunks;
+    while (pos > 0 && pos < text.size() && !std::isspace(static_cast< unsigned char >(text[pos - 1])))
+      ++pos;
+    chunk_begin[cc] = pos;
+  }
+  // count the numbers of each chunk, to know where to put them
+  std::vector< size_t > chunk_offset(num_chunks + 1, 0);
+  parallel_for(0, num_chunks, [&](const size_t first, const size_t last) {
+    for (size_t cc = first; cc < last; ++cc) {
+      size_t count = 0;
+      bool in_number = false;
+      for (size_t pos = chunk_begin[cc]; pos < chunk_begin[cc + 1]; ++pos) {
+        const bool space = std::isspace(static_cast< unsigned char >(text[pos]));
+        if (!space && !in_number)
+          ++count;
+        in_number = !space;
+      }
+      chunk_offset[cc + 1] = count;
+    }
+  }, num_chunks);
+  for (size_t cc = 0; cc < num_chunks; ++cc)
+    chunk_offset[cc + 1] += chunk_offset[cc];
+  if (chunk_offset[num_chunks] != 3*num_cells)
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+               "'" << filename << "' contains " << chunk_offset[num_chunks] << " values, should be " << 3*num_cells
+               << "!");
+  std::shared_ptr< Model2Data > ret(new Model2Data());
+  ret->values_.resize(3*num_cells);
+  double* values = ret->values_.data();
+  parallel_for(0, num_chunks, [&](const size_t first, const size_t last) {
+    for (size_t cc = first; cc < last; ++cc) {
+      const char* pos = text.data() + chunk_begin[cc];
+      for (size_t ii = chunk_offset[cc]; ii < chunk_offset[cc + 1]; ++ii) {
+        char* number_end = nullptr;
+        values[ii] = std::strtod(pos, &number_end);
+        if (number_end == pos || (*number_end != '\0' && !std::isspace(static_cast< unsigned char >(*number_end))))
+          DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+                     "'" << filename << "' contains something which is not a number at value " << ii << "!");
+        pos = number_end;
+      }
+    }
+  }, num_chunks);
+  ret->data_ = ret->values_.data();
+  return ret;
+} // ... parse(...)
+
+void Model2Data::write_cache(const std::string& cache_filename,
+                             const size_t source_size,
+                             const long long source_mtime) const
+{
+  CacheHeader header;
+  std::memset(&header, 0, sizeof(CacheHeader));
+  std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+  header.version = cache_version;
+  header.byte_order = cache_byte_order;
+  header.source_size = source_size;
+  header.source_mtime = source_mtime;
+  header.num_values = 3*num_cells;
+  // write to a temporary file first, so that concurrent loads never see a partial cache, and do not fail if the cache
+  // cannot be written (e.g. in a read only directory), it is only an optimization
+  const std::string tmp_filename = cache_filename + ".tmp." + std::to_string(::getpid());
+  {
+    std::ofstream file(tmp_filename, std::ios::binary);
+    if (!file)
+      return;
+    file.write(reinterpret_cast< const char* >(&header), sizeof(CacheHeader));
+    file.write(reinterpret_cast< const char* >(data_), 3*num_cells*sizeof(double));
+    if (!file) {
+      file.close();
+      std::remove(tmp_filename.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp_filename.c_str(), cache_filename.c_str()) != 0)
+    std::remove(tmp_filename.c_str());
+} // ... write_cache(...)
+
+
+} // namespace Spe10
+} // namespace Functions
+} // namespace Pymor
+} // namespace Dune
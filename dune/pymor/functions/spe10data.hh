@@ -0,0 +1,84 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_FUNCTIONS_SPE10DATA_HH
+#define DUNE_PYMOR_FUNCTIONS_SPE10DATA_HH
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <dune/pymor/common/mmap.hh>
+
+namespace Dune {
+namespace Pymor {
+namespace Functions {
+namespace Spe10 {
+
+
+/**
+ * \brief The raw permeabilities of the SPE10 model 2 (as given in spe_perm.dat: all values in x direction, followed by
+ *        all values in y and z direction, the x index running fastest within each block).
+ *
+ *        The ASCII file is parsed in parallel and the result is written to a binary cache file next to it (or to
+ *        cache_filename), which is mapped into memory on subsequent loads. The cache is rebuilt if the size or the
+ *        modification time of the ASCII file changed. Within a process, all loads of the same file share the data as
+ *        long as one of them is alive.
+ */
+class Model2Data
+{
+public:
+  static const size_t num_elements_x;
+  static const size_t num_elements_y;
+  static const size_t num_elements_z;
+  static const size_t num_cells;
+
+  /**
+   * \brief Loads filename, using filename + ".cache" as cache.
+   */
+  static std::shared_ptr< const Model2Data > load(const std::string& filename);
+
+  /**
+   * \brief Loads filename, using cache_filename as cache (an empty cache_filename disables the cache).
+   */
+  static std::shared_ptr< const Model2Data > load(const std::string& filename, const std::string& cache_filename);
+
+  Model2Data(const Model2Data& other) = delete;
+
+  Model2Data& operator=(const Model2Data& other) = delete;
+
+  /**
+   * \brief The num_cells permeabilities in direction (0, 1 or 2).
+   */
+  const double* permeability(const size_t direction) const;
+
+  /**
+   * \brief Whether the data was read from the binary cache.
+   */
+  bool from_cache() const;
+
+private:
+  Model2Data();
+
+  static std::shared_ptr< const Model2Data > read_cache(const std::string& cache_filename,
+                                                        const size_t source_size,
+                                                        const long long source_mtime);
+
+  static std::shared_ptr< const Model2Data > parse(const std::string& filename);
+
+  void write_cache(const std::string& cache_filename, const size_t source_size, const long long source_mtime) const;
+
+  std::vector< double > values_;
+  std::unique_ptr< MappedFile > mapped_;
+  const double* data_;
+}; // class Model2Data
+
+
+} // namespace Spe10
+} // namespace Functions
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_FUNCTIONS_SPE10DATA_HH
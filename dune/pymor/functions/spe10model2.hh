@@ -6,11 +6,17 @@
 #ifndef DUNE_PYMOR_FUNCTIONS_SPE10MODEL2_HH
 #define DUNE_PYMOR_FUNCTIONS_SPE10MODEL2_HH
 
+#include <memory>
+#include <vector>
+
 #include <dune/stuff/common/fvector.hh>
-#include <dune/stuff/playground/functions/indicator.hh>
 #include <dune/stuff/functions/spe10model2.hh>
 
+#include <dune/pymor/common/threading.hh>
+
 #include "default.hh"
+#include "piecewiseconstant.hh"
+#include "spe10data.hh"
 
 
 namespace Dune {
@@ -28,6 +34,14 @@ class Model2
 };
 
 
+/**
+ * \brief The permeability of the SPE10 model 2, with an optional parametric blockade in the middle of the y range.
+ *
+ *        The data is loaded by Model2Data (and thus cached), the raw values are mapped linearly from [0.001, 20000] to
+ *        [min, max] (only the x values are used if anisotropic is false). Affine part and component are stored as one
+ *        tensor per SPE10 cell, so with_mu() collapses to a single PiecewiseConstant. A cell belongs to the blockade if
+ *        its center does.
+ */
 template< class E, class D, class R >
 class Model2< E, D, 3, R, 3, 3 >
   : public AffinelyDecomposableDefault< E, D, 3, R, 3, 3 >
@@ -38,8 +52,11 @@ class Model2< E, D, 3, R, 3, 3 >
   typedef AffinelyDecomposableDefault< E, D, d, R, r, rC > BaseType;
   typedef Model2< E, D, d, R, r, rC >                      ThisType;
   typedef Stuff::Functions::Spe10::Model2< E, D, d, R, r, rC > Spe10FunctionType;
+  typedef PiecewiseConstant< E, D, d, R, r, rC >               PiecewiseConstantType;
+  typedef typename PiecewiseConstantType::CellsType            CellsType;
 public:
   using typename BaseType::DomainType;
+  using typename BaseType::RangeType;
 
   static const bool available = true;
 
@@ -95,42 +112,59 @@ public:
          const R& max = default_config().template get< R >("max"))
     : BaseType(nm)
   {
-    typedef Stuff::Functions::Constant<E, D, 3, R, 1>     ScalarConstantFunctionType;
-    typedef Stuff::Functions::DomainIndicator<E, D, 3, R, 1>    ScalarIndicatorFunctionType;
-    typedef Stuff::Functions::DomainIndicator<E, D, 3, R, 3, 3> TensorIndicatorFunctionType;
-
-    auto spe10 = std::make_shared<Spe10FunctionType>(filename, "spe10", lower_left, upper_right, anisotropic, min, max);
-
-    if (blockade_width > 0) {
-      auto one = std::make_shared<ScalarConstantFunctionType>(1, "one");
-      auto blockade = std::shared_ptr<ScalarIndicatorFunctionType>(new ScalarIndicatorFunctionType(
-          {{{{lower_left[0],
-                lower_left[1] + (upper_right[1] - lower_left[1])/2. - blockade_width/2.,
-                  lower_left[2]},
-             {upper_right[0],
-                lower_left[1] + (upper_right[1] - lower_left[1])/2. + blockade_width/2.,
-                  upper_right[2]}},
-            1.}}));
-      typename TensorIndicatorFunctionType::RangeType blockade_scaled_value(0.);
-      blockade_scaled_value[0][0] = blockade_scaled_value[1][1] = blockade_scaled_value[2][2] = blockade_value;
-      auto blockade_scaled = std::shared_ptr<TensorIndicatorFunctionType>(new TensorIndicatorFunctionType(
-          {{{{lower_left[0],
-                lower_left[1] + (upper_right[1] - lower_left[1])/2. - blockade_width/2.,
-                  lower_left[2]},
-             {upper_right[0],
-                lower_left[1] + (upper_right[1] - lower_left[1])/2. + blockade_width/2.,
-                  upper_right[2]}},
-            blockade_scaled_value}}));
-      auto blockade_remover = Stuff::Functions::make_difference(one, blockade, "blockade_remover");
-      auto spe10_wo_blockade = Stuff::Functions::make_product(blockade_remover, spe10, "spe10_wo_blockade");
-      auto spe10_w_scaled_blockade = Stuff::Functions::make_sum(spe10_wo_blockade,
-                                                                 blockade_scaled,
-                                                                 "spe10_w_scaled_blockade");
-      this->register_affine_part(spe10_w_scaled_blockade);
-      this->register_component(Stuff::Functions::make_difference(spe10, spe10_w_scaled_blockade, "component"),
+    const auto data = Model2Data::load(filename);
+    const auto cells = std::make_shared< const CellsType >(lower_left,
+                                                           upper_right,
+                                                           typename CellsType::SizeType({Model2Data::num_elements_x,
+                                                                                         Model2Data::num_elements_y,
+                                                                                         Model2Data::num_elements_z}));
+    const R raw_min = 0.001;
+    const R raw_max = 20000;
+    const R scale = (max - min)/(raw_max - raw_min);
+    const R shift = min - scale*raw_min;
+    const D blockade_lower = lower_left[1] + (upper_right[1] - lower_left[1])/2. - blockade_width/2.;
+    const D blockade_upper = lower_left[1] + (upper_right[1] - lower_left[1])/2. + blockade_width/2.;
+    const D cell_height = (upper_right[1] - lower_left[1])/Model2Data::num_elements_y;
+    const bool has_blockade = blockade_width > 0;
+    std::vector< RangeType > affine_values(cells->size());
+    std::vector< RangeType > component_values(has_blockade ? cells->size() : 0);
+    parallel_for(0, cells->size(), [&](const size_t first, const size_t last) {
+      for (size_t ii = first; ii < last; ++ii) {
+        RangeType value(0.);
+        for (size_t dd = 0; dd < d; ++dd)
+          value[dd][dd] = scale*data->permeability(anisotropic ? dd : 0)[ii] + shift;
+        if (has_blockade) {
+          const size_t yy = (ii/Model2Data::num_elements_x) % Model2Data::num_elements_y;
+          const D center = lower_left[1] + (yy + 0.5)*cell_height;
+          if (center >= blockade_lower && center <= blockade_upper) {
+            RangeType blockade(0.);
+            blockade[0][0] = blockade[1][1] = blockade[2][2] = blockade_value;
+            affine_values[ii] = blockade;
+            value -= blockade;
+            component_values[ii] = value;
+          } else {
+            affine_values[ii] = value;
+            component_values[ii] = RangeType(0.);
+          }
+        } else
+          affine_values[ii] = value;
+      }
+    });
+    if (has_blockade) {
+      this->register_affine_part(std::make_shared< PiecewiseConstantType >(cells,
+                                                                           std::move(affine_values),
+                                                                           "spe10_w_scaled_blockade"));
+      this->register_component(std::make_shared< PiecewiseConstantType >(cells,
+                                                                         std::move(component_values),
+                                                                         "component"),
                                new Pymor::ParameterFunctional("blockade", 1, "blockade[0]"));
+      // the component only differs from zero within the blockade
+      this->set_component_support(0,
+                                  typename BaseType::SupportType(
+                                    {lower_left[0], blockade_lower, lower_left[2]},
+                                    {upper_right[0], blockade_upper, upper_right[2]}));
     } else {
-      this->register_affine_part(spe10);
+      this->register_affine_part(std::make_shared< PiecewiseConstantType >(cells, std::move(affine_values), "spe10"));
     }
   } // Model2(...)
 
@@ -0,0 +1,123 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_FUNCTIONS_SUPPORT_HH
+#define DUNE_PYMOR_FUNCTIONS_SUPPORT_HH
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/common/fvector.hh>
+
+namespace Dune {
+namespace Pymor {
+
+
+/**
+ * \brief Describes a set containing the support of a function, which is either the whole domain, an axis aligned
+ *        bounding box or a set of elements (identified by an index, usually obtained from the index set of a grid
+ *        view).
+ *
+ *        The support may be overestimated, i.e. intersects() returning true does not mean that the function is nonzero
+ *        on the entity. But intersects() returning false guarantees that the function vanishes on the (closure of the)
+ *        entity.
+ */
+template< class EntityImp, class DomainFieldImp, int domainDim >
+class FunctionSupport
+{
+public:
+  typedef EntityImp                                                  EntityType;
+  typedef DomainFieldImp                                             DomainFieldType;
+  static const int                                                   dimDomain = domainDim;
+  typedef Stuff::Common::FieldVector< DomainFieldType, dimDomain >   DomainType;
+  typedef std::function< size_t(const EntityType&) >                 IndexMapperType;
+
+  /**
+   * \brief The whole domain.
+   */
+  FunctionSupport()
+    : kind_(Kind::everywhere)
+  {}
+
+  /**
+   * \brief The box [lowerLeft, upperRight].
+   */
+  FunctionSupport(const DomainType& lowerLeft, const DomainType& upperRight)
+    : kind_(Kind::box)
+    , lowerLeft_(lowerLeft)
+    , upperRight_(upperRight)
+  {
+    for (int dd = 0; dd < dimDomain; ++dd)
+      if (lowerLeft_[dd] > upperRight_[dd])
+        DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+                   "lowerLeft[" << dd << "] = " << lowerLeft_[dd] << " must not be larger than upperRight[" << dd
+                   << "] = " << upperRight_[dd] << "!");
+  } // FunctionSupport(...)
+
+  /**
+   * \brief All elements e for which (*elements)[index_mapper(e)] is true.
+   */
+  FunctionSupport(const std::shared_ptr< const std::vector< bool > > elements, const IndexMapperType index_mapper)
+    : kind_(Kind::elements)
+    , elements_(elements)
+    , index_mapper_(index_mapper)
+  {
+    if (!elements_)
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "elements must not be empty!");
+  }
+
+  bool everywhere() const
+  {
+    return kind_ == Kind::everywhere;
+  }
+
+  bool intersects(const EntityType& entity) const
+  {
+    switch (kind_) {
+      case Kind::everywhere:
+        return true;
+      case Kind::box: {
+        const auto& geometry = entity.geometry();
+        DomainType lower(std::numeric_limits< DomainFieldType >::max());
+        DomainType upper(std::numeric_limits< DomainFieldType >::lowest());
+        for (int cc = 0; cc < geometry.corners(); ++cc) {
+          const auto corner = geometry.corner(cc);
+          for (int dd = 0; dd < dimDomain; ++dd) {
+            lower[dd] = std::min(lower[dd], DomainFieldType(corner[dd]));
+            upper[dd] = std::max(upper[dd], DomainFieldType(corner[dd]));
+          }
+        }
+        for (int dd = 0; dd < dimDomain; ++dd)
+          if (upper[dd] < lowerLeft_[dd] || lower[dd] > upperRight_[dd])
+            return false;
+        return true;
+      }
+      case Kind::elements: {
+        const size_t index = index_mapper_(entity);
+        return index < elements_->size() && (*elements_)[index];
+      }
+    }
+    return true;
+  } // ... intersects(...)
+
+private:
+  enum class Kind { everywhere, box, elements };
+
+  Kind kind_;
+  DomainType lowerLeft_;
+  DomainType upperRight_;
+  std::shared_ptr< const std::vector< bool > > elements_;
+  IndexMapperType index_mapper_;
+}; // class FunctionSupport
+
+
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_FUNCTIONS_SUPPORT_HH
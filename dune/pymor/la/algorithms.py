@@ -0,0 +1,93 @@
+#! /usr/bin/env python
+# This file is part of the dune-pymor project:
+#   https://github.com/pymor/dune-pymor
+# Copyright Holders: Stephan Rave, Felix Schindler
+# License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+import pybindgen
+from pybindgen import retval, param
+
+
+def inject_gram_schmidt(module, exceptions, CONFIG_H, vector, product=None):
+    assert(isinstance(module, pybindgen.module.Module))
+    assert(isinstance(exceptions, list))
+    assert(isinstance(CONFIG_H, dict))
+    assert(len(vector.strip()) > 0)
+    namespace = module.add_cpp_namespace('Dune').add_cpp_namespace('Pymor').add_cpp_namespace('LA')
+    vectors = 'std::vector< ' + vector + ' >'
+    if product is None:
+        namespace.add_function('gram_schmidt',
+                               retval(vectors),
+                               [param('const ' + vectors + '&', 'basis'),
+                                param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'offset', default_value='0'),
+                                param('double', 'atol', default_value='1e-13'),
+                                param('double', 'rtol', default_value='1e-13')],
+                               template_parameters=[vector],
+                               custom_name='gram_schmidt',
+                               throw=exceptions, unblock_threads=True)
+    else:
+        assert(len(product.strip()) > 0)
+        namespace.add_function('gram_schmidt',
+                               retval(vectors),
+                               [param('const ' + vectors + '&', 'basis'),
+                                param('const ' + product + '&', 'product'),
+                                param('const Dune::Pymor::Parameter', 'mu'),
+                                param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'offset', default_value='0'),
+                                param('double', 'atol', default_value='1e-13'),
+                                param('double', 'rtol', default_value='1e-13')],
+                               template_parameters=[vector, product + '::Traits'],
+                               custom_name='gram_schmidt',
+                               throw=exceptions, unblock_threads=True)
+    return module
+
+
+def inject_pod(module, exceptions, CONFIG_H, vector, product=None, name=None):
+    '''
+    Injects the pod free function (with respect to the euclidean product if product is None) and, if name is given,
+    the Pod class (for the streaming variant) as name.
+    '''
+    assert(isinstance(module, pybindgen.module.Module))
+    assert(isinstance(exceptions, list))
+    assert(isinstance(CONFIG_H, dict))
+    assert(len(vector.strip()) > 0)
+    namespace = module.add_cpp_namespace('Dune').add_cpp_namespace('Pymor').add_cpp_namespace('LA')
+    vectors = 'std::vector< ' + vector + ' >'
+    if product is None:
+        namespace.add_function('pod',
+                               retval(vectors),
+                               [param('const ' + vectors + '&', 'snapshots'),
+                                param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'max_modes', default_value='0'),
+                                param('double', 'rtol', default_value='4e-8'),
+                                param('double', 'atol', default_value='0.0')],
+                               template_parameters=[vector],
+                               custom_name='pod',
+                               throw=exceptions, unblock_threads=True)
+    else:
+        assert(len(product.strip()) > 0)
+        namespace.add_function('pod',
+                               retval(vectors),
+                               [param('const ' + vectors + '&', 'snapshots'),
+                                param('const ' + product + '&', 'product'),
+                                param('const Dune::Pymor::Parameter', 'mu'),
+                                param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'max_modes', default_value='0'),
+                                param('double', 'rtol', default_value='4e-8'),
+                                param('double', 'atol', default_value='0.0')],
+                               template_parameters=[vector, product + '::Traits'],
+                               custom_name='pod',
+                               throw=exceptions, unblock_threads=True)
+    if name is not None:
+        assert(len(name.strip()) > 0)
+        Pod = namespace.add_class('Pod', template_parameters=[vector], custom_name=name)
+        Pod.add_constructor([param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'max_modes', default_value='0'),
+                             param('double', 'rtol', default_value='4e-8'),
+                             param('double', 'atol', default_value='0.0'),
+                             param('bool', 'orthonormalize', default_value='true')],
+                            throw=exceptions)
+        Pod.add_method('compute', None, [param('const ' + vectors + '&', 'snapshots')], is_const=False,
+                       throw=exceptions, unblock_threads=True)
+        Pod.add_method('extend', None, [param('const ' + vectors + '&', 'snapshots')], is_const=False,
+                       throw=exceptions, unblock_threads=True)
+        Pod.add_method('modes', retval(vectors), [], is_const=True, throw=exceptions)
+        Pod.add_method('singular_values', retval('std::vector< double >'), [], is_const=True, throw=exceptions)
+        Pod.add_method('num_snapshots', retval(CONFIG_H['DUNE_STUFF_SSIZE_T']), [], is_const=True, throw=exceptions)
+    return module
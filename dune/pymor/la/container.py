@@ -4,6 +4,10 @@
 # Copyright Holders: Stephan Rave, Felix Schindler
 # License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
 
+import os
+import tempfile
+import threading
+
 import pybindgen
 from pybindgen import retval, param
 import numpy as np
@@ -12,6 +16,9 @@ from pymor.core.defaults import defaults
 from pymor.core.interfaces import UberMeta
 from pymor.vectorarrays.list import VectorInterface, ListVectorArray
 
+from dune.pymor.core.buffer import MutableDoubleBuffer
+from dune.pymor.common.threading import inject_AsyncResult
+
 
 def make_listvectorarray(vec, count=1):
     if isinstance(vec, (list, tuple)):
@@ -40,7 +47,7 @@ class BufferReturn(pybindgen.ReturnValue):
 
 
 def inject_VectorImplementation(module, exceptions, interfaces, CONFIG_H, name, Traits, template_parameters=None,
-                                provides_data=False):
+                                provides_data=False, maps_data=False):
     assert(isinstance(module, pybindgen.module.Module))
     assert(isinstance(exceptions, list))
     assert(isinstance(interfaces, dict))
@@ -78,19 +85,22 @@ def inject_VectorImplementation(module, exceptions, interfaces, CONFIG_H, name,
     Class.add_constructor([param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'size')])
     Class.add_constructor([param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'size'), param(ScalarType, 'value')])
     Class.add_copy_constructor()
+    if maps_data:
+        # the vector refers to the memory of the given buffer, which has to outlive it (see SharedVectorStorage)
+        Class.add_constructor([param(MutableDoubleBuffer, 'data')], throw=exceptions)
     # what we want from ContainerInterface
     Class.add_method('type_this', retval('std::string'), [], is_const=True, is_static=True,
             throw=exceptions)
-    Class.add_method('copy', retval(ThisType), [], is_const=True, throw=exceptions)
+    Class.add_method('copy', retval(ThisType), [], is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('scal',
                      None,
                      [param('const ' + ScalarType + ' &', 'alpha')],
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('axpy',
                      None,
                      [param('const ' + ScalarType + ' &', 'alpha'),
                       param('const ' + ThisType + ' &', 'xx')],
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('has_equal_shape',
                      'bool',
                      [param('const ' + ThisType + ' &', 'other')],
@@ -107,49 +117,49 @@ def inject_VectorImplementation(module, exceptions, interfaces, CONFIG_H, name,
                      retval('bool'),
                      [param('const ' + ThisType + ' &', 'other'),
                       param('const ' + ScalarType, 'epsilon')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('almost_equal',
                      retval('bool'),
                      [param('const ' + ThisType + ' &', 'other')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('dot',
                      retval(ScalarType),
                      [param('const ' + ThisType + ' &', 'other')],
                      is_const=True,
-                     throw=exceptions)
-    Class.add_method('l1_norm', retval(ScalarType), [], is_const=True, throw=exceptions)
-    Class.add_method('l2_norm', retval(ScalarType), [], is_const=True, throw=exceptions)
-    Class.add_method('sup_norm', retval(ScalarType), [], is_const=True, throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
+    Class.add_method('l1_norm', retval(ScalarType), [], is_const=True, throw=exceptions, unblock_threads=True)
+    Class.add_method('l2_norm', retval(ScalarType), [], is_const=True, throw=exceptions, unblock_threads=True)
+    Class.add_method('sup_norm', retval(ScalarType), [], is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('add',
                      None,
                      [param('const ' + ThisType + ' &', 'other'),
                       param(ThisType + ' &', 'result')],
                      is_const=True,
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('add',
                      retval(ThisType),
                      [param('const ' + ThisType + ' &', 'other')],
                      is_const=True,
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('iadd',
                      None,
                      [param('const ' + ThisType + ' &', 'other')],
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('sub',
                      None,
                      [param('const ' + ThisType + ' &', 'other'),
                       param(ThisType + ' &', 'result')],
                      is_const=True,
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('sub',
                      retval(ThisType),
                      [param('const ' + ThisType + ' &', 'other')],
                      is_const=True,
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('isub',
                      None,
                      [param('const ' + ThisType + ' &', 'other')],
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('pb_dim',
                      retval(CONFIG_H['DUNE_STUFF_SSIZE_T']),
                      [],
@@ -178,29 +188,29 @@ def inject_VectorImplementation(module, exceptions, interfaces, CONFIG_H, name,
                      retval('std::vector< ' + ScalarType + ' >'),
                      [],
                      is_const=True,
-                     throw=exceptions,
+                     throw=exceptions, unblock_threads=True,
                      custom_name='amax')
     Class.add_method('max',
                      retval(ScalarType),
                      [],
                      is_const=True,
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('min',
                      retval(ScalarType),
                      [],
                      is_const=True,
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('mean',
                      retval(ScalarType),
                      [],
                      is_const=True,
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('components',
                      retval('std::vector< ' + ScalarType + ' >'),
                      [param('const std::vector< ' + CONFIG_H['DUNE_STUFF_SSIZE_T'] + '> &', 'component_indices')],
                      is_const=True,
                      throw=exceptions)
-
+    inject_AsyncResult(module, exceptions, CONFIG_H, ThisType)
 
     return module, Class
 
@@ -247,16 +257,16 @@ def inject_MatrixImplementation(module, exceptions, interfaces, CONFIG_H, name,
                      retval(ThisType),
                      [],
                      is_const=True,
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('scal',
                      None,
                      [param('const ' + ScalarType + ' &', 'alpha')],
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('axpy',
                      None,
                      [param('const ' + ScalarType + ' &', 'alpha'),
                       param('const ' + ThisType + ' &', 'xx')],
-                     throw=exceptions)
+                     throw=exceptions, unblock_threads=True)
     Class.add_method('has_equal_shape',
                      retval('bool'),
                      [param('const ' + ThisType + ' &', 'other')],
@@ -321,7 +331,7 @@ def inject_MatrixImplementation(module, exceptions, interfaces, CONFIG_H, name,
                              None, [param('const ' + VectorType + '&', 'xx'),
                                     param(VectorType + '&', 'yy')],
                              is_const=True,
-                             throw=exceptions)
+                             throw=exceptions, unblock_threads=True)
     return module, Class
 
 
@@ -329,21 +339,88 @@ class WrappedMeta(UberMeta):
     pass
 
 
+# where new shared memory segments are created, on Linux this is where POSIX shared memory lives
+shared_memory_dir = '/dev/shm'
+
+
+class SharedVectorStorage(object):
+    """The entries of a vector in a file mapped into memory, e.g. a POSIX shared memory segment.
+
+    Vectors backed by a SharedVectorStorage are pickled by their file, dimension and offset only, so worker processes
+    map the same memory instead of receiving a copy of it. The mapping is shared, writes are seen by all processes. The
+    file of a segment created by `create` is removed once the creating process drops it, so the vectors have to be kept
+    alive until all workers have unpickled them.
+    """
+
+    def __init__(self, path, dim, offset=0, owner=False):
+        assert dim > 0
+        self.path = path
+        self.dim = dim
+        self.offset = offset
+        self.owner = owner
+        self.owner_pid = os.getpid()
+        self.array = np.memmap(path, dtype=np.float64, mode='r+', offset=offset, shape=(dim,))
+
+    @classmethod
+    def create(cls, dim):
+        fd, path = tempfile.mkstemp(prefix='dune_pymor_', dir=shared_memory_dir)
+        try:
+            os.ftruncate(fd, dim * np.dtype(np.float64).itemsize)
+        finally:
+            os.close(fd)
+        return cls(path, dim, owner=True)
+
+    def __del__(self):
+        # forked children inherit the storage but do not own the segment
+        if self.owner and self.owner_pid == os.getpid():
+            try:
+                os.unlink(self.path)
+            except OSError:
+                pass
+
+
 def wrap_vector(cls):
 
+    # each vector type is wrapped once, no matter if first requested by a (lazily) wrapped module, by unpickling or
+    # by several threads at once
+    with wrapped_vectors_lock:
+        if cls not in wrapped_vectors:
+            wrapped_vectors[cls] = _wrap_vector(cls)
+        return wrapped_vectors[cls]
+
+
+def _wrap_vector(cls):
+
     class WrappedVector(VectorInterface):
 
         __metaclass__ = WrappedMeta
 
         wrapped_type = cls
 
+        _shared = None
+
         @property
         def data(self):
+            if self._shared is not None:
+                return self._shared.array
             return np.frombuffer(self._impl.data(), dtype=np.float64)
 
         def __init__(self, v):
             self._impl = v
 
+        @classmethod
+        def from_shared_storage(cls, storage):
+            """Wraps the memory of storage, requires a vector type which maps its data (EigenMappedDenseVector)."""
+            assert isinstance(storage, SharedVectorStorage)
+            vector = cls(cls.wrapped_type(storage.array))
+            vector._shared = storage
+            return vector
+
+        @classmethod
+        def make_shared(cls, dim):
+            """Creates a zero vector in a new shared memory segment, see SharedVectorStorage."""
+            return cls.from_shared_storage(SharedVectorStorage.create(dim))
+
         @classmethod
         def make_array(cls, subtype=None, count=0, reserve=0):
             assert count > 0
@@ -354,13 +431,6 @@ def wrap_vector(cls):
         def make_zeros(cls, subtype):
             return cls(cls.wrapped_type(subtype))
 
-        def __getstate__(self):
-            return (self.dim, self.data)
-
-        def __setstate__(self, state):
-            self._impl = self.wrapped_type(state[0])
-            self.data[:] = state[1]
-
         @property
         def subtype(self):
             return self._impl.dim()
@@ -370,6 +440,11 @@ def wrap_vector(cls):
             return self._impl.dim()
 
         def copy(self, deep=False):
+            if self._shared is not None:
+                # keep the copy shareable as well
+                vector = self.make_shared(self.dim)
+                vector.data[:] = self.data
+                return vector
             return type(self)(self._impl.copy())
 
 
@@ -434,16 +509,22 @@ def wrap_vector(cls):
             return self._impl.valid()
 
         def __getstate__(self):
+            if self._shared is not None:
+                # only the handle, the receiving side maps the same memory
+                return ('shared', self._shared.path, self._shared.dim, self._shared.offset)
             return self.data
 
-        def __setstate__(self, data):
-            self._impl = self.wrapped_type(len(data))
-            self.data[:] = data
+        def __setstate__(self, state):
+            if isinstance(state, tuple) and state[0] == 'shared':
+                storage = SharedVectorStorage(*state[1:])
+                self._impl = self.wrapped_type(storage.array)
+                self._shared = storage
+            else:
+                self._impl = self.wrapped_type(len(state))
+                self.data[:] = state
 
     WrappedVector.__name__ = cls.__name__
 
-    wrapped_vectors[cls] = WrappedVector
-
     return WrappedVector
 
 
@@ -453,10 +534,11 @@ import copy_reg
 
 
 wrapped_vectors = {}
+wrapped_vectors_lock = threading.RLock()
 
 
 def unpickle_vector_class(cls):
-    return wrapped_vectors[cls]
+    return wrap_vector(cls)
 
 
 def pickle_vector_class(cls):
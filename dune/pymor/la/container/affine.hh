@@ -7,6 +7,7 @@
 #define DUNE_PYMOR_LA_CONTAINER_AFFINE_HH
 
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <type_traits>
 
@@ -20,12 +21,41 @@
 #include <dune/stuff/la/container/istl.hh>
 
 #include <dune/pymor/common/exceptions.hh>
+#include <dune/pymor/common/memory.hh>
+#include <dune/pymor/common/tracing.hh>
 #include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/parameters/batch.hh>
 #include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/parameters/thetas.hh>
+
+#include "memory.hh"
+#include "mmap.hh"
 
 namespace Dune {
 namespace Pymor {
 namespace LA {
+namespace internal {
+
+
+/**
+ * \brief Creates the ThetaBundle of a container once, even if it is requested concurrently.
+ */
+class LazyThetaBundle
+{
+public:
+  const ThetaBundle& get(const std::vector< std::shared_ptr< const ParameterFunctional > >& coefficients)
+  {
+    std::call_once(flag_, [&]() { bundle_.reset(new ThetaBundle(coefficients)); });
+    return *bundle_;
+  }
+
+private:
+  std::once_flag flag_;
+  std::unique_ptr< const ThetaBundle > bundle_;
+}; // class LazyThetaBundle
+
+
+} // namespace internal
 
 
 // forward
@@ -145,7 +175,7 @@ public:
     if (hasAffinePart_)
       DUNE_THROW(Stuff::Exceptions::you_are_using_this_wrong,
                  "do not call register_affine_part(aff_ptr) if has_affine_part() == true!");
-    if (num_components_ > 0 && !components_[0]->has_equal_shape(*aff_ptr))
+    if (num_components_ > 0 && !component_ptr(0)->has_equal_shape(*aff_ptr))
       DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
                             "the shape of aff_ptr does not match the shape of the existing containers!");
     affinePart_ = aff_ptr;
@@ -184,17 +214,18 @@ public:
                                         const std::shared_ptr< const ParameterFunctional > coeff_ptr)
   {
     if (hasAffinePart_) {
-      if (!affinePart_->has_equal_shape(*comp_ptr))
+      if (!affine_part_ptr()->has_equal_shape(*comp_ptr))
         DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
                    "the shape of comp_ptr does not match the shape of the existing containers!");
     } else if (num_components_ > 0)
-      if (!components_[0]->has_equal_shape(*comp_ptr))
+      if (!component_ptr(0)->has_equal_shape(*comp_ptr))
         DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
                    "the shape of aff_ptr does not match the shape of the existing components!");
     components_.push_back(comp_ptr);
     coefficients_.push_back(coeff_ptr);
     inherit_parameter_type(coeff_ptr->parameter_type(), "coefficient_" + Dune::Stuff::Common::toString(num_components_));
     ++num_components_;
+    thetas_ = std::make_shared< internal::LazyThetaBundle >();
     return num_components_ - 1;
   }
 
@@ -203,7 +234,7 @@ public:
     if (!hasAffinePart_)
       DUNE_THROW(Stuff::Exceptions::requirements_not_met,
                  "do not call affine_part() if has_affine_part() == false!");
-    return affinePart_;
+    return affine_part_ptr();
   }
 
   std::shared_ptr< const ContainerType > component(const DUNE_STUFF_SSIZE_T qq) const
@@ -215,7 +246,7 @@ public:
       DUNE_THROW(Stuff::Exceptions::index_out_of_range,
                  "the condition 0 < " << qq << " < num_components() = " << num_components_
                        << " is not satisfied!");
-    return components_[qq];
+    return component_ptr(qq);
   }
 
   std::shared_ptr< const ParameterFunctional > coefficient(const DUNE_STUFF_SSIZE_T qq) const
@@ -230,47 +261,158 @@ public:
     return coefficients_[qq];
   }
 
+  /**
+   * \brief All coefficients of this container, bundled for a fast evaluation.
+   * \note  The bundle is created upon the first call and is shared between copies of this container.
+   */
+  const ThetaBundle& thetas() const
+  {
+    return thetas_->get(coefficients_);
+  }
+
   ContainerType freeze_parameter(const Parameter mu = Parameter()) const
   {
-    if (mu.type() != parameter_type())
+    DUNE_PYMOR_TRACE_SCOPE("pymor.la.affinelydecomposedcontainer.freeze_parameter");
+    check_freeze_parameter(mu);
+    if (hasAffinePart_ && (num_components_ == 0))
+      return *affine_part_ptr();
+    return freeze_coefficients(thetas().evaluate(mu).data());
+  } // ... freeze_parameter(...)
+
+  /**
+   * \brief Like freeze_parameter(), but the result is created on the heap and, if this container consists of its
+   *        affine part only, the affine part is shared instead of copied.
+   */
+  std::shared_ptr< const ContainerType > freeze_parameter_ptr(const Parameter mu = Parameter()) const
+  {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.la.affinelydecomposedcontainer.freeze_parameter");
+    check_freeze_parameter(mu);
+    if (hasAffinePart_ && (num_components_ == 0))
+      return affine_part_ptr();
+    return std::make_shared< const ContainerType >(freeze_coefficients(thetas().evaluate(mu).data()));
+  } // ... freeze_parameter_ptr(...)
+
+  /**
+   * \brief The sum of the affine part and the components weighted by coefficients, created on the heap.
+   */
+  std::shared_ptr< const ContainerType > lincomb_ptr(const std::vector< double >& coefficients) const
+  {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.la.affinelydecomposedcontainer.lincomb");
+    if (num_components_ == 0 && !hasAffinePart_)
+      DUNE_THROW(Stuff::Exceptions::requirements_not_met,
+                 "do not call lincomb_ptr() if num_components() == 0 and has_affine_part() == false!");
+    if (coefficients.size() != boost::numeric_cast< size_t >(num_components_))
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "coefficients.size() has to be " << num_components_ << " (is " << coefficients.size() << ")!");
+    if (num_components_ == 0)
+      return affine_part_ptr();
+    return std::make_shared< const ContainerType >(freeze_coefficients(coefficients.data()));
+  } // ... lincomb_ptr(...)
+
+  /**
+   * \brief Freezes this container for each parameter in mus, the coefficients of all parameters are evaluated at once.
+   */
+  std::vector< ContainerType > freeze_parameter(const ParameterBatch& mus) const
+  {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.la.affinelydecomposedcontainer.freeze_parameter_batch");
+    if (mus.type() != parameter_type())
       DUNE_THROW(Exceptions::wrong_parameter_type,
-                 "the type of mu (" << mu.type() << ") does not match the parameter_type of this ("
+                 "the type of mus (" << mus.type() << ") does not match the parameter_type of this ("
                        << parameter_type() << ")!");
     if (num_components_ == 0 && !hasAffinePart_)
       DUNE_THROW(Stuff::Exceptions::requirements_not_met,
                  "do not call freeze_parameter() if num_components() == 0 and has_affine_part() == false!");
-    if (components_.size() != boost::numeric_cast< size_t >(num_components_))
-     DUNE_THROW(Stuff::Exceptions::internal_error, "");
-    if (coefficients_.size() != boost::numeric_cast< size_t >(num_components_))
-      DUNE_THROW(Stuff::Exceptions::internal_error, "");
-    if (hasAffinePart_ && (num_components_ == 0))
-      return *affinePart_;
-    else if (!hasAffinePart_ && num_components_ == 1) {
-      auto ret = components_[0]->copy();
-      ret.scal(coefficients_[0]->evaluate(map_parameter(mu, "coefficient_0")));
+    std::vector< ContainerType > ret;
+    ret.reserve(mus.size());
+    if (num_components_ == 0) {
+      for (DUNE_STUFF_SSIZE_T ii = 0; ii < mus.size(); ++ii)
+        ret.emplace_back(affine_part_ptr()->copy());
       return ret;
-    } else {
-      std::vector< std::shared_ptr< const ContainerType > > containers;
-      std::vector< double > evals;
-      if (hasAffinePart_) {
-        containers.push_back(affinePart_);
-        evals.push_back(1.);
-      }
-      for (DUNE_STUFF_SSIZE_T qq = 0; qq < num_components_; ++qq) {
-        containers.push_back(components_[qq]);
-        evals.push_back(coefficients_[qq]->evaluate(map_parameter(mu, "coefficient_" + Dune::Stuff::Common::toString(qq))));
-      }
-      return Assemble< ContainerType >::lincomb(containers, evals);
     }
+    const auto coefficients = thetas().evaluate(mus);
+    for (DUNE_STUFF_SSIZE_T ii = 0; ii < mus.size(); ++ii)
+      ret.emplace_back(freeze_coefficients(coefficients.data() + ii*num_components_));
+    return ret;
   } // ... freeze_parameter(...)
 
+  /**
+   * \brief Adds the storage of the affine part and of each component to footprint.
+   * \note  The components of a loaded container which have not been accessed yet are not counted.
+   */
+  void memory_footprint(MemoryFootprint& footprint, const std::string prefix = "") const
+  {
+    const auto affine_part = (loader_ && loader_->has_affine_part()) ? loader_->peek_affine_part() : affinePart_;
+    if (affine_part)
+      LA::memory_footprint(*affine_part, footprint, MemoryFootprint::join(prefix, "affine_part"));
+    for (DUNE_STUFF_SSIZE_T qq = 0; qq < num_components_; ++qq) {
+      const auto component = is_loaded(qq) ? loader_->peek_component(qq) : components_[qq];
+      if (component)
+        LA::memory_footprint(*component,
+                             footprint,
+                             MemoryFootprint::join(prefix, "component_" + Dune::Stuff::Common::toString(qq)));
+    }
+  } // ... memory_footprint(...)
+
+  MemoryFootprint memory_footprint() const
+  {
+    MemoryFootprint footprint;
+    memory_footprint(footprint);
+    return footprint;
+  }
+
+  /**
+   * \brief Writes the affine part, all components and all coefficients to filename, to be read by load().
+   *
+   *        The file is written to a temporary file first, which then replaces filename. Containers loaded from filename
+   *        before (in this or any other process, including this container) thus keep reading the previous file.
+   * \see   internal::MappedHeader for the format of the file
+   */
+  void save(const std::string& filename) const
+  {
+    std::vector< std::shared_ptr< const ContainerType > > components(num_components_);
+    for (DUNE_STUFF_SSIZE_T qq = 0; qq < num_components_; ++qq)
+      components[qq] = component_ptr(qq);
+    internal::write_mapped(filename,
+                           hasAffinePart_ ? affine_part_ptr() : std::shared_ptr< const ContainerType >(),
+                           components,
+                           coefficients_);
+  } // ... save(...)
+
+  /**
+   * \brief Loads a container written by save(), the affine part and the components refer to the mapped file.
+   *
+   *        The file is mapped into memory and each component is only read upon its first access (which is thread
+   *        safe). The mapped pages are shared with all other processes loading the same file (until they are written
+   *        to), the components with all copies of the returned container.
+   * \note  Only available if ContainerType can refer to a mapped file (i.e. for EigenMappedDenseVector), use
+   *        load_copy() for all other containers.
+   */
+  static ThisType load(const std::string& filename)
+  {
+    static_assert(internal::MappedFormat< ContainerType >::maps_entries,
+                  "ContainerType cannot refer to a mapped file, use load_copy() to copy the entries!");
+    return load_mapped(filename);
+  }
+
+  /**
+   * \brief Loads a container written by save(), each component is copied into memory of this process upon its first
+   *        access.
+   *
+   *        This saves the assembly of the components, but they are only shared with all copies of the returned
+   *        container, not between processes. Containers which can refer to a mapped file are not copied, \see load().
+   */
+  static ThisType load_copy(const std::string& filename)
+  {
+    return load_mapped(filename);
+  }
+
   ThisType copy()
   {
     ThisType ret;
     if (hasAffinePart_)
-      ret.register_affine_part(new ContainerType(affinePart_->copy()));
+      ret.register_affine_part(new ContainerType(affine_part_ptr()->copy()));
     for (DUNE_STUFF_SSIZE_T qq = 0; qq < num_components_; ++qq)
-      ret.register_component(new ContainerType(components_[qq]->copy()),
+      ret.register_component(new ContainerType(component_ptr(qq)->copy()),
                              new ParameterFunctional(*coefficients_[qq]));
     return ret;
   } // ... copy(...)
@@ -279,13 +421,85 @@ public:
   {
     AffinelyDecomposedContainer< ContainerType > ret;
     for (size_t qq = 0; qq < num_components_; ++qq)
-      ret.register_component(new ContainerType(components_[qq]->backend(), true), coefficients_[qq]);
+      ret.register_component(new ContainerType(component_ptr(qq)->backend(), true), coefficients_[qq]);
     if (hasAffinePart_)
-      ret.register_affine_part(new ContainerType(affinePart_->backend(), true));
+      ret.register_affine_part(new ContainerType(affine_part_ptr()->backend(), true));
     return ret;
   } // ... pruned(...)
 
 protected:
+  /**
+   * \brief Access to the affine part and the components, which reads them from the mapped file of a loaded container.
+   */
+  std::shared_ptr< const ContainerType > affine_part_ptr() const
+  {
+    return (loader_ && loader_->has_affine_part()) ? loader_->affine_part() : affinePart_;
+  }
+
+  std::shared_ptr< const ContainerType > component_ptr(const DUNE_STUFF_SSIZE_T qq) const
+  {
+    return is_loaded(qq) ? loader_->component(qq) : components_[qq];
+  }
+
+  /**
+   * \brief Whether the component qq is contained in the file this container was loaded from, instead of registered.
+   */
+  bool is_loaded(const DUNE_STUFF_SSIZE_T qq) const
+  {
+    return loader_ && size_t(qq) < loader_->num_components();
+  }
+
+  static ThisType load_mapped(const std::string& filename)
+  {
+    auto contents = internal::read_mapped< ContainerType >(filename);
+    ThisType ret;
+    ret.hasAffinePart_ = contents.has_affine_part;
+    ret.num_components_ = contents.coefficients.size();
+    ret.components_.resize(ret.num_components_);
+    ret.coefficients_ = contents.coefficients;
+    for (DUNE_STUFF_SSIZE_T qq = 0; qq < ret.num_components_; ++qq)
+      ret.inherit_parameter_type(ret.coefficients_[qq]->parameter_type(),
+                                 "coefficient_" + Dune::Stuff::Common::toString(qq));
+    ret.loader_ = contents.loader;
+    return ret;
+  } // ... load_mapped(...)
+
+  void check_freeze_parameter(const Parameter& mu) const
+  {
+    if (mu.type() != parameter_type())
+      DUNE_THROW(Exceptions::wrong_parameter_type,
+                 "the type of mu (" << mu.type() << ") does not match the parameter_type of this ("
+                       << parameter_type() << ")!");
+    if (num_components_ == 0 && !hasAffinePart_)
+      DUNE_THROW(Stuff::Exceptions::requirements_not_met,
+                 "do not call freeze_parameter() if num_components() == 0 and has_affine_part() == false!");
+    if (components_.size() != boost::numeric_cast< size_t >(num_components_))
+     DUNE_THROW(Stuff::Exceptions::internal_error, "");
+    if (coefficients_.size() != boost::numeric_cast< size_t >(num_components_))
+      DUNE_THROW(Stuff::Exceptions::internal_error, "");
+  } // ... check_freeze_parameter(...)
+
+  ContainerType freeze_coefficients(const double* coefficients) const
+  {
+    if (!hasAffinePart_ && num_components_ == 1) {
+      auto ret = component_ptr(0)->copy();
+      ret.scal(coefficients[0]);
+      return ret;
+    } else {
+      std::vector< std::shared_ptr< const ContainerType > > containers;
+      std::vector< double > evals;
+      if (hasAffinePart_) {
+        containers.push_back(affine_part_ptr());
+        evals.push_back(1.);
+      }
+      for (DUNE_STUFF_SSIZE_T qq = 0; qq < num_components_; ++qq) {
+        containers.push_back(component_ptr(qq));
+        evals.push_back(coefficients[qq]);
+      }
+      return Assemble< ContainerType >::lincomb(containers, evals);
+    }
+  } // ... freeze_coefficients(...)
+
   template< class CC, bool anything = true >
   struct Assemble
   {
@@ -347,9 +561,14 @@ protected:
 
   bool hasAffinePart_;
   DUNE_STUFF_SSIZE_T num_components_;
+  //! empty for the components (and the affine part) contained in the file of a loaded container, \see loader_
   std::vector< std::shared_ptr< const ContainerType > > components_;
   std::vector< std::shared_ptr< const ParameterFunctional > > coefficients_;
   std::shared_ptr< const ContainerType > affinePart_;
+  //! shared between copies with the same coefficients, created upon first access (in a thread safe manner)
+  std::shared_ptr< internal::LazyThetaBundle > thetas_ = std::make_shared< internal::LazyThetaBundle >();
+  //! reads the contents of the file of a loaded container upon first access and keeps them, shared between copies
+  std::shared_ptr< const internal::MappedLoader< ContainerType > > loader_;
 }; // class AffinelyDecomposedConstContainer
 
 
@@ -0,0 +1,474 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_LA_CONTAINER_INTERPOLATION_HH
+#define DUNE_PYMOR_LA_CONTAINER_INTERPOLATION_HH
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/common/string.hh>
+#include <dune/stuff/la/container/interfaces.hh>
+#include <dune/stuff/la/container/common.hh>
+#include <dune/stuff/la/container/eigen.hh>
+#include <dune/stuff/la/container/istl.hh>
+#include <dune/stuff/la/container/pattern.hh>
+
+#include <dune/pymor/common/exceptions.hh>
+#include <dune/pymor/common/threading.hh>
+#include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/parameters/functional.hh>
+
+#include "affine.hh"
+
+namespace Dune {
+namespace Pymor {
+namespace LA {
+namespace internal {
+
+
+/**
+ * \brief The positions of the entries of a matrix which are considered by the interpolation, all of them for dense
+ *        matrices, specializations for sparse ones below.
+ */
+template< class MatrixType >
+struct MatrixEntries
+{
+  typedef std::vector< std::pair< size_t, size_t > > PositionsType;
+
+  static PositionsType positions(const MatrixType& matrix)
+  {
+    PositionsType ret;
+    ret.reserve(matrix.rows()*matrix.cols());
+    for (size_t ii = 0; ii < matrix.rows(); ++ii)
+      for (size_t jj = 0; jj < matrix.cols(); ++jj)
+        ret.emplace_back(ii, jj);
+    return ret;
+  }
+
+  static std::shared_ptr< MatrixType > create(const size_t rows, const size_t cols, const PositionsType& /*positions*/)
+  {
+    return std::make_shared< MatrixType >(rows, cols);
+  }
+}; // struct MatrixEntries
+
+
+template< class MatrixType >
+struct SparseMatrixEntries
+{
+  typedef std::vector< std::pair< size_t, size_t > > PositionsType;
+
+  static std::shared_ptr< MatrixType > create(const size_t rows, const size_t cols, const PositionsType& positions)
+  {
+    Stuff::LA::SparsityPatternDefault pattern(rows);
+    for (const auto& position : positions)
+      pattern.insert(position.first, position.second);
+    return std::make_shared< MatrixType >(rows, cols, pattern);
+  }
+}; // struct SparseMatrixEntries
+
+
+#if HAVE_EIGEN
+
+template< class S >
+struct MatrixEntries< Stuff::LA::EigenRowMajorSparseMatrix< S > >
+  : public SparseMatrixEntries< Stuff::LA::EigenRowMajorSparseMatrix< S > >
+{
+  typedef Stuff::LA::EigenRowMajorSparseMatrix< S > MatrixType;
+  typedef typename MatrixType::BackendType          BackendType;
+  typedef std::vector< std::pair< size_t, size_t > > PositionsType;
+
+  static PositionsType positions(const MatrixType& matrix)
+  {
+    const auto& backend = matrix.backend();
+    PositionsType ret;
+    ret.reserve(backend.nonZeros());
+    for (size_t ii = 0; ii < matrix.rows(); ++ii)
+      for (typename BackendType::InnerIterator it(backend, ii); it; ++it)
+        ret.emplace_back(ii, it.col());
+    return ret;
+  }
+}; // struct MatrixEntries< EigenRowMajorSparseMatrix< ... > >
+
+#endif // HAVE_EIGEN
+
+#if HAVE_DUNE_ISTL
+
+template< class S >
+struct MatrixEntries< Stuff::LA::IstlRowMajorSparseMatrix< S > >
+  : public SparseMatrixEntries< Stuff::LA::IstlRowMajorSparseMatrix< S > >
+{
+  typedef Stuff::LA::IstlRowMajorSparseMatrix< S >  MatrixType;
+  typedef std::vector< std::pair< size_t, size_t > > PositionsType;
+
+  static PositionsType positions(const MatrixType& matrix)
+  {
+    const auto& backend = matrix.backend();
+    PositionsType ret;
+    ret.reserve(backend.nonzeroes());
+    for (size_t ii = 0; ii < matrix.rows(); ++ii)
+      if (backend.getrowsize(ii) > 0)
+        for (auto it = backend[ii].begin(); it != backend[ii].end(); ++it)
+          ret.emplace_back(ii, it.index());
+    return ret;
+  }
+}; // struct MatrixEntries< IstlRowMajorSparseMatrix< ... > >
+
+#endif // HAVE_DUNE_ISTL
+
+
+/**
+ * \brief The entries of a vector (or the entries of a matrix in the positions of its pattern) as a flat array.
+ */
+template< class ContainerType,
+          bool is_vector = std::is_base_of< Stuff::LA::Tags::VectorInterface, ContainerType >::value >
+class FlatEntries
+{
+public:
+  explicit FlatEntries(const ContainerType& like)
+    : dim_(like.dim())
+  {}
+
+  size_t size() const
+  {
+    return dim_;
+  }
+
+  std::pair< size_t, size_t > position(const size_t ii) const
+  {
+    return std::make_pair(ii, size_t(0));
+  }
+
+  void get(const ContainerType& container, double* values) const
+  {
+    if (container.dim() != dim_)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the container has dimension " << container.dim() << ", should be " << dim_ << "!");
+    for (size_t ii = 0; ii < dim_; ++ii)
+      values[ii] = container.get_entry(ii);
+  }
+
+  std::shared_ptr< ContainerType > create(const double* values) const
+  {
+    auto ret = std::make_shared< ContainerType >(dim_);
+    for (size_t ii = 0; ii < dim_; ++ii)
+      ret->set_entry(ii, values[ii]);
+    return ret;
+  }
+
+private:
+  const size_t dim_;
+}; // class FlatEntries
+
+
+template< class ContainerType >
+class FlatEntries< ContainerType, false >
+{
+public:
+  explicit FlatEntries(const ContainerType& like)
+    : rows_(like.rows())
+    , cols_(like.cols())
+    , positions_(MatrixEntries< ContainerType >::positions(like))
+  {}
+
+  size_t size() const
+  {
+    return positions_.size();
+  }
+
+  std::pair< size_t, size_t > position(const size_t ii) const
+  {
+    return positions_[ii];
+  }
+
+  /**
+   * \note Entries outside of the positions of the first snapshot are ignored.
+   */
+  void get(const ContainerType& container, double* values) const
+  {
+    if (container.rows() != rows_ || container.cols() != cols_)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the container is a " << container.rows() << "x" << container.cols() << " matrix, should be "
+                 << rows_ << "x" << cols_ << "!");
+    for (size_t ii = 0; ii < positions_.size(); ++ii)
+      values[ii] = container.get_entry(positions_[ii].first, positions_[ii].second);
+  }
+
+  std::shared_ptr< ContainerType > create(const double* values) const
+  {
+    auto ret = MatrixEntries< ContainerType >::create(rows_, cols_, positions_);
+    for (size_t ii = 0; ii < positions_.size(); ++ii)
+      ret->set_entry(positions_[ii].first, positions_[ii].second, values[ii]);
+    return ret;
+  }
+
+private:
+  const size_t rows_;
+  const size_t cols_;
+  const std::vector< std::pair< size_t, size_t > > positions_;
+}; // class FlatEntries< ..., false >
+
+
+/**
+ * \brief The coefficients of an empirical interpolation, shared by all its ParameterFunctionals.
+ *
+ *        The generator is evaluated (at the interpolation entries only, if possible) once per parameter, the
+ *        coefficients of the last parameter are kept for the other functionals.
+ */
+template< class ContainerType >
+class InterpolationCoefficients
+{
+public:
+  typedef std::function< std::shared_ptr< const ContainerType >(const Parameter&) >                   GeneratorType;
+  typedef std::function< void(const Parameter&, const std::vector< size_t >&, std::vector< double >&) >
+      RestrictedGeneratorType;
+
+  /**
+   * \param interpolation_matrix the values of the basis containers at the interpolation entries, lower triangular
+   *        with unit diagonal (row-major, size indices.size()^2)
+   */
+  InterpolationCoefficients(const GeneratorType& generator,
+                            const RestrictedGeneratorType& restricted_generator,
+                            const std::shared_ptr< const FlatEntries< ContainerType > > entries,
+                            const std::vector< size_t >& indices,
+                            const std::vector< double >& interpolation_matrix)
+    : generator_(generator)
+    , restricted_generator_(restricted_generator)
+    , entries_(entries)
+    , indices_(indices)
+    , interpolation_matrix_(interpolation_matrix)
+    , valid_(false)
+  {}
+
+  double evaluate(const Parameter& mu, const size_t qq) const
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    if (!valid_ || mu != mu_) {
+      compute(mu, coefficients_);
+      mu_ = mu;
+      valid_ = true;
+    }
+    return coefficients_[qq];
+  } // ... evaluate(...)
+
+private:
+  void compute(const Parameter& mu, std::vector< double >& ret) const
+  {
+    const size_t size = indices_.size();
+    std::vector< double > values;
+    if (restricted_generator_) {
+      restricted_generator_(mu, indices_, values);
+      if (values.size() != size)
+        DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                   "the restricted generator returned " << values.size() << " values, should be " << size << "!");
+    } else {
+      std::vector< double > all_values(entries_->size());
+      entries_->get(*generator_(mu), all_values.data());
+      values.resize(size);
+      for (size_t ii = 0; ii < size; ++ii)
+        values[ii] = all_values[indices_[ii]];
+    }
+    // forward substitution
+    ret.resize(size);
+    for (size_t ii = 0; ii < size; ++ii) {
+      double value = values[ii];
+      for (size_t jj = 0; jj < ii; ++jj)
+        value -= interpolation_matrix_[ii*size + jj]*ret[jj];
+      ret[ii] = value;
+    }
+  } // ... compute(...)
+
+  const GeneratorType generator_;
+  const RestrictedGeneratorType restricted_generator_;
+  const std::shared_ptr< const FlatEntries< ContainerType > > entries_;
+  const std::vector< size_t > indices_;
+  const std::vector< double > interpolation_matrix_;
+  mutable std::mutex mutex_;
+  mutable bool valid_;
+  mutable Parameter mu_;
+  mutable std::vector< double > coefficients_;
+}; // class InterpolationCoefficients
+
+
+} // namespace internal
+
+
+/**
+ * \brief Builds an affine decomposition of a parametric vector or matrix by empirical interpolation (EIM applied to
+ *        the entries, also known as DEIM).
+ *
+ *        The generator is evaluated for each parameter of the training set. In each step, the snapshot with the
+ *        largest interpolation error (in the maximum norm) is selected, its interpolation residual, normalized at its
+ *        entry of largest modulus, becomes the next component and this entry the next interpolation entry. The
+ *        interpolation errors of all snapshots are computed in parallel.
+ *
+ *        The coefficients of the resulting AffinelyDecomposedConstContainer evaluate the generator at the
+ *        interpolation entries only, if a restricted generator is given (which has to fill its last argument with
+ *        the entries of the container for mu at the given flat indices, see position()), and the whole generator
+ *        otherwise.
+ * \note  All snapshots are kept in memory during build(), as dense arrays of their (nonzero) entries.
+ */
+template< class ContainerImp >
+class EmpiricalInterpolation
+{
+  typedef internal::FlatEntries< ContainerImp >               EntriesType;
+  typedef internal::InterpolationCoefficients< ContainerImp > CoefficientsType;
+public:
+  typedef ContainerImp                                      ContainerType;
+  typedef AffinelyDecomposedConstContainer< ContainerType > AffinelyDecomposedContainerType;
+  typedef typename CoefficientsType::GeneratorType           GeneratorType;
+  typedef typename CoefficientsType::RestrictedGeneratorType RestrictedGeneratorType;
+
+  EmpiricalInterpolation(const GeneratorType& generator,
+                         const RestrictedGeneratorType& restricted_generator = RestrictedGeneratorType())
+    : generator_(generator)
+    , restricted_generator_(restricted_generator)
+  {
+    if (!generator_)
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "generator must not be empty!");
+  }
+
+  /**
+   * \brief Selects at most max_size components, until the largest interpolation error is below tolerance.
+   */
+  AffinelyDecomposedContainerType build(const std::vector< Parameter >& training_set,
+                                        const size_t max_size,
+                                        const double tolerance = 1e-10,
+                                        const size_t num_threads = 0)
+  {
+    if (training_set.empty())
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "training_set must not be empty!");
+    const ParameterType& type = training_set[0].type();
+    for (const auto& mu : training_set)
+      if (mu.type() != type)
+        DUNE_THROW(Pymor::Exceptions::wrong_parameter_type,
+                   "all parameters of the training set have to be of type " << type << ", not " << mu.type() << "!");
+    // compute the snapshots (sequentially, the generator need not be thread safe)
+    const size_t num_snapshots = training_set.size();
+    const auto first = generator_(training_set[0]);
+    entries_ = std::make_shared< const EntriesType >(*first);
+    const size_t size = entries_->size();
+    std::vector< double > residuals(num_snapshots*size);
+    entries_->get(*first, residuals.data());
+    for (size_t ss = 1; ss < num_snapshots; ++ss)
+      entries_->get(*generator_(training_set[ss]), residuals.data() + ss*size);
+    // greedy selection
+    indices_.clear();
+    max_errors_.clear();
+    std::vector< std::vector< double > > basis;
+    std::vector< double > errors(num_snapshots);
+    std::vector< size_t > arg_errors(num_snapshots);
+    while (basis.size() < max_size) {
+      parallel_for(0, num_snapshots, [&](const size_t first_snapshot, const size_t last_snapshot) {
+        for (size_t ss = first_snapshot; ss < last_snapshot; ++ss) {
+          const double* residual = residuals.data() + ss*size;
+          double error = 0.;
+          size_t arg_error = 0;
+          for (size_t ii = 0; ii < size; ++ii)
+            if (std::abs(residual[ii]) > error) {
+              error = std::abs(residual[ii]);
+              arg_error = ii;
+            }
+          errors[ss] = error;
+          arg_errors[ss] = arg_error;
+        }
+      }, num_threads);
+      size_t selected = 0;
+      for (size_t ss = 1; ss < num_snapshots; ++ss)
+        if (errors[ss] > errors[selected])
+          selected = ss;
+      max_errors_.push_back(errors[selected]);
+      if (errors[selected] <= tolerance)
+        break;
+      const size_t index = arg_errors[selected];
+      const double* residual = residuals.data() + selected*size;
+      std::vector< double > component(residual, residual + size);
+      const double scaling = 1./component[index];
+      for (auto& value : component)
+        value *= scaling;
+      // the new component vanishes at all previous interpolation entries, thus so do the updated residuals
+      parallel_for(0, num_snapshots, [&](const size_t first_snapshot, const size_t last_snapshot) {
+        for (size_t ss = first_snapshot; ss < last_snapshot; ++ss) {
+          double* residual_ss = residuals.data() + ss*size;
+          const double value = residual_ss[index];
+          for (size_t ii = 0; ii < size; ++ii)
+            residual_ss[ii] -= value*component[ii];
+        }
+      }, num_threads);
+      basis.emplace_back(std::move(component));
+      indices_.push_back(index);
+    }
+    // the values of the components at the interpolation entries (lower triangular with unit diagonal)
+    const size_t num_components = basis.size();
+    std::vector< double > interpolation_matrix(num_components*num_components, 0.);
+    for (size_t ii = 0; ii < num_components; ++ii)
+      for (size_t jj = 0; jj <= ii; ++jj)
+        interpolation_matrix[ii*num_components + jj] = basis[jj][indices_[ii]];
+    const auto coefficients = std::make_shared< const CoefficientsType >(generator_,
+                                                                         restricted_generator_,
+                                                                         entries_,
+                                                                         indices_,
+                                                                         interpolation_matrix);
+    AffinelyDecomposedContainerType ret;
+    for (size_t qq = 0; qq < num_components; ++qq) {
+      const std::shared_ptr< const ContainerType > component = entries_->create(basis[qq].data());
+      basis[qq].clear();
+      basis[qq].shrink_to_fit();
+      ret.register_component(component,
+                             std::make_shared< const ParameterFunctional >(
+                               type,
+                               [coefficients, qq](const Parameter& mu) { return coefficients->evaluate(mu, qq); },
+                               "empirical_interpolation[" + Stuff::Common::toString(qq) + "]"));
+    }
+    return ret;
+  } // ... build(...)
+
+  /**
+   * \brief The flat indices of the interpolation entries selected by the last build().
+   */
+  const std::vector< size_t >& interpolation_indices() const
+  {
+    return indices_;
+  }
+
+  /**
+   * \brief The position (index, 0 for vectors and (row, column) for matrices) of flat index ii.
+   */
+  std::pair< size_t, size_t > position(const size_t ii) const
+  {
+    if (!entries_)
+      DUNE_THROW(Stuff::Exceptions::you_are_using_this_wrong, "call build() first!");
+    return entries_->position(ii);
+  }
+
+  /**
+   * \brief The largest interpolation error over the training set in each step of the last build().
+   */
+  const std::vector< double >& max_errors() const
+  {
+    return max_errors_;
+  }
+
+private:
+  const GeneratorType generator_;
+  const RestrictedGeneratorType restricted_generator_;
+  std::shared_ptr< const EntriesType > entries_;
+  std::vector< size_t > indices_;
+  std::vector< double > max_errors_;
+}; // class EmpiricalInterpolation
+
+
+} // namespace LA
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_LA_CONTAINER_INTERPOLATION_HH
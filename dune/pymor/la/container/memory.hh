@@ -0,0 +1,107 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_LA_CONTAINER_MEMORY_HH
+#define DUNE_PYMOR_LA_CONTAINER_MEMORY_HH
+
+#include <string>
+#include <type_traits>
+
+#include <dune/stuff/la/container/interfaces.hh>
+#include <dune/stuff/la/container/common.hh>
+#include <dune/stuff/la/container/eigen.hh>
+#include <dune/stuff/la/container/istl.hh>
+
+#include <dune/pymor/common/memory.hh>
+
+namespace Dune {
+namespace Pymor {
+namespace LA {
+namespace internal {
+
+
+/**
+ * \brief Computes the storage of dense containers, specializations below for sparse ones.
+ * \note  The address of the backend is used to identify the storage, which is thus counted once for containers which
+ *        share their backend (either by sharing the container itself or due to copy on write).
+ */
+template< class ContainerType,
+          bool is_vector = std::is_base_of< Stuff::LA::Tags::VectorInterface, ContainerType >::value >
+struct ContainerMemory
+{
+  static size_t bytes(const ContainerType& container)
+  {
+    return container.dim()*sizeof(typename ContainerType::ScalarType);
+  }
+}; // struct ContainerMemory
+
+
+template< class ContainerType >
+struct ContainerMemory< ContainerType, false >
+{
+  static size_t bytes(const ContainerType& container)
+  {
+    return container.rows()*container.cols()*sizeof(typename ContainerType::ScalarType);
+  }
+}; // struct ContainerMemory< ..., false >
+
+
+#if HAVE_EIGEN
+
+template< class S >
+struct ContainerMemory< Stuff::LA::EigenRowMajorSparseMatrix< S >, false >
+{
+  static size_t bytes(const Stuff::LA::EigenRowMajorSparseMatrix< S >& container)
+  {
+    // the default storage index of Eigen::SparseMatrix is int
+    const auto& backend = container.backend();
+    return backend.nonZeros()*(sizeof(S) + sizeof(int)) + (backend.outerSize() + 1)*sizeof(int);
+  }
+}; // struct ContainerMemory< EigenRowMajorSparseMatrix< ... > >
+
+#endif // HAVE_EIGEN
+
+#if HAVE_DUNE_ISTL
+
+template< class S >
+struct ContainerMemory< Stuff::LA::IstlRowMajorSparseMatrix< S >, false >
+{
+  static size_t bytes(const Stuff::LA::IstlRowMajorSparseMatrix< S >& container)
+  {
+    typedef typename Stuff::LA::IstlRowMajorSparseMatrix< S >::BackendType BackendType;
+    const auto& backend = container.backend();
+    return backend.nonzeroes()*(sizeof(typename BackendType::block_type) + sizeof(typename BackendType::size_type))
+        + backend.N()*sizeof(typename BackendType::row_type);
+  }
+}; // struct ContainerMemory< IstlRowMajorSparseMatrix< ... > >
+
+#endif // HAVE_DUNE_ISTL
+
+
+} // namespace internal
+
+
+/**
+ * \brief The number of bytes used to store the entries (and the sparsity pattern) of container.
+ */
+template< class ContainerType >
+size_t memory_footprint(const ContainerType& container)
+{
+  return internal::ContainerMemory< ContainerType >::bytes(container);
+}
+
+
+template< class ContainerType >
+void memory_footprint(const ContainerType& container, MemoryFootprint& footprint, const std::string& name)
+{
+  footprint.add(name, &container.backend(), memory_footprint(container));
+}
+
+
+} // namespace LA
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_LA_CONTAINER_MEMORY_HH
@@ -0,0 +1,636 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_LA_CONTAINER_MMAP_HH
+#define DUNE_PYMOR_LA_CONTAINER_MMAP_HH
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <unistd.h>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/la/container/interfaces.hh>
+#include <dune/stuff/la/container/common.hh>
+#include <dune/stuff/la/container/eigen.hh>
+#include <dune/stuff/la/container/istl.hh>
+#include <dune/stuff/la/container/pattern.hh>
+
+#include <dune/pymor/common/mmap.hh>
+#include <dune/pymor/parameters/functional.hh>
+
+namespace Dune {
+namespace Pymor {
+namespace LA {
+namespace internal {
+
+
+/**
+ * \brief Layout of the files written by AffinelyDecomposedConstContainer::save().
+ *
+ *        The file starts with a MappedHeader, followed by one MappedBlock per container (the affine part first, if
+ *        present, then all components) and the coefficients of the components. The data of each container is stored
+ *        in a block of its own, aligned to page_size, so that each container is only paged in when it is accessed.
+ *        All numbers are stored in the byte order of the writing machine, which is checked upon reading.
+ */
+struct MappedHeader
+{
+  static const uint32_t current_version = 1;
+  static const uint32_t byte_order_mark = 0x01020304;
+  static const uint64_t page_size = 4096;
+
+  static const char* magic_string()
+  {
+    return "DPYMORAC";
+  }
+
+  enum Kind : uint32_t { dense_vector = 0, dense_matrix = 1, csr_matrix = 2 };
+
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t kind;
+  uint32_t scalar_size;
+  uint32_t has_affine_part;
+  uint32_t padding;
+  uint64_t num_components;
+  //! position and size of the serialized coefficients
+  uint64_t coefficients_offset;
+  uint64_t coefficients_size;
+}; // struct MappedHeader
+
+struct MappedBlock
+{
+  uint64_t offset;
+  uint64_t size;
+}; // struct MappedBlock
+
+
+class MappedWriter
+{
+public:
+  MappedWriter(std::ostream& out)
+    : out_(out)
+  {}
+
+  template< class T >
+  void write(const T& value)
+  {
+    static_assert(std::is_trivially_copyable< T >::value, "T has to be trivially copyable!");
+    out_.write(reinterpret_cast< const char* >(&value), sizeof(T));
+  }
+
+  template< class T >
+  void write(const T* values, const size_t num)
+  {
+    static_assert(std::is_trivially_copyable< T >::value, "T has to be trivially copyable!");
+    out_.write(reinterpret_cast< const char* >(values), num*sizeof(T));
+  }
+
+  void write(const std::string& str)
+  {
+    write(uint64_t(str.size()));
+    out_.write(str.data(), str.size());
+  }
+
+private:
+  std::ostream& out_;
+}; // class MappedWriter
+
+
+/**
+ * \brief Reads from a block of a MappedFile, checking all accesses against the bounds of the block.
+ */
+class MappedReader
+{
+public:
+  MappedReader(const char* data, const size_t size, const std::string& filename)
+    : data_(data)
+    , size_(size)
+    , position_(0)
+    , filename_(filename)
+  {}
+
+  template< class T >
+  T read()
+  {
+    T ret;
+    std::memcpy(&ret, advance(sizeof(T)), sizeof(T));
+    return ret;
+  }
+
+  std::string read_string()
+  {
+    const auto size = read< uint64_t >();
+    return std::string(advance(size), size);
+  }
+
+  /**
+   * \brief Returns a pointer to the next num elements (which are not copied).
+   */
+  template< class T >
+  const T* view(const size_t num)
+  {
+    if (position_ % alignof(T) != 0)
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "'" << filename_ << "' is corrupt (misaligned data)!");
+    return reinterpret_cast< const T* >(advance(num*sizeof(T)));
+  }
+
+private:
+  const char* advance(const size_t bytes)
+  {
+    if (bytes > size_ - position_)
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "'" << filename_ << "' is corrupt (unexpected end of data)!");
+    const char* ret = data_ + position_;
+    position_ += bytes;
+    return ret;
+  }
+
+  const char* data_;
+  const size_t size_;
+  size_t position_;
+  const std::string& filename_;
+}; // class MappedReader
+
+
+/**
+ * \brief Writes and reads a single container, specializations below.
+ *
+ *        A dense vector is stored as its dimension followed by its entries, a dense matrix as its number of rows and
+ *        columns followed by its entries in row major order. read() copies the entries into a newly allocated
+ *        container, unless maps_entries is true (only for EigenMappedDenseVector), in which case the container refers
+ *        to the mapped file.
+ */
+template< class ContainerType,
+          bool is_vector = std::is_base_of< Stuff::LA::Tags::VectorInterface, ContainerType >::value >
+struct MappedFormat
+{
+  typedef typename ContainerType::ScalarType ScalarType;
+  static const MappedHeader::Kind kind = MappedHeader::dense_vector;
+  static const bool maps_entries = false;
+
+  static uint64_t size(const ContainerType& container)
+  {
+    return sizeof(uint64_t) + container.dim()*sizeof(ScalarType);
+  }
+
+  static void write(const ContainerType& container, MappedWriter& out)
+  {
+    out.write(uint64_t(container.dim()));
+    for (size_t ii = 0; ii < container.dim(); ++ii)
+      out.write(ScalarType(container.get_entry(ii)));
+  }
+
+  static std::shared_ptr< const ContainerType > read(MappedReader& in, const std::shared_ptr< MappedFile >& /*file*/)
+  {
+    const size_t dim = in.read< uint64_t >();
+    const ScalarType* values = in.view< ScalarType >(dim);
+    auto ret = std::make_shared< ContainerType >(dim);
+    for (size_t ii = 0; ii < dim; ++ii)
+      ret->set_entry(ii, values[ii]);
+    return ret;
+  }
+}; // struct MappedFormat
+
+
+template< class ContainerType >
+struct MappedFormat< ContainerType, false >
+{
+  typedef typename ContainerType::ScalarType ScalarType;
+  static const MappedHeader::Kind kind = MappedHeader::dense_matrix;
+  static const bool maps_entries = false;
+
+  static uint64_t size(const ContainerType& container)
+  {
+    return 2*sizeof(uint64_t) + container.rows()*container.cols()*sizeof(ScalarType);
+  }
+
+  static void write(const ContainerType& container, MappedWriter& out)
+  {
+    out.write(uint64_t(container.rows()));
+    out.write(uint64_t(container.cols()));
+    for (size_t ii = 0; ii < container.rows(); ++ii)
+      for (size_t jj = 0; jj < container.cols(); ++jj)
+        out.write(ScalarType(container.get_entry(ii, jj)));
+  }
+
+  static std::shared_ptr< const ContainerType > read(MappedReader& in, const std::shared_ptr< MappedFile >& /*file*/)
+  {
+    const size_t rows = in.read< uint64_t >();
+    const size_t cols = in.read< uint64_t >();
+    const ScalarType* values = in.view< ScalarType >(rows*cols);
+    auto ret = std::make_shared< ContainerType >(rows, cols);
+    for (size_t ii = 0; ii < rows; ++ii)
+      for (size_t jj = 0; jj < cols; ++jj)
+        ret->set_entry(ii, jj, values[ii*cols + jj]);
+    return ret;
+  }
+}; // struct MappedFormat< ..., false >
+
+
+/**
+ * \brief A sparse matrix is stored in CSR format: the number of rows, columns and nonzeros, followed by the row
+ *        pointers (rows + 1), the column indices and the values of all nonzeros (with sorted column indices per row).
+ */
+struct CsrFormatBase
+{
+  static const bool maps_entries = false;
+
+  static uint64_t size(const size_t rows, const size_t nonzeros, const size_t scalar_size)
+  {
+    return (3 + rows + 1 + nonzeros)*sizeof(uint64_t) + nonzeros*scalar_size;
+  }
+
+  struct View
+  {
+    size_t rows;
+    size_t cols;
+    size_t nonzeros;
+    const uint64_t* row_pointers;
+    const uint64_t* column_indices;
+  }; // struct View
+
+  static View read_pattern(MappedReader& in)
+  {
+    View ret;
+    ret.rows = in.read< uint64_t >();
+    ret.cols = in.read< uint64_t >();
+    ret.nonzeros = in.read< uint64_t >();
+    ret.row_pointers = in.view< uint64_t >(ret.rows + 1);
+    ret.column_indices = in.view< uint64_t >(ret.nonzeros);
+    return ret;
+  }
+
+  static Stuff::LA::SparsityPatternDefault pattern(const View& view)
+  {
+    Stuff::LA::SparsityPatternDefault ret(view.rows);
+    for (size_t ii = 0; ii < view.rows; ++ii)
+      for (size_t kk = view.row_pointers[ii]; kk < view.row_pointers[ii + 1]; ++kk)
+        ret.insert(ii, view.column_indices[kk]);
+    return ret;
+  }
+}; // struct CsrFormatBase
+
+
+#if HAVE_EIGEN
+
+/**
+ * \brief The entries of an EigenMappedDenseVector are not copied but directly refer to the mapped file.
+ */
+template< class S >
+struct MappedFormat< Stuff::LA::EigenMappedDenseVector< S >, true >
+  : public MappedFormat< Stuff::LA::EigenDenseVector< S >, true >
+{
+  typedef Stuff::LA::EigenMappedDenseVector< S > ContainerType;
+  static const bool maps_entries = true;
+
+  static std::shared_ptr< const ContainerType > read(MappedReader& in, const std::shared_ptr< MappedFile >& file)
+  {
+    const size_t dim = in.read< uint64_t >();
+    const S* values = in.view< S >(dim);
+    // the mapping is private, so the vector may even be written to without altering the file
+    return std::shared_ptr< const ContainerType >(new ContainerType(const_cast< S* >(values), dim),
+                                                  [file](const ContainerType* ptr) { delete ptr; });
+  }
+}; // struct MappedFormat< EigenMappedDenseVector< ... > >
+
+
+template< class S >
+struct MappedFormat< Stuff::LA::EigenRowMajorSparseMatrix< S >, false >
+  : public CsrFormatBase
+{
+  typedef Stuff::LA::EigenRowMajorSparseMatrix< S > ContainerType;
+  typedef typename ContainerType::BackendType       BackendType;
+  static const MappedHeader::Kind kind = MappedHeader::csr_matrix;
+
+  static uint64_t size(const ContainerType& container)
+  {
+    return CsrFormatBase::size(container.rows(), container.backend().nonZeros(), sizeof(S));
+  }
+
+  static void write(const ContainerType& container, MappedWriter& out)
+  {
+    const auto& backend = container.backend();
+    out.write(uint64_t(container.rows()));
+    out.write(uint64_t(container.cols()));
+    out.write(uint64_t(backend.nonZeros()));
+    uint64_t row_pointer = 0;
+    out.write(row_pointer);
+    for (size_t ii = 0; ii < container.rows(); ++ii) {
+      for (typename BackendType::InnerIterator it(backend, ii); it; ++it)
+        ++row_pointer;
+      out.write(row_pointer);
+    }
+    for (size_t ii = 0; ii < container.rows(); ++ii)
+      for (typename BackendType::InnerIterator it(backend, ii); it; ++it)
+        out.write(uint64_t(it.col()));
+    for (size_t ii = 0; ii < container.rows(); ++ii)
+      for (typename BackendType::InnerIterator it(backend, ii); it; ++it)
+        out.write(S(it.value()));
+  } // ... write(...)
+
+  static std::shared_ptr< const ContainerType > read(MappedReader& in, const std::shared_ptr< MappedFile >& /*file*/)
+  {
+    const auto view = read_pattern(in);
+    const S* values = in.view< S >(view.nonzeros);
+    auto ret = std::make_shared< ContainerType >(view.rows, view.cols, pattern(view));
+    for (size_t ii = 0; ii < view.rows; ++ii)
+      for (size_t kk = view.row_pointers[ii]; kk < view.row_pointers[ii + 1]; ++kk)
+        ret->set_entry(ii, view.column_indices[kk], values[kk]);
+    return ret;
+  }
+}; // struct MappedFormat< EigenRowMajorSparseMatrix< ... > >
+
+#endif // HAVE_EIGEN
+
+#if HAVE_DUNE_ISTL
+
+template< class S >
+struct MappedFormat< Stuff::LA::IstlRowMajorSparseMatrix< S >, false >
+  : public CsrFormatBase
+{
+  typedef Stuff::LA::IstlRowMajorSparseMatrix< S > ContainerType;
+  static const MappedHeader::Kind kind = MappedHeader::csr_matrix;
+
+  static uint64_t size(const ContainerType& container)
+  {
+    return CsrFormatBase::size(container.rows(), container.backend().nonzeroes(), sizeof(S));
+  }
+
+  static void write(const ContainerType& container, MappedWriter& out)
+  {
+    const auto& backend = container.backend();
+    out.write(uint64_t(container.rows()));
+    out.write(uint64_t(container.cols()));
+    out.write(uint64_t(backend.nonzeroes()));
+    uint64_t row_pointer = 0;
+    out.write(row_pointer);
+    for (size_t ii = 0; ii < container.rows(); ++ii) {
+      row_pointer += backend.getrowsize(ii);
+      out.write(row_pointer);
+    }
+    for (size_t ii = 0; ii < container.rows(); ++ii)
+      if (backend.getrowsize(ii) > 0)
+        for (auto it = backend[ii].begin(); it != backend[ii].end(); ++it)
+          out.write(uint64_t(it.index()));
+    for (size_t ii = 0; ii < container.rows(); ++ii)
+      if (backend.getrowsize(ii) > 0)
+        for (auto it = backend[ii].begin(); it != backend[ii].end(); ++it)
+          out.write(S((*it)[0][0]));
+  } // ... write(...)
+
+  static std::shared_ptr< const ContainerType > read(MappedReader& in, const std::shared_ptr< MappedFile >& /*file*/)
+  {
+    const auto view = read_pattern(in);
+    const S* values = in.view< S >(view.nonzeros);
+    auto ret = std::make_shared< ContainerType >(view.rows, view.cols, pattern(view));
+    auto& backend = ret->backend();
+    // the column indices of a row of the backend are sorted, as are the ones in the file
+    for (size_t ii = 0; ii < view.rows; ++ii) {
+      size_t kk = view.row_pointers[ii];
+      if (backend.getrowsize(ii) > 0)
+        for (auto it = backend[ii].begin(); it != backend[ii].end(); ++it, ++kk)
+          (*it)[0][0] = values[kk];
+      if (kk != view.row_pointers[ii + 1])
+        DUNE_THROW(Stuff::Exceptions::internal_error, "the pattern of the matrix does not match the file!");
+    }
+    return ret;
+  }
+}; // struct MappedFormat< IstlRowMajorSparseMatrix< ... > >
+
+#endif // HAVE_DUNE_ISTL
+
+
+/**
+ * \brief Materializes the containers of a mapped file upon request, \see MappedFormat::read().
+ *
+ *        Each container is read once and then kept by the loader, which is shared by all copies of a loaded
+ *        AffinelyDecomposedConstContainer.
+ */
+template< class ContainerType >
+class MappedLoader
+{
+public:
+  MappedLoader(const std::shared_ptr< MappedFile > file, const std::vector< MappedBlock >& blocks, const bool affine)
+    : file_(file)
+    , blocks_(blocks)
+    , affine_(affine)
+    , containers_(blocks.size())
+  {}
+
+  bool has_affine_part() const
+  {
+    return affine_;
+  }
+
+  size_t num_components() const
+  {
+    return blocks_.size() - (affine_ ? 1 : 0);
+  }
+
+  std::shared_ptr< const ContainerType > affine_part() const
+  {
+    assert(affine_);
+    return get(0);
+  }
+
+  std::shared_ptr< const ContainerType > component(const size_t qq) const
+  {
+    return get(affine_ ? qq + 1 : qq);
+  }
+
+  /**
+   * \brief Returns the affine part if it has been read already, without reading anything.
+   */
+  std::shared_ptr< const ContainerType > peek_affine_part() const
+  {
+    return affine_ ? peek(0) : nullptr;
+  }
+
+  std::shared_ptr< const ContainerType > peek_component(const size_t qq) const
+  {
+    return peek(affine_ ? qq + 1 : qq);
+  }
+
+private:
+  std::shared_ptr< const ContainerType > get(const size_t block) const
+  {
+    std::lock_guard< std::mutex > guard(mutex_);
+    if (block >= blocks_.size())
+      DUNE_THROW(Stuff::Exceptions::internal_error, "block " << block << " is not contained in the file!");
+    if (!containers_[block]) {
+      MappedReader in(file_->data() + blocks_[block].offset, blocks_[block].size, file_->filename());
+      containers_[block] = MappedFormat< ContainerType >::read(in, file_);
+    }
+    return containers_[block];
+  } // ... get(...)
+
+  std::shared_ptr< const ContainerType > peek(const size_t block) const
+  {
+    std::lock_guard< std::mutex > guard(mutex_);
+    assert(block < blocks_.size());
+    return containers_[block];
+  }
+
+  const std::shared_ptr< MappedFile > file_;
+  const std::vector< MappedBlock > blocks_;
+  const bool affine_;
+  mutable std::vector< std::shared_ptr< const ContainerType > > containers_;
+  mutable std::mutex mutex_;
+}; // class MappedLoader
+
+
+template< class ContainerType >
+void write_mapped(const std::string& filename,
+                  const std::shared_ptr< const ContainerType >& affine_part,
+                  const std::vector< std::shared_ptr< const ContainerType > >& components,
+                  const std::vector< std::shared_ptr< const ParameterFunctional > >& coefficients)
+{
+  typedef MappedFormat< ContainerType > Format;
+  assert(components.size() == coefficients.size());
+  std::vector< std::shared_ptr< const ContainerType > > containers;
+  if (affine_part)
+    containers.push_back(affine_part);
+  containers.insert(containers.end(), components.begin(), components.end());
+  // serialize the coefficients
+  std::ostringstream coefficients_stream;
+  MappedWriter coefficients_writer(coefficients_stream);
+  for (const auto& coefficient : coefficients) {
+    if (coefficient->callable())
+      DUNE_THROW(Stuff::Exceptions::you_are_using_this_wrong,
+                 "coefficient '" << coefficient->expression() << "' is given by a function and cannot be written!");
+    const auto& type = coefficient->parameter_type();
+    coefficients_writer.write(uint64_t(type.keys().size()));
+    for (size_t ii = 0; ii < type.keys().size(); ++ii) {
+      coefficients_writer.write(type.keys()[ii]);
+      coefficients_writer.write(int64_t(type.values()[ii]));
+    }
+    coefficients_writer.write(coefficient->expression());
+  }
+  const std::string serialized_coefficients = coefficients_stream.str();
+  // compute the layout
+  MappedHeader header;
+  std::memcpy(header.magic, MappedHeader::magic_string(), 8);
+  header.version = MappedHeader::current_version;
+  header.byte_order = MappedHeader::byte_order_mark;
+  header.kind = Format::kind;
+  header.scalar_size = sizeof(typename ContainerType::ScalarType);
+  header.has_affine_part = affine_part ? 1 : 0;
+  header.padding = 0;
+  header.num_components = components.size();
+  header.coefficients_offset = sizeof(MappedHeader) + containers.size()*sizeof(MappedBlock);
+  header.coefficients_size = serialized_coefficients.size();
+  std::vector< MappedBlock > blocks(containers.size());
+  uint64_t offset = header.coefficients_offset + header.coefficients_size;
+  for (size_t ii = 0; ii < containers.size(); ++ii) {
+    offset = ((offset + MappedHeader::page_size - 1)/MappedHeader::page_size)*MappedHeader::page_size;
+    blocks[ii].offset = offset;
+    blocks[ii].size = Format::size(*containers[ii]);
+    offset += blocks[ii].size;
+  }
+  // write to a temporary file which then replaces filename, instead of truncating filename, which might be mapped by
+  // a loaded container (of this or any other process) and could then no longer be read
+  static std::atomic< size_t > num_written(0);
+  const std::string tmp_filename = filename + ".tmp." + std::to_string(::getpid()) + "." + std::to_string(num_written++);
+  std::ofstream file(tmp_filename, std::ios::binary | std::ios::trunc);
+  if (!file)
+    DUNE_THROW(Stuff::Exceptions::external_error, "could not open '" << tmp_filename << "' for writing!");
+  MappedWriter out(file);
+  out.write(header);
+  out.write(blocks.data(), blocks.size());
+  file.write(serialized_coefficients.data(), serialized_coefficients.size());
+  for (size_t ii = 0; ii < containers.size(); ++ii) {
+    const auto position = uint64_t(file.tellp());
+    assert(position <= blocks[ii].offset);
+    file.write(std::string(blocks[ii].offset - position, '\0').data(), blocks[ii].offset - position);
+    Format::write(*containers[ii], out);
+    assert(uint64_t(file.tellp()) == blocks[ii].offset + blocks[ii].size);
+  }
+  file.close();
+  if (!file) {
+    std::remove(tmp_filename.c_str());
+    DUNE_THROW(Stuff::Exceptions::external_error, "could not write to '" << tmp_filename << "'!");
+  }
+  if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+    std::remove(tmp_filename.c_str());
+    DUNE_THROW(Stuff::Exceptions::external_error, "could not replace '" << filename << "'!");
+  }
+} // ... write_mapped(...)
+
+
+/**
+ * \brief The contents of a file written by write_mapped(), the containers are only read upon request.
+ */
+template< class ContainerType >
+struct MappedContents
+{
+  bool has_affine_part;
+  std::vector< std::shared_ptr< const ParameterFunctional > > coefficients;
+  std::shared_ptr< const MappedLoader< ContainerType > > loader;
+}; // struct MappedContents
+
+
+template< class ContainerType >
+MappedContents< ContainerType > read_mapped(const std::string& filename)
+{
+  typedef MappedFormat< ContainerType > Format;
+  auto file = std::make_shared< MappedFile >(filename);
+  MappedReader in(file->data(), file->size(), filename);
+  const auto header = in.read< MappedHeader >();
+  if (std::memcmp(header.magic, MappedHeader::magic_string(), 8) != 0)
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given, "'" << filename << "' is not an affinely decomposed container!");
+  if (header.version != MappedHeader::current_version)
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+               "'" << filename << "' has version " << header.version
+               << " (expected " << uint32_t(MappedHeader::current_version) << ")!");
+  if (header.byte_order != MappedHeader::byte_order_mark)
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+               "'" << filename << "' was written on a machine with a different byte order!");
+  if (header.kind != uint32_t(Format::kind) || header.scalar_size != sizeof(typename ContainerType::ScalarType))
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+               "the containers in '" << filename << "' do not match the requested container type!");
+  const size_t num_blocks = header.num_components + (header.has_affine_part ? 1 : 0);
+  const MappedBlock* blocks = in.view< MappedBlock >(num_blocks);
+  for (size_t ii = 0; ii < num_blocks; ++ii)
+    if (blocks[ii].offset > file->size() || blocks[ii].size > file->size() - blocks[ii].offset)
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "'" << filename << "' is corrupt (truncated file)!");
+  if (header.coefficients_offset > file->size()
+      || header.coefficients_size > file->size() - header.coefficients_offset)
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given, "'" << filename << "' is corrupt (truncated file)!");
+  MappedContents< ContainerType > ret;
+  ret.has_affine_part = header.has_affine_part;
+  MappedReader coefficients_in(file->data() + header.coefficients_offset, header.coefficients_size, filename);
+  for (size_t qq = 0; qq < header.num_components; ++qq) {
+    const size_t num_keys = coefficients_in.read< uint64_t >();
+    std::vector< std::string > keys(num_keys);
+    std::vector< DUNE_STUFF_SSIZE_T > values(num_keys);
+    for (size_t ii = 0; ii < num_keys; ++ii) {
+      keys[ii] = coefficients_in.read_string();
+      values[ii] = coefficients_in.read< int64_t >();
+    }
+    const std::string expression = coefficients_in.read_string();
+    ret.coefficients.emplace_back(new ParameterFunctional(keys, values, expression));
+  }
+  const std::vector< MappedBlock > block_table(blocks, blocks + num_blocks);
+  ret.loader = std::make_shared< MappedLoader< ContainerType > >(file, block_table, ret.has_affine_part);
+  return ret;
+} // ... read_mapped(...)
+
+
+} // namespace internal
+} // namespace LA
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_LA_CONTAINER_MMAP_HH
@@ -0,0 +1,241 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include "eigensolver.hh"
+
+namespace Dune {
+namespace Pymor {
+namespace LA {
+namespace internal {
+
+
+/**
+ * \brief Householder reduction of vv to tridiagonal form (diagonal dd, subdiagonal ee), vv is overwritten by the
+ *        accumulated transformation.
+ */
+static void tridiagonalize(const size_t nn, std::vector< double >& vv, std::vector< double >& dd, std::vector< double >& ee)
+{
+  auto V = [&](const size_t ii, const size_t jj) -> double& { return vv[ii*nn + jj]; };
+  for (size_t jj = 0; jj < nn; ++jj)
+    dd[jj] = V(nn - 1, jj);
+  for (size_t ii = nn - 1; ii > 0; --ii) {
+    // scale to avoid under/overflow
+    double scale = 0.0;
+    double hh = 0.0;
+    for (size_t kk = 0; kk < ii; ++kk)
+      scale += std::abs(dd[kk]);
+    if (scale == 0.0) {
+      ee[ii] = dd[ii - 1];
+      for (size_t jj = 0; jj < ii; ++jj) {
+        dd[jj] = V(ii - 1, jj);
+        V(ii, jj) = 0.0;
+        V(jj, ii) = 0.0;
+      }
+    } else {
+      // generate the Householder vector
+      for (size_t kk = 0; kk < ii; ++kk) {
+        dd[kk] /= scale;
+        hh += dd[kk]*dd[kk];
+      }
+      double ff = dd[ii - 1];
+      double gg = std::sqrt(hh);
+      if (ff > 0)
+        gg = -gg;
+      ee[ii] = scale*gg;
+      hh -= ff*gg;
+      dd[ii - 1] = ff - gg;
+      for (size_t jj = 0; jj < ii; ++jj)
+        ee[jj] = 0.0;
+      // apply the similarity transformation to the remaining columns
+      for (size_t jj = 0; jj < ii; ++jj) {
+        ff = dd[jj];
+        V(jj, ii) = ff;
+        gg = ee[jj] + V(jj, jj)*ff;
+        for (size_t kk = jj + 1; kk <= ii - 1; ++kk) {
+          gg += V(kk, jj)*dd[kk];
+          ee[kk] += V(kk, jj)*ff;
+        }
+        ee[jj] = gg;
+      }
+      ff = 0.0;
+      for (size_t jj = 0; jj < ii; ++jj) {
+        ee[jj] /= hh;
+        ff += ee[jj]*dd[jj];
+      }
+      const double hh2 = ff/(hh + hh);
+      for (size_t jj = 0; jj < ii; ++jj)
+        ee[jj] -= hh2*dd[jj];
+      for (size_t jj = 0; jj < ii; ++jj) {
+        ff = dd[jj];
+        gg = ee[jj];
+        for (size_t kk = jj; kk <= ii - 1; ++kk)
+          V(kk, jj) -= (ff*ee[kk] + gg*dd[kk]);
+        dd[jj] = V(ii - 1, jj);
+        V(ii, jj) = 0.0;
+      }
+    }
+    dd[ii] = hh;
+  }
+  // accumulate the transformations
+  for (size_t ii = 0; ii + 1 < nn; ++ii) {
+    V(nn - 1, ii) = V(ii, ii);
+    V(ii, ii) = 1.0;
+    const double hh = dd[ii + 1];
+    if (hh != 0.0) {
+      for (size_t kk = 0; kk <= ii; ++kk)
+        dd[kk] = V(kk, ii + 1)/hh;
+      for (size_t jj = 0; jj <= ii; ++jj) {
+        double gg = 0.0;
+        for (size_t kk = 0; kk <= ii; ++kk)
+          gg += V(kk, ii + 1)*V(kk, jj);
+        for (size_t kk = 0; kk <= ii; ++kk)
+          V(kk, jj) -= gg*dd[kk];
+      }
+    }
+    for (size_t kk = 0; kk <= ii; ++kk)
+      V(kk, ii + 1) = 0.0;
+  }
+  for (size_t jj = 0; jj < nn; ++jj) {
+    dd[jj] = V(nn - 1, jj);
+    V(nn - 1, jj) = 0.0;
+  }
+  V(nn - 1, nn - 1) = 1.0;
+  ee[0] = 0.0;
+} // ... tridiagonalize(...)
+
+/**
+ * \brief Diagonalizes the tridiagonal matrix given by dd and ee by the implicit QL algorithm, the transformations are
+ *        accumulated in vv.
+ */
+static void diagonalize(const size_t nn, std::vector< double >& vv, std::vector< double >& dd, std::vector< double >& ee)
+{
+  auto V = [&](const size_t ii, const size_t jj) -> double& { return vv[ii*nn + jj]; };
+  for (size_t ii = 1; ii < nn; ++ii)
+    ee[ii - 1] = ee[ii];
+  ee[nn - 1] = 0.0;
+  double ff = 0.0;
+  double tst1 = 0.0;
+  const double eps = std::numeric_limits< double >::epsilon();
+  for (size_t ll = 0; ll < nn; ++ll) {
+    // find a small subdiagonal element
+    tst1 = std::max(tst1, std::abs(dd[ll]) + std::abs(ee[ll]));
+    size_t mm = ll;
+    while (mm < nn) {
+      if (std::abs(ee[mm]) <= eps*tst1)
+        break;
+      ++mm;
+    }
+    // if mm == ll, dd[ll] is an eigenvalue, otherwise iterate
+    if (mm > ll) {
+      size_t iterations = 0;
+      do {
+        if (++iterations > 30*nn)
+          DUNE_THROW(Stuff::Exceptions::internal_error, "the QL algorithm did not converge!");
+        // compute the implicit shift
+        double gg = dd[ll];
+        double pp = (dd[ll + 1] - gg)/(2.0*ee[ll]);
+        double rr = std::hypot(pp, 1.0);
+        if (pp < 0)
+          rr = -rr;
+        dd[ll] = ee[ll]/(pp + rr);
+        dd[ll + 1] = ee[ll]*(pp + rr);
+        const double dl1 = dd[ll + 1];
+        double hh = gg - dd[ll];
+        for (size_t ii = ll + 2; ii < nn; ++ii)
+          dd[ii] -= hh;
+        ff += hh;
+        // implicit QL transformation
+        pp = dd[mm];
+        double cc = 1.0;
+        double cc2 = cc;
+        double cc3 = cc;
+        const double el1 = ee[ll + 1];
+        double ss = 0.0;
+        double ss2 = 0.0;
+        for (size_t ii = mm; ii-- > ll;) {
+          cc3 = cc2;
+          cc2 = cc;
+          ss2 = ss;
+          gg = cc*ee[ii];
+          hh = cc*pp;
+          rr = std::hypot(pp, ee[ii]);
+          ee[ii + 1] = ss*rr;
+          ss = ee[ii]/rr;
+          cc = pp/rr;
+          pp = cc*dd[ii] - ss*gg;
+          dd[ii + 1] = hh + ss*(cc*gg + ss*dd[ii]);
+          // accumulate the transformation
+          for (size_t kk = 0; kk < nn; ++kk) {
+            hh = V(kk, ii + 1);
+            V(kk, ii + 1) = ss*V(kk, ii) + cc*hh;
+            V(kk, ii) = cc*V(kk, ii) - ss*hh;
+          }
+        }
+        pp = -ss*ss2*cc3*el1*ee[ll]/dl1;
+        ee[ll] = ss*pp;
+        dd[ll] = cc*pp;
+      } while (std::abs(ee[ll]) > eps*tst1);
+    }
+    dd[ll] += ff;
+    ee[ll] = 0.0;
+  }
+  // sort the eigenvalues and eigenvectors
+  for (size_t ii = 0; ii + 1 < nn; ++ii) {
+    size_t kk = ii;
+    double pp = dd[ii];
+    for (size_t jj = ii + 1; jj < nn; ++jj)
+      if (dd[jj] < pp) {
+        kk = jj;
+        pp = dd[jj];
+      }
+    if (kk != ii) {
+      dd[kk] = dd[ii];
+      dd[ii] = pp;
+      for (size_t jj = 0; jj < nn; ++jj)
+        std::swap(V(jj, ii), V(jj, kk));
+    }
+  }
+} // ... diagonalize(...)
+
+
+} // namespace internal
+
+
+void symmetric_eigendecomposition(const std::vector< double >& matrix,
+                                  const size_t size,
+                                  std::vector< double >& eigenvalues,
+                                  std::vector< double >& eigenvectors)
+{
+  if (matrix.size() != size*size)
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+               "matrix has to be of size " << size*size << " (is " << matrix.size() << ")!");
+  eigenvalues.assign(size, 0.0);
+  eigenvectors.assign(size*size, 0.0);
+  if (size == 0)
+    return;
+  // symmetrize from the lower triangle
+  for (size_t ii = 0; ii < size; ++ii)
+    for (size_t jj = 0; jj <= ii; ++jj)
+      eigenvectors[ii*size + jj] = eigenvectors[jj*size + ii] = matrix[ii*size + jj];
+  for (const auto& entry : eigenvectors)
+    if (std::isnan(entry) || std::isinf(entry))
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "matrix contains nan or inf!");
+  std::vector< double > subdiagonal(size, 0.0);
+  internal::tridiagonalize(size, eigenvectors, eigenvalues, subdiagonal);
+  internal::diagonalize(size, eigenvectors, eigenvalues, subdiagonal);
+} // ... symmetric_eigendecomposition(...)
+
+
+} // namespace LA
+} // namespace Pymor
+} // namespace Dune
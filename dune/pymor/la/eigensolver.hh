@@ -0,0 +1,37 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_LA_EIGENSOLVER_HH
+#define DUNE_PYMOR_LA_EIGENSOLVER_HH
+
+#include <cstddef>
+#include <vector>
+
+namespace Dune {
+namespace Pymor {
+namespace LA {
+
+
+/**
+ * \brief Computes all eigenvalues and eigenvectors of a small dense symmetric matrix.
+ *
+ *        Uses a Householder reduction to tridiagonal form followed by the implicit QL algorithm (tred2 and tql2 of
+ *        EISPACK), which is sufficient for the Gram matrices of reduced basis methods (up to a few thousand rows).
+ * \param matrix       the size x size matrix in row major storage, only the lower triangle is read
+ * \param eigenvalues  is resized to size, contains the eigenvalues in ascending order
+ * \param eigenvectors is resized to size*size, the ii-th column (row major storage) is the normalized eigenvector to
+ *                     eigenvalues[ii]
+ */
+void symmetric_eigendecomposition(const std::vector< double >& matrix,
+                                  const size_t size,
+                                  std::vector< double >& eigenvalues,
+                                  std::vector< double >& eigenvectors);
+
+
+} // namespace LA
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_LA_EIGENSOLVER_HH
@@ -0,0 +1,407 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_LA_GRAM_SCHMIDT_HH
+#define DUNE_PYMOR_LA_GRAM_SCHMIDT_HH
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/common/threading.hh>
+#include <dune/pymor/common/tracing.hh>
+#include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/operators/interfaces.hh>
+
+namespace Dune {
+namespace Pymor {
+namespace LA {
+
+
+/**
+ * \brief Orthonormalizes a list of vectors with respect to the euclidean or a given product.
+ *
+ *        The vectors are processed in blocks. Each block is first projected twice onto the orthogonal complement of
+ *        all vectors which are already orthonormal (BCGS2) and then orthonormalized by two Cholesky QR steps (CholQR2).
+ *        If the Cholesky decomposition of a block breaks down or the block is badly conditioned, i.e. some of its
+ *        vectors are (nearly) linearly dependent, the block is orthonormalized vector by vector using classical
+ *        Gram-Schmidt with re-orthogonalization (CGS2) instead. A vector is removed if its norm after the
+ *        orthogonalization is below max(atol, rtol*(its initial norm)).
+ *
+ *        All inner products, applications of the product and linear combinations of a block are computed in parallel,
+ *        using num_threads threads (\see parallel_for()). Usage example:
+\code
+GramSchmidt< VectorType > gram_schmidt;
+const size_t num_new = gram_schmidt.orthonormalize(basis, discretization.get_product("h1"), mu, old_size)
+                       - old_size;
+\endcode
+ * \note  The application of a parametric product is frozen once for the given parameter.
+ */
+template< class VectorImp >
+class GramSchmidt
+{
+public:
+  typedef VectorImp                                              VectorType;
+  typedef typename VectorType::ScalarType                        ScalarType;
+  typedef std::function< void(const VectorType&, VectorType&) >  ProductApplyType;
+
+  GramSchmidt(const double atol = 1e-13,
+              const double rtol = 1e-13,
+              const size_t block_size = 16,
+              const size_t num_threads = 0)
+    : atol_(atol)
+    , rtol_(rtol)
+    , block_size_(block_size)
+    , num_threads_(num_threads == 0 ? default_num_threads() : num_threads)
+  {
+    if (!(atol_ >= 0.0) || !(rtol_ >= 0.0))
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+                 "atol (" << atol_ << ") and rtol (" << rtol_ << ") have to be nonnegative!");
+    if (block_size_ == 0)
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "block_size must not be 0!");
+  } // GramSchmidt(...)
+
+  /**
+   * \brief Orthonormalizes basis[offset], ..., basis[basis.size() - 1] with respect to the euclidean product.
+   *
+   *        The first offset vectors are assumed to be orthonormal already and are not touched. Linearly dependent
+   *        vectors are removed from basis.
+   * \return the new size of basis
+   */
+  size_t orthonormalize(std::vector< VectorType >& basis, const size_t offset = 0) const
+  {
+    return orthonormalize(basis, ProductApplyType(), offset);
+  }
+
+  /**
+   * \brief Orthonormalizes basis[offset], ..., basis[basis.size() - 1] with respect to the given product.
+   */
+  template< class ProductTraits >
+  size_t orthonormalize(std::vector< VectorType >& basis,
+                        const OperatorInterface< ProductTraits >& product,
+                        const Parameter mu = Parameter(),
+                        const size_t offset = 0) const
+  {
+    if (product.parametric()) {
+      const auto frozen_product = product.freeze_parameter(mu);
+      return orthonormalize(basis,
+                            [&](const VectorType& source, VectorType& range) { frozen_product.apply(source, range); },
+                            offset);
+    } else
+      return orthonormalize(basis,
+                            [&](const VectorType& source, VectorType& range) { product.apply(source, range, mu); },
+                            offset);
+  } // ... orthonormalize(...)
+
+  /**
+   * \brief Orthonormalizes basis[offset], ..., basis[basis.size() - 1] with respect to the product given by its
+   *        application (the euclidean product if product is empty).
+   * \note  product is called concurrently from several threads.
+   */
+  size_t orthonormalize(std::vector< VectorType >& basis, const ProductApplyType& product, const size_t offset) const
+  {
+    std::vector< size_t > removed;
+    return orthonormalize(basis, product, offset, removed);
+  }
+
+  /**
+   * \brief As above, removed is filled with the (ascending) indices the removed vectors had in basis.
+   */
+  size_t orthonormalize(std::vector< VectorType >& basis,
+                        const ProductApplyType& product,
+                        const size_t offset,
+                        std::vector< size_t >& removed) const
+  {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.la.gramschmidt.orthonormalize");
+    removed.clear();
+    if (offset > basis.size())
+      DUNE_THROW(Stuff::Exceptions::index_out_of_range,
+                 "offset (" << offset << ") must not be larger than basis.size() (" << basis.size() << ")!");
+    std::vector< VectorType > orthonormal;
+    orthonormal.reserve(basis.size());
+    for (size_t ii = 0; ii < offset; ++ii)
+      orthonormal.emplace_back(std::move(basis[ii]));
+    for (size_t first = offset; first < basis.size(); first += block_size_) {
+      const size_t last = std::min(first + block_size_, basis.size());
+      std::vector< VectorType > block;
+      block.reserve(last - first);
+      for (size_t ii = first; ii < last; ++ii)
+        block.emplace_back(std::move(basis[ii]));
+      orthonormalize_block(orthonormal, block, product, first, removed);
+    }
+    basis = std::move(orthonormal);
+    return basis.size();
+  } // ... orthonormalize(...)
+
+private:
+  /**
+   * \brief Holds the product applied to each vector of a block, or points to the block itself for the euclidean
+   *        product.
+   */
+  class AppliedBlock
+  {
+  public:
+    AppliedBlock(const std::vector< VectorType >& block, const ProductApplyType& product, const size_t num_threads)
+      : block_(block)
+    {
+      if (!product)
+        return;
+      storage_.reserve(block.size());
+      for (const auto& vector : block)
+        storage_.emplace_back(vector.copy());
+      parallel_for(0, block.size(), [&](const size_t first, const size_t last) {
+        for (size_t kk = first; kk < last; ++kk)
+          product(block[kk], storage_[kk]);
+      }, num_threads);
+    } // AppliedBlock(...)
+
+    const VectorType& operator[](const size_t kk) const
+    {
+      return storage_.empty() ? block_[kk] : storage_[kk];
+    }
+
+  private:
+    const std::vector< VectorType >& block_;
+    std::vector< VectorType > storage_;
+  }; // class AppliedBlock
+
+  /**
+   * \brief Appends the orthonormalized block, which started at index first of the basis, to orthonormal.
+   */
+  void orthonormalize_block(std::vector< VectorType >& orthonormal,
+                            std::vector< VectorType >& block,
+                            const ProductApplyType& product,
+                            const size_t first,
+                            std::vector< size_t >& removed) const
+  {
+    std::vector< double > norms(block.size(), 0.0);
+    {
+      const AppliedBlock applied(block, product, num_threads_);
+      parallel_for(0, block.size(), [&](const size_t first, const size_t last) {
+        for (size_t kk = first; kk < last; ++kk)
+          norms[kk] = std::sqrt(std::max(0.0, double(block[kk].dot(applied[kk]))));
+      }, num_threads_);
+    }
+    for (size_t pass = 0; pass < 2; ++pass)
+      project(orthonormal, block, product);
+    if (cholesky_qr(block, norms, product) && cholesky_qr(block, std::vector< double >(block.size(), 1.0), product))
+      for (auto& vector : block)
+        orthonormal.emplace_back(std::move(vector));
+    else
+      classical_gram_schmidt(orthonormal, block, norms, product, first, removed);
+  } // ... orthonormalize_block(...)
+
+  /**
+   * \brief block[kk] -= sum_ii (orthonormal[ii], block[kk]) orthonormal[ii] for all kk
+   */
+  void project(const std::vector< VectorType >& orthonormal,
+               std::vector< VectorType >& block,
+               const ProductApplyType& product) const
+  {
+    if (orthonormal.empty() || block.empty())
+      return;
+    const size_t bs = block.size();
+    std::vector< double > coefficients(orthonormal.size()*bs);
+    {
+      const AppliedBlock applied(block, product, num_threads_);
+      parallel_for(0, orthonormal.size(), [&](const size_t first, const size_t last) {
+        for (size_t ii = first; ii < last; ++ii)
+          for (size_t kk = 0; kk < bs; ++kk)
+            coefficients[ii*bs + kk] = orthonormal[ii].dot(applied[kk]);
+      }, num_threads_);
+    }
+    if (bs >= num_threads_)
+      parallel_for(0, bs, [&](const size_t first, const size_t last) {
+        for (size_t kk = first; kk < last; ++kk)
+          for (size_t ii = 0; ii < orthonormal.size(); ++ii)
+            block[kk].axpy(-coefficients[ii*bs + kk], orthonormal[ii]);
+      }, num_threads_);
+    else {
+      // not enough vectors in the block to keep all threads busy, so each thread accumulates the contributions of a
+      // range of orthonormal vectors
+      std::mutex mutex;
+      parallel_for(0, orthonormal.size(), [&](const size_t first, const size_t last) {
+        std::vector< VectorType > updates;
+        updates.reserve(bs);
+        for (size_t kk = 0; kk < bs; ++kk) {
+          updates.emplace_back(orthonormal[first].copy());
+          updates[kk].scal(-coefficients[first*bs + kk]);
+          for (size_t ii = first + 1; ii < last; ++ii)
+            updates[kk].axpy(-coefficients[ii*bs + kk], orthonormal[ii]);
+        }
+        std::lock_guard< std::mutex > lock(mutex);
+        for (size_t kk = 0; kk < bs; ++kk)
+          block[kk].axpy(1.0, updates[kk]);
+      }, num_threads_);
+    }
+  } // ... project(...)
+
+  /**
+   * \brief Replaces block by block*R^{-1}, where R^T R = block^T P block, if the block is well conditioned.
+   * \return false (leaving block untouched) if the Cholesky decomposition breaks down, some R_kk is too small compared
+   *         to reference_norms[kk] or the block is badly conditioned
+   */
+  bool cholesky_qr(std::vector< VectorType >& block,
+                   const std::vector< double >& reference_norms,
+                   const ProductApplyType& product) const
+  {
+    const size_t bs = block.size();
+    std::vector< double > gram(bs*bs);
+    {
+      const AppliedBlock applied(block, product, num_threads_);
+      // the gram matrix is symmetric, only compute its upper triangle
+      parallel_for(0, bs*(bs + 1)/2, [&](const size_t first, const size_t last) {
+        for (size_t pp = first; pp < last; ++pp) {
+          size_t kk = 0;
+          size_t row_end = bs;
+          while (pp >= row_end)
+            row_end += bs - (++kk);
+          const size_t ll = bs - (row_end - pp);
+          gram[kk*bs + ll] = gram[ll*bs + kk] = block[kk].dot(applied[ll]);
+        }
+      }, num_threads_);
+    }
+    // gram = R^T R, with R upper triangular
+    std::vector< double > rr(bs*bs, 0.0);
+    double min_diagonal = std::numeric_limits< double >::max();
+    double max_diagonal = 0.0;
+    for (size_t ll = 0; ll < bs; ++ll) {
+      for (size_t kk = 0; kk < ll; ++kk) {
+        double value = gram[kk*bs + ll];
+        for (size_t jj = 0; jj < kk; ++jj)
+          value -= rr[jj*bs + kk]*rr[jj*bs + ll];
+        rr[kk*bs + ll] = value/rr[kk*bs + kk];
+      }
+      double diagonal = gram[ll*bs + ll];
+      for (size_t jj = 0; jj < ll; ++jj)
+        diagonal -= rr[jj*bs + ll]*rr[jj*bs + ll];
+      if (!(diagonal > 0.0))
+        return false;
+      rr[ll*bs + ll] = std::sqrt(diagonal);
+      if (rr[ll*bs + ll] < std::max(atol_, std::max(rtol_, cholesky_qr_tolerance())*reference_norms[ll]))
+        return false;
+      min_diagonal = std::min(min_diagonal, rr[ll*bs + ll]/std::max(reference_norms[ll], atol_));
+      max_diagonal = std::max(max_diagonal, rr[ll*bs + ll]/std::max(reference_norms[ll], atol_));
+    }
+    if (min_diagonal < cholesky_qr_tolerance()*max_diagonal)
+      return false;
+    // R^{-1}, upper triangular
+    std::vector< double > rr_inv(bs*bs, 0.0);
+    for (size_t ll = 0; ll < bs; ++ll) {
+      rr_inv[ll*bs + ll] = 1.0/rr[ll*bs + ll];
+      for (size_t kk = ll; kk > 0; --kk) {
+        double value = 0.0;
+        for (size_t jj = kk; jj <= ll; ++jj)
+          value -= rr[(kk - 1)*bs + jj]*rr_inv[jj*bs + ll];
+        rr_inv[(kk - 1)*bs + ll] = value/rr[(kk - 1)*bs + (kk - 1)];
+      }
+    }
+    // block[ll] = sum_{kk <= ll} R^{-1}_{kk, ll} block[kk]
+    std::vector< VectorType > result(bs);
+    parallel_for(0, bs, [&](const size_t first, const size_t last) {
+      for (size_t ll = first; ll < last; ++ll) {
+        result[ll] = block[ll].copy();
+        result[ll].scal(rr_inv[ll*bs + ll]);
+        for (size_t kk = 0; kk < ll; ++kk)
+          result[ll].axpy(rr_inv[kk*bs + ll], block[kk]);
+      }
+    }, num_threads_);
+    block = std::move(result);
+    return true;
+  } // ... cholesky_qr(...)
+
+  /**
+   * \brief The fallback: orthonormalizes the vectors of block one by one (CGS2) and appends them to orthonormal.
+   */
+  void classical_gram_schmidt(std::vector< VectorType >& orthonormal,
+                              std::vector< VectorType >& block,
+                              const std::vector< double >& initial_norms,
+                              const ProductApplyType& product,
+                              const size_t first,
+                              std::vector< size_t >& removed) const
+  {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.la.gramschmidt.classical_gram_schmidt");
+    for (size_t kk = 0; kk < block.size(); ++kk) {
+      std::vector< VectorType > vector;
+      vector.emplace_back(std::move(block[kk]));
+      for (size_t pass = 0; pass < 2; ++pass)
+        project(orthonormal, vector, product);
+      const AppliedBlock applied(vector, product, 1);
+      const double norm = std::sqrt(std::max(0.0, double(vector[0].dot(applied[0]))));
+      if (norm < std::max(atol_, rtol_*initial_norms[kk])) {
+        removed.push_back(first + kk);
+        continue;
+      }
+      vector[0].scal(1.0/norm);
+      orthonormal.emplace_back(std::move(vector[0]));
+    }
+  } // ... classical_gram_schmidt(...)
+
+  /**
+   * \brief CholQR2 is only stable for blocks with a condition below the inverse of the square root of the machine
+   *        precision, we stay well below.
+   */
+  static double cholesky_qr_tolerance()
+  {
+    return 1e-5;
+  }
+
+  const double atol_;
+  const double rtol_;
+  const size_t block_size_;
+  const size_t num_threads_;
+}; // class GramSchmidt
+
+
+/**
+ * \brief Returns an orthonormalized copy of basis (the first offset vectors are assumed to be orthonormal already).
+ * \see   GramSchmidt
+ */
+template< class VectorType >
+std::vector< VectorType > gram_schmidt(const std::vector< VectorType >& basis,
+                                       const DUNE_STUFF_SSIZE_T offset = 0,
+                                       const double atol = 1e-13,
+                                       const double rtol = 1e-13)
+{
+  if (offset < 0)
+    DUNE_THROW(Stuff::Exceptions::index_out_of_range, "offset has to be nonnegative (is " << offset << ")!");
+  std::vector< VectorType > ret;
+  ret.reserve(basis.size());
+  for (const auto& vector : basis)
+    ret.emplace_back(vector.copy());
+  GramSchmidt< VectorType >(atol, rtol).orthonormalize(ret, offset);
+  return ret;
+} // ... gram_schmidt(...)
+
+template< class VectorType, class ProductTraits >
+std::vector< VectorType > gram_schmidt(const std::vector< VectorType >& basis,
+                                       const OperatorInterface< ProductTraits >& product,
+                                       const Parameter mu = Parameter(),
+                                       const DUNE_STUFF_SSIZE_T offset = 0,
+                                       const double atol = 1e-13,
+                                       const double rtol = 1e-13)
+{
+  if (offset < 0)
+    DUNE_THROW(Stuff::Exceptions::index_out_of_range, "offset has to be nonnegative (is " << offset << ")!");
+  std::vector< VectorType > ret;
+  ret.reserve(basis.size());
+  for (const auto& vector : basis)
+    ret.emplace_back(vector.copy());
+  GramSchmidt< VectorType >(atol, rtol).orthonormalize(ret, product, mu, offset);
+  return ret;
+} // ... gram_schmidt(...)
+
+
+} // namespace LA
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_LA_GRAM_SCHMIDT_HH
@@ -0,0 +1,201 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_LA_LOCALIZATION_HH
+#define DUNE_PYMOR_LA_LOCALIZATION_HH
+
+#include <utility>
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/common/threading.hh>
+#include <dune/pymor/common/tracing.hh>
+
+namespace Dune {
+namespace Pymor {
+namespace LA {
+
+
+/**
+ * \brief Scatters global vectors to subdomain vectors and gathers them back, given the precomputed global index of
+ *        each local DoF of each subdomain.
+ *
+ *        All batched methods work on all subdomains in parallel. Block vectors are stored subdomain-major, i.e.
+ *        blocks[ss][ii] is the restriction of the ii-th global vector to subdomain ss. Overlapping subdomains may be
+ *        localized, but only disjoint ones can be globalized.
+ *
+ *        A multiscale discretization is supposed to build this once (when its subdomain spaces are known) and to
+ *        forward localize_vectors() and globalize_vectors() to it, which are then picked up by the python bindings
+ *        (\see inject_StationaryMultiscaleDiscretizationImplementation).
+ */
+template< class VectorImp >
+class SubdomainLocalization
+{
+public:
+  typedef VectorImp                                   VectorType;
+  typedef std::vector< std::vector< VectorType > >    BlockVectorsType;
+  typedef std::vector< std::vector< size_t > >        IndexMapsType;
+
+  /**
+   * \param global_indices global_indices[ss][ii] is the global index of the ii-th local DoF of subdomain ss
+   */
+  SubdomainLocalization(const size_t global_size, IndexMapsType global_indices, const size_t num_threads = 0)
+    : global_size_(global_size)
+    , global_indices_(std::move(global_indices))
+    , num_threads_(num_threads)
+    , disjoint_(true)
+  {
+    std::vector< bool > covered(global_size_, false);
+    for (size_t ss = 0; ss < global_indices_.size(); ++ss)
+      for (const size_t& index : global_indices_[ss]) {
+        if (index >= global_size_)
+          DUNE_THROW(Stuff::Exceptions::index_out_of_range,
+                     "global index " << index << " of subdomain " << ss << " is not smaller than " << global_size_
+                     << "!");
+        if (covered[index])
+          disjoint_ = false;
+        covered[index] = true;
+      }
+  } // SubdomainLocalization(...)
+
+  size_t num_subdomains() const
+  {
+    return global_indices_.size();
+  }
+
+  size_t global_size() const
+  {
+    return global_size_;
+  }
+
+  size_t local_size(const size_t ss) const
+  {
+    check_subdomain(ss);
+    return global_indices_[ss].size();
+  }
+
+  const std::vector< size_t >& global_indices(const size_t ss) const
+  {
+    check_subdomain(ss);
+    return global_indices_[ss];
+  }
+
+  bool disjoint() const
+  {
+    return disjoint_;
+  }
+
+  VectorType localize_vector(const VectorType& global_vector, const size_t ss) const
+  {
+    check_subdomain(ss);
+    check_global_size(global_vector);
+    return restrict(global_vector, global_indices_[ss]);
+  }
+
+  /**
+   * \brief Returns the restrictions of all global_vectors to all subdomains, \see BlockVectorsType.
+   */
+  BlockVectorsType localize_vectors(const std::vector< VectorType >& global_vectors) const
+  {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.la.subdomain_localization.localize");
+    for (const auto& global_vector : global_vectors)
+      check_global_size(global_vector);
+    BlockVectorsType blocks(num_subdomains());
+    parallel_for(0, num_subdomains(), [&](const size_t first, const size_t last) {
+      for (size_t ss = first; ss < last; ++ss) {
+        blocks[ss].reserve(global_vectors.size());
+        for (const auto& global_vector : global_vectors)
+          blocks[ss].emplace_back(restrict(global_vector, global_indices_[ss]));
+      }
+    }, num_threads_);
+    return blocks;
+  } // ... localize_vectors(...)
+
+  /**
+   * \brief Assembles one global vector from one local vector per subdomain.
+   */
+  VectorType globalize_vectors(const std::vector< VectorType >& local_vectors) const
+  {
+    BlockVectorsType blocks(local_vectors.size());
+    for (size_t ss = 0; ss < local_vectors.size(); ++ss)
+      blocks[ss].emplace_back(local_vectors[ss].copy());
+    return globalize_vectors(blocks)[0];
+  }
+
+  /**
+   * \brief Assembles the global vectors from their restrictions to all subdomains, \see BlockVectorsType.
+   */
+  std::vector< VectorType > globalize_vectors(const BlockVectorsType& blocks) const
+  {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.la.subdomain_localization.globalize");
+    if (!disjoint_)
+      DUNE_THROW(Stuff::Exceptions::you_are_using_this_wrong, "Only disjoint subdomains can be globalized!");
+    if (blocks.size() != num_subdomains())
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "blocks.size() has to be " << num_subdomains() << " (is " << blocks.size() << ")!");
+    const size_t num_vectors = blocks.empty() ? 0 : blocks[0].size();
+    for (size_t ss = 0; ss < blocks.size(); ++ss) {
+      if (blocks[ss].size() != num_vectors)
+        DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                   "blocks[" << ss << "].size() has to be " << num_vectors << " (is " << blocks[ss].size() << ")!");
+      for (const auto& local_vector : blocks[ss])
+        if (local_vector.dim() != global_indices_[ss].size())
+          DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                     "the vectors of subdomain " << ss << " have to be of size " << global_indices_[ss].size()
+                     << " (is " << local_vector.dim() << ")!");
+    }
+    // create each vector on its own, copies might share their data until the first write
+    std::vector< VectorType > global_vectors;
+    global_vectors.reserve(num_vectors);
+    for (size_t ii = 0; ii < num_vectors; ++ii)
+      global_vectors.emplace_back(global_size_, 0.0);
+    // the subdomains are disjoint, so each entry is written by one thread only
+    parallel_for(0, num_subdomains(), [&](const size_t first, const size_t last) {
+      for (size_t ss = first; ss < last; ++ss) {
+        const auto& indices = global_indices_[ss];
+        for (size_t ii = 0; ii < num_vectors; ++ii)
+          for (size_t jj = 0; jj < indices.size(); ++jj)
+            global_vectors[ii].set_entry(indices[jj], blocks[ss][ii].get_entry(jj));
+      }
+    }, num_threads_);
+    return global_vectors;
+  } // ... globalize_vectors(...)
+
+private:
+  static VectorType restrict(const VectorType& global_vector, const std::vector< size_t >& indices)
+  {
+    VectorType local_vector(indices.size(), 0.0);
+    for (size_t jj = 0; jj < indices.size(); ++jj)
+      local_vector.set_entry(jj, global_vector.get_entry(indices[jj]));
+    return local_vector;
+  }
+
+  void check_subdomain(const size_t ss) const
+  {
+    if (ss >= num_subdomains())
+      DUNE_THROW(Stuff::Exceptions::index_out_of_range,
+                 "ss has to be smaller than " << num_subdomains() << " (is " << ss << ")!");
+  }
+
+  void check_global_size(const VectorType& global_vector) const
+  {
+    if (global_vector.dim() != global_size_)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "global vectors have to be of size " << global_size_ << " (is " << global_vector.dim() << ")!");
+  }
+
+  const size_t global_size_;
+  const IndexMapsType global_indices_;
+  const size_t num_threads_;
+  bool disjoint_;
+}; // class SubdomainLocalization
+
+
+} // namespace LA
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_LA_LOCALIZATION_HH
@@ -0,0 +1,302 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_LA_POD_HH
+#define DUNE_PYMOR_LA_POD_HH
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/common/threading.hh>
+#include <dune/pymor/common/tracing.hh>
+#include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/operators/interfaces.hh>
+
+#include "eigensolver.hh"
+#include "gram_schmidt.hh"
+
+namespace Dune {
+namespace Pymor {
+namespace LA {
+
+
+/**
+ * \brief Proper orthogonal decomposition of a set of snapshots by the method of snapshots.
+ *
+ *        The Gram matrix of the snapshots (with respect to the euclidean or a given product) is assembled in blocks of
+ *        snapshots, in parallel and only its upper triangle is computed. The modes are given by the eigenvectors of the
+ *        Gram matrix to all eigenvalues whose square root (the singular value) is larger than
+ *        max(atol, rtol*(the largest singular value)), but at most max_modes, and are formed by one linear combination
+ *        of the snapshots per mode (in parallel). Since the method of snapshots squares the condition, the modes are
+ *        orthonormalized afterwards (\see GramSchmidt) if orthonormalize is true.
+ *
+ *        In addition to compute(), snapshots may be given in chunks to extend(): each chunk is compressed together
+ *        with the current modes scaled by their singular values (an incremental hierarchical POD), so that only the
+ *        modes and a single chunk have to be held in memory at once. The truncation errors of the single steps add up,
+ *        so rtol and atol should be chosen slightly smaller than for compute(). Usage example:
+\code
+Pod< VectorType > pod(20, 1e-6);
+pod.set_product(discretization.get_product("h1"));
+for (const auto& chunk_of_parameters : chunks_of_training_set)
+  pod.extend(solve_all(chunk_of_parameters));
+const auto& modes = pod.modes();
+\endcode
+ */
+template< class VectorImp >
+class Pod
+{
+public:
+  typedef VectorImp                                              VectorType;
+  typedef std::function< void(const VectorType&, VectorType&) >  ProductApplyType;
+
+  /**
+   * \param max_modes the maximal number of modes, 0 for no limit
+   */
+  Pod(const DUNE_STUFF_SSIZE_T max_modes = 0,
+      const double rtol = 4e-8,
+      const double atol = 0.0,
+      const bool orthonormalize = true,
+      const size_t block_size = 32,
+      const size_t num_threads = 0)
+    : max_modes_(max_modes)
+    , rtol_(rtol)
+    , atol_(atol)
+    , orthonormalize_(orthonormalize)
+    , block_size_(block_size)
+    , num_threads_(num_threads == 0 ? default_num_threads() : num_threads)
+    , num_snapshots_(0)
+  {
+    if (max_modes_ < 0)
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "max_modes has to be nonnegative (is " << max_modes_ << ")!");
+    if (!(rtol_ >= 0.0) || !(atol_ >= 0.0))
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+                 "rtol (" << rtol_ << ") and atol (" << atol_ << ") have to be nonnegative!");
+    if (block_size_ == 0)
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "block_size must not be 0!");
+  } // Pod(...)
+
+  /**
+   * \brief Uses the given product for all subsequent computations, a parametric product is frozen for mu.
+   * \note  A nonparametric product has to outlive this object.
+   */
+  template< class ProductTraits >
+  void set_product(const OperatorInterface< ProductTraits >& product, const Parameter mu = Parameter())
+  {
+    if (product.parametric()) {
+      typedef typename OperatorInterface< ProductTraits >::FrozenType FrozenType;
+      const std::shared_ptr< const FrozenType > frozen_product(new FrozenType(product.freeze_parameter(mu)));
+      product_ = [frozen_product](const VectorType& source, VectorType& range) {
+        frozen_product->apply(source, range);
+      };
+    } else
+      product_ = [&product, mu](const VectorType& source, VectorType& range) { product.apply(source, range, mu); };
+  } // ... set_product(...)
+
+  /**
+   * \brief Uses the product given by its application, the euclidean product if product is empty.
+   * \note  product is called concurrently from several threads.
+   */
+  void set_product(const ProductApplyType& product)
+  {
+    product_ = product;
+  }
+
+  /**
+   * \brief Computes the POD of snapshots, discarding all previous modes.
+   */
+  void compute(const std::vector< VectorType >& snapshots)
+  {
+    modes_.clear();
+    singular_values_.clear();
+    num_snapshots_ = 0;
+    extend(snapshots);
+  }
+
+  /**
+   * \brief Computes the POD of the current modes (scaled by their singular values) and snapshots.
+   */
+  void extend(const std::vector< VectorType >& snapshots)
+  {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.la.pod.extend");
+    std::vector< const VectorType* > vectors;
+    std::vector< double > scales;
+    vectors.reserve(modes_.size() + snapshots.size());
+    scales.reserve(modes_.size() + snapshots.size());
+    for (size_t ii = 0; ii < modes_.size(); ++ii) {
+      vectors.push_back(&modes_[ii]);
+      scales.push_back(singular_values_[ii]);
+    }
+    for (const auto& snapshot : snapshots) {
+      vectors.push_back(&snapshot);
+      scales.push_back(1.0);
+    }
+    num_snapshots_ += snapshots.size();
+    if (vectors.empty())
+      return;
+    // the current modes are orthonormal, so the upper left part of the gram matrix is known
+    const size_t num_known = orthonormalize_ ? modes_.size() : 0;
+    std::vector< VectorType > modes;
+    std::vector< double > singular_values;
+    decompose(vectors, scales, num_known, modes, singular_values);
+    modes_ = std::move(modes);
+    singular_values_ = std::move(singular_values);
+  } // ... extend(...)
+
+  const std::vector< VectorType >& modes() const
+  {
+    return modes_;
+  }
+
+  const std::vector< double >& singular_values() const
+  {
+    return singular_values_;
+  }
+
+  /**
+   * \brief The number of snapshots given to compute() and extend() so far.
+   */
+  size_t num_snapshots() const
+  {
+    return num_snapshots_;
+  }
+
+private:
+  void decompose(const std::vector< const VectorType* >& vectors,
+                 const std::vector< double >& scales,
+                 const size_t num_known,
+                 std::vector< VectorType >& modes,
+                 std::vector< double >& singular_values) const
+  {
+    const size_t num_vectors = vectors.size();
+    const auto gram = gram_matrix(vectors, scales, num_known);
+    std::vector< double > eigenvalues;
+    std::vector< double > eigenvectors;
+    symmetric_eigendecomposition(gram, num_vectors, eigenvalues, eigenvectors);
+    // the eigenvalues are sorted ascending
+    const double max_singular_value = std::sqrt(std::max(0.0, eigenvalues[num_vectors - 1]));
+    const double tolerance = std::max(atol_, rtol_*max_singular_value);
+    std::vector< size_t > selected;
+    for (size_t ii = num_vectors; ii > 0; --ii) {
+      const double singular_value = std::sqrt(std::max(0.0, eigenvalues[ii - 1]));
+      if (!(singular_value > tolerance) || (max_modes_ > 0 && selected.size() >= size_t(max_modes_)))
+        break;
+      selected.push_back(ii - 1);
+      singular_values.push_back(singular_value);
+    }
+    // mode_rr = sum_jj (eigenvector_rr)_jj * scale_jj * vector_jj / singular_value_rr
+    modes.resize(selected.size());
+    parallel_for(0, selected.size(), [&](const size_t first, const size_t last) {
+      for (size_t rr = first; rr < last; ++rr) {
+        const size_t column = selected[rr];
+        const double factor = 1.0/singular_values[rr];
+        modes[rr] = vectors[0]->copy();
+        modes[rr].scal(eigenvectors[column]*scales[0]*factor);
+        for (size_t jj = 1; jj < num_vectors; ++jj)
+          modes[rr].axpy(eigenvectors[jj*num_vectors + column]*scales[jj]*factor, *vectors[jj]);
+      }
+    }, num_threads_);
+    if (orthonormalize_ && !modes.empty()) {
+      std::vector< size_t > removed;
+      GramSchmidt< VectorType >(0.0, rtol_, block_size_, num_threads_).orthonormalize(modes, product_, 0, removed);
+      // the removed modes need not be the last ones
+      for (auto index = removed.rbegin(); index != removed.rend(); ++index)
+        singular_values.erase(singular_values.begin() + *index);
+    }
+  } // ... decompose(...)
+
+  /**
+   * \brief The scaled gram matrix (scales_ii * scales_jj * (vectors_ii, vectors_jj))_ii,jj, where the first
+   *        num_known vectors are assumed to be orthonormal.
+   */
+  std::vector< double > gram_matrix(const std::vector< const VectorType* >& vectors,
+                                    const std::vector< double >& scales,
+                                    const size_t num_known) const
+  {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.la.pod.gram_matrix");
+    const size_t num_vectors = vectors.size();
+    std::vector< double > gram(num_vectors*num_vectors, 0.0);
+    for (size_t ii = 0; ii < num_known; ++ii)
+      gram[ii*num_vectors + ii] = scales[ii]*scales[ii];
+    for (size_t first_column = num_known; first_column < num_vectors; first_column += block_size_) {
+      const size_t last_column = std::min(first_column + block_size_, num_vectors);
+      // apply the product to the block of columns once
+      std::vector< VectorType > applied;
+      if (product_) {
+        applied.resize(last_column - first_column);
+        parallel_for(first_column, last_column, [&](const size_t first, const size_t last) {
+          for (size_t jj = first; jj < last; ++jj) {
+            applied[jj - first_column] = vectors[jj]->copy();
+            product_(*vectors[jj], applied[jj - first_column]);
+          }
+        }, num_threads_);
+      }
+      // the upper triangle of all rows up to this block, the rows are interleaved among the threads to balance the
+      // work
+      const size_t num_threads = std::min(num_threads_, last_column);
+      parallel_for(0, num_threads, [&](const size_t first_thread, const size_t last_thread) {
+        for (size_t tt = first_thread; tt < last_thread; ++tt)
+          for (size_t ii = tt; ii < last_column; ii += num_threads)
+            for (size_t jj = std::max(ii, first_column); jj < last_column; ++jj) {
+              const VectorType& column = product_ ? applied[jj - first_column] : *vectors[jj];
+              gram[ii*num_vectors + jj] = gram[jj*num_vectors + ii] = scales[ii]*scales[jj]*vectors[ii]->dot(column);
+            }
+      }, num_threads);
+    }
+    return gram;
+  } // ... gram_matrix(...)
+
+  const DUNE_STUFF_SSIZE_T max_modes_;
+  const double rtol_;
+  const double atol_;
+  const bool orthonormalize_;
+  const size_t block_size_;
+  const size_t num_threads_;
+  ProductApplyType product_;
+  std::vector< VectorType > modes_;
+  std::vector< double > singular_values_;
+  size_t num_snapshots_;
+}; // class Pod
+
+
+/**
+ * \brief Returns the POD modes of snapshots with respect to the euclidean product.
+ * \see   Pod
+ */
+template< class VectorType >
+std::vector< VectorType > pod(const std::vector< VectorType >& snapshots,
+                              const DUNE_STUFF_SSIZE_T max_modes = 0,
+                              const double rtol = 4e-8,
+                              const double atol = 0.0)
+{
+  Pod< VectorType > decomposition(max_modes, rtol, atol);
+  decomposition.compute(snapshots);
+  return decomposition.modes();
+}
+
+template< class VectorType, class ProductTraits >
+std::vector< VectorType > pod(const std::vector< VectorType >& snapshots,
+                              const OperatorInterface< ProductTraits >& product,
+                              const Parameter mu = Parameter(),
+                              const DUNE_STUFF_SSIZE_T max_modes = 0,
+                              const double rtol = 4e-8,
+                              const double atol = 0.0)
+{
+  Pod< VectorType > decomposition(max_modes, rtol, atol);
+  decomposition.set_product(product, mu);
+  decomposition.compute(snapshots);
+  return decomposition.modes();
+}
+
+
+} // namespace LA
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_LA_POD_HH
@@ -5,6 +5,7 @@
 # License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
 
 from collections import OrderedDict
+import weakref
 
 import pybindgen
 from pybindgen import retval, param
@@ -15,6 +16,8 @@ from pymor.vectorarrays.list import ListVectorArray
 from pymor.operators.basic import OperatorBase
 from pymor.operators.constructions import LincombOperator
 
+from dune.pymor.common.threading import AsyncResult
+
 
 def inject_OperatorAndInverseImplementation(module, exceptions, interfaces, CONFIG_H,
                                             operator_name,
@@ -118,79 +121,86 @@ def inject_OperatorAndInverseImplementation(module, exceptions, interfaces, CONF
     Operator.add_method('apply', None,
                         [param('const ' + operator_SourceType + ' &', 'source'),
                          param(operator_RangeType + ' &', 'range')],
-                        is_const=True, throw=exceptions)
+                        is_const=True, throw=exceptions, unblock_threads=True)
     Operator.add_method('apply', None,
                         [param('const ' + operator_SourceType + ' &', 'source'),
                          param(operator_RangeType + ' &', 'range'),
                          param('Dune::Pymor::Parameter', 'mu')],
-                        is_const=True, throw=exceptions)
+                        is_const=True, throw=exceptions, unblock_threads=True)
     Operator.add_method('apply_and_return_ptr',
                         retval(operator_RangeType + ' *', caller_owns_return=True),
                         [param('const ' + operator_SourceType + ' &', 'source')],
-                        is_const=True, throw=exceptions, custom_name='apply')
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply')
     Operator.add_method('apply_and_return_ptr',
                         retval(operator_RangeType + ' *', caller_owns_return=True),
                         [param('const ' + operator_SourceType + ' &', 'source'),
                          param('Dune::Pymor::Parameter', 'mu')],
-                        is_const=True, throw=exceptions, custom_name='apply')
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply')
+    Operator.add_method('apply_async_and_return_ptr',
+                        retval('Dune::Pymor::AsyncResult< ' + operator_RangeType + ' > *', caller_owns_return=True),
+                        [param('const ' + operator_SourceType + ' &', 'source'),
+                         param('Dune::Pymor::Parameter', 'mu')],
+                        is_const=True, throw=exceptions, custom_name='apply_async')
     Operator.add_method('apply2', operator_ScalarType,
                         [param('const ' + operator_RangeType + ' &', 'range'),
                          param('const ' + operator_SourceType + ' &', 'source')],
-                        is_const=True, throw=exceptions)
+                        is_const=True, throw=exceptions, unblock_threads=True)
     Operator.add_method('apply2', operator_ScalarType,
                         [param('const ' + operator_RangeType + ' &', 'range'),
                          param('const ' + operator_SourceType + ' &', 'source'),
                          param('Dune::Pymor::Parameter', 'mu')],
-                        is_const=True, throw=exceptions)
+                        is_const=True, throw=exceptions, unblock_threads=True)
     Operator.add_method('invert_options',
                         retval('std::vector< std::string >'),
                         [], is_const=True, is_static=True, throw=exceptions)
     Operator.add_method('invert_and_return_ptr',
                         retval(operator_InverseType + ' *', caller_owns_return=True),
-                        [], is_const=True, throw=exceptions, custom_name='invert')
+                        [], is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Operator.add_method('invert_and_return_ptr',
                         retval(operator_InverseType + ' *', caller_owns_return=True),
                         [param('const std::string', 'option')],
-                        is_const=True, throw=exceptions, custom_name='invert')
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Operator.add_method('invert_and_return_ptr',
                         retval(operator_InverseType + ' *', caller_owns_return=True),
                         [param('const std::string', 'option'),
                          param('Dune::Pymor::Parameter', 'mu')],
-                        is_const=True, throw=exceptions, custom_name='invert')
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Operator.add_method('apply_inverse', None,
                         [param('const ' + operator_RangeType + ' &', 'range'),
                          param(operator_SourceType + ' &', 'source')],
-                        is_const=True, throw=exceptions)
+                        is_const=True, throw=exceptions, unblock_threads=True)
     Operator.add_method('apply_inverse', None,
                         [param('const ' + operator_RangeType + ' &', 'range'),
                          param(operator_SourceType + ' &', 'source'),
                          param('const std::string', 'option')],
-                        is_const=True, throw=exceptions)
+                        is_const=True, throw=exceptions, unblock_threads=True)
     Operator.add_method('apply_inverse', None,
                         [param('const ' + operator_RangeType + ' &', 'range'),
                          param(operator_SourceType + ' &', 'source'),
                          param('const std::string', 'option'),
                          param('const Dune::Pymor::Parameter', 'mu')],
-                        is_const=True, throw=exceptions)
+                        is_const=True, throw=exceptions, unblock_threads=True)
     Operator.add_method('apply_inverse_and_return_ptr',
                         retval(operator_SourceType + ' *', caller_owns_return=True),
                         [param('const ' + operator_RangeType + ' &', 'range')],
-                        is_const=True, throw=exceptions, custom_name='apply_inverse')
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
     Operator.add_method('apply_inverse_and_return_ptr',
                         retval(operator_SourceType + ' *', caller_owns_return=True),
                         [param('const ' + operator_RangeType + ' &', 'range'),
                          param('const std::string', 'option')],
-                        is_const=True, throw=exceptions, custom_name='apply_inverse')
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
     Operator.add_method('apply_inverse_and_return_ptr',
                         retval(operator_SourceType + ' *', caller_owns_return=True),
                         [param('const ' + operator_RangeType + ' &', 'range'),
                          param('const std::string', 'option'),
                          param('const Dune::Pymor::Parameter', 'mu')],
-                        is_const=True, throw=exceptions, custom_name='apply_inverse')
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
     Operator.add_method('freeze_parameter_and_return_ptr',
                         retval(operator_FrozenType + ' *', caller_owns_return=True),
                         [param('Dune::Pymor::Parameter', 'mu')],
-                        is_const=True, throw=exceptions, custom_name='freeze_parameter')
+                        is_const=True, throw=exceptions, unblock_threads=True, custom_name='freeze_parameter')
+    Operator.add_method('memory_footprint', retval('Dune::Pymor::MemoryFootprint'), [],
+                        is_const=True, throw=exceptions)
     if container_based:
         Operator.add_method('pb_container',
                             retval(operator_ContainerType + '*', caller_owns_return=True),
@@ -213,79 +223,79 @@ def inject_OperatorAndInverseImplementation(module, exceptions, interfaces, CONF
     Inverse.add_method('apply', None,
                        [param('const ' + inverse_SourceType + ' &', 'source'),
                         param(inverse_RangeType + ' &', 'range')],
-                       is_const=True, throw=exceptions)
+                       is_const=True, throw=exceptions, unblock_threads=True)
     Inverse.add_method('apply', None,
                        [param('const ' + inverse_SourceType + ' &', 'source'),
                         param(inverse_RangeType + ' &', 'range'),
                         param('Dune::Pymor::Parameter', 'mu')],
-                       is_const=True, throw=exceptions)
+                       is_const=True, throw=exceptions, unblock_threads=True)
     Inverse.add_method('apply_and_return_ptr',
                        retval(inverse_RangeType + ' *', caller_owns_return=True),
                        [param('const ' + inverse_SourceType + ' &', 'source')],
-                       is_const=True, throw=exceptions, custom_name='apply')
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply')
     Inverse.add_method('apply_and_return_ptr',
                        retval(inverse_RangeType + ' *', caller_owns_return=True),
                        [param('const ' + inverse_SourceType + ' &', 'source'),
                         param('Dune::Pymor::Parameter', 'mu')],
-                       is_const=True, throw=exceptions, custom_name='apply')
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply')
     Inverse.add_method('apply2', inverse_ScalarType,
                        [param('const ' + inverse_RangeType + ' &', 'range'),
                         param('const ' + inverse_SourceType + ' &', 'source')],
-                       is_const=True, throw=exceptions)
+                       is_const=True, throw=exceptions, unblock_threads=True)
     Inverse.add_method('apply2', inverse_ScalarType,
                        [param('const ' + inverse_RangeType + ' &', 'range'),
                         param('const ' + inverse_SourceType + ' &', 'source'),
                         param('Dune::Pymor::Parameter', 'mu')],
-                       is_const=True, throw=exceptions)
+                       is_const=True, throw=exceptions, unblock_threads=True)
     Inverse.add_method('invert_options',
                        retval('std::vector< std::string >'),
                        [], is_const=True, throw=exceptions)
     Inverse.add_method('invert_and_return_ptr',
                        retval(inverse_InverseType + ' *', caller_owns_return=True),
-                       [], is_const=True, throw=exceptions, custom_name='invert')
+                       [], is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Inverse.add_method('invert_and_return_ptr',
                        retval(inverse_InverseType + ' *', caller_owns_return=True),
                        [param('const std::string', 'option')],
-                       is_const=True, throw=exceptions, custom_name='invert')
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Inverse.add_method('invert_and_return_ptr',
                        retval(inverse_InverseType + ' *', caller_owns_return=True),
                        [param('const std::string', 'option'),
                         param('Dune::Pymor::Parameter', 'mu')],
-                       is_const=True, throw=exceptions, custom_name='invert')
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Inverse.add_method('apply_inverse', None,
                        [param('const ' + inverse_RangeType + ' &', 'range'),
                         param(inverse_SourceType + ' &', 'source')],
-                       is_const=True, throw=exceptions)
+                       is_const=True, throw=exceptions, unblock_threads=True)
     Inverse.add_method('apply_inverse', None,
                        [param('const ' + inverse_RangeType + ' &', 'range'),
                         param(inverse_SourceType + ' &', 'source'),
                         param('const std::string', 'option')],
-                       is_const=True, throw=exceptions)
+                       is_const=True, throw=exceptions, unblock_threads=True)
     Inverse.add_method('apply_inverse', None,
                        [param('const ' + inverse_RangeType + ' &', 'range'),
                         param(inverse_SourceType + ' &', 'source'),
                         param('const std::string', 'option'),
                         param('const Dune::Pymor::Parameter', 'mu')],
-                       is_const=True, throw=exceptions)
+                       is_const=True, throw=exceptions, unblock_threads=True)
     Inverse.add_method('apply_inverse_and_return_ptr',
                        retval(inverse_SourceType + ' *', caller_owns_return=True),
                        [param('const ' + inverse_RangeType + ' &', 'range')],
-                       is_const=True, throw=exceptions, custom_name='apply_inverse')
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
     Inverse.add_method('apply_inverse_and_return_ptr',
                        retval(inverse_SourceType + ' *', caller_owns_return=True),
                        [param('const ' + inverse_RangeType + ' &', 'range'),
                         param('const std::string', 'option')],
-                       is_const=True, throw=exceptions, custom_name='apply_inverse')
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
     Inverse.add_method('apply_inverse_and_return_ptr',
                        retval(inverse_SourceType + ' *', caller_owns_return=True),
                        [param('const ' + inverse_RangeType + ' &', 'range'),
                         param('const std::string', 'option'),
                         param('const Dune::Pymor::Parameter', 'mu')],
-                       is_const=True, throw=exceptions, custom_name='apply_inverse')
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
     Inverse.add_method('freeze_parameter_and_return_ptr',
                        retval(inverse_FrozenType + ' *', caller_owns_return=True),
                        [param('Dune::Pymor::Parameter', 'mu')],
-                       is_const=True, throw=exceptions, custom_name='freeze_parameter')
+                       is_const=True, throw=exceptions, unblock_threads=True, custom_name='freeze_parameter')
     return Operator, Inverse
 
 
@@ -325,6 +335,23 @@ class WrappedOperatorBase(OperatorBase):
             return ListVectorArray([self.vec_type_range(self._impl.apply(v._impl)) for v in vectors],
                                    subtype=self.range.subtype)
 
+    def apply_async(self, U, ind=None, mu=None):
+        """Starts applying the operator to each vector in C++, result() of the returned AsyncResult is the same as the
+        one of apply().
+        """
+        assert U in self.source
+        if ind is not None and not isinstance(ind, list):
+            ind = [ind]
+        vectors = U._list if ind is None else [U._list[i] for i in ind]
+        if self.parametric:
+            mu = self._wrapper.dune_parameter(self.strip_parameter(mu))
+        else:
+            mu = self._wrapper.DuneParameter()
+        return AsyncResult([self._impl.apply_async(v._impl, mu) for v in vectors],
+                           lambda results: ListVectorArray([self.vec_type_range(r) for r in results],
+                                                           subtype=self.range.subtype),
+                           owner=self)
+
     def apply_inverse(self, U, ind=None, mu=None, options=None, least_squares=False):
         assert not least_squares
         assert U in self.range
@@ -355,6 +382,9 @@ def wrap_operator(cls, wrapper):
         vec_type_range = wrapper[cls.type_range()]
         _wrapper = wrapper
 
+        # weak reference to the wrapped affinely decomposed operator this operator is a component of, if any
+        _affine_operator = None
+
         def __init__(self, op):
             WrappedOperatorBase.__init__(self, op)
 
@@ -368,6 +398,13 @@ def wrap_operator(cls, wrapper):
         def assemble_lincomb(self, operators, coefficients, solver_options=None, name=None):
             assert len(operators) > 0
             assert len(operators) == len(coefficients)
+            # pyMOR calls this on the first operator of a lincomb, so a lincomb of the components of an affinely
+            # decomposed operator is handed on to it to be assembled in one C++ call
+            affine_operator = self._affine_operator() if self._affine_operator is not None else None
+            if affine_operator is not None:
+                op = affine_operator.assemble_lincomb(operators, coefficients, solver_options=solver_options, name=name)
+                if op is not None:
+                    return op
             matrix = operators[0]._impl.container()
             matrix.scal(coefficients[0])
             for op, c in izip(operators[1:], coefficients[1:]):
@@ -460,79 +497,95 @@ def inject_LinearAffinelyDecomposedContainerBasedImplementation(module,
     Class.add_method('apply', None,
                      [param('const ' + SourceType + ' &', 'source'),
                       param(RangeType + ' &', 'range')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('apply', None,
                      [param('const ' + SourceType + ' &', 'source'),
                       param(RangeType + ' &', 'range'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('apply_and_return_ptr',
                      retval(RangeType + ' *', caller_owns_return=True),
                      [param('const ' + SourceType + ' &', 'source')],
-                     is_const=True, throw=exceptions, custom_name='apply')
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply')
     Class.add_method('apply_and_return_ptr',
                      retval(RangeType + ' *', caller_owns_return=True),
                      [param('const ' + SourceType + ' &', 'source'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions, custom_name='apply')
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply')
+    Class.add_method('apply_async_and_return_ptr',
+                     retval('Dune::Pymor::AsyncResult< ' + RangeType + ' > *', caller_owns_return=True),
+                     [param('const ' + SourceType + ' &', 'source'),
+                      param('Dune::Pymor::Parameter', 'mu')],
+                     is_const=True, throw=exceptions, custom_name='apply_async')
+    Class.add_method('apply_lincomb_and_return_ptr',
+                     retval(RangeType + ' *', caller_owns_return=True),
+                     [param('const std::vector< double > &', 'coefficients'),
+                      param('const ' + SourceType + ' &', 'source')],
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_lincomb')
     Class.add_method('apply2', ScalarType,
                      [param('const ' + RangeType + ' &', 'range'),
                       param('const ' + SourceType + ' &', 'source')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('apply2', ScalarType,
                      [param('const ' + RangeType + ' &', 'range'),
                       param('const ' + SourceType + ' &', 'source'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('invert_options',
                      retval('std::vector< std::string >'),
                      [], is_const=True, throw=exceptions)
     Class.add_method('invert_and_return_ptr',
                      retval(InverseType + ' *', caller_owns_return=True),
-                     [], is_const=True, throw=exceptions, custom_name='invert')
+                     [], is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Class.add_method('invert_and_return_ptr',
                      retval(InverseType + ' *', caller_owns_return=True),
                      [param('const std::string', 'option')],
-                     is_const=True, throw=exceptions, custom_name='invert')
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Class.add_method('invert_and_return_ptr',
                      retval(InverseType + ' *', caller_owns_return=True),
                      [param('const std::string', 'option'),
                       param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions, custom_name='invert')
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='invert')
     Class.add_method('apply_inverse', None,
                      [param('const ' + RangeType + ' &', 'range'),
                       param(SourceType + ' &', 'source')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('apply_inverse', None,
                      [param('const ' + RangeType + ' &', 'range'),
                       param(SourceType + ' &', 'source'),
                       param('const std::string', 'option')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('apply_inverse', None,
                      [param('const ' + RangeType + ' &', 'range'),
                       param(SourceType + ' &', 'source'),
                       param('const std::string', 'option'),
                       param('const Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions)
+                     is_const=True, throw=exceptions, unblock_threads=True)
     Class.add_method('apply_inverse_and_return_ptr',
                      retval(SourceType + ' *', caller_owns_return=True),
                      [param('const ' + RangeType + ' &', 'range')],
-                     is_const=True, throw=exceptions, custom_name='apply_inverse')
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
     Class.add_method('apply_inverse_and_return_ptr',
                      retval(SourceType + ' *', caller_owns_return=True),
                      [param('const ' + RangeType + ' &', 'range'),
                       param('const std::string', 'option')],
-                     is_const=True, throw=exceptions, custom_name='apply_inverse')
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
     Class.add_method('apply_inverse_and_return_ptr',
                      retval(SourceType + ' *', caller_owns_return=True),
                      [param('const ' + RangeType + ' &', 'range'),
                       param('const std::string', 'option'),
                       param('const Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions, custom_name='apply_inverse')
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='apply_inverse')
     Class.add_method('freeze_parameter_and_return_ptr',
                      retval(FrozenType + ' *', caller_owns_return=True),
                      [param('Dune::Pymor::Parameter', 'mu')],
-                     is_const=True, throw=exceptions, custom_name='freeze_parameter')
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='freeze_parameter')
+    Class.add_method('assemble_lincomb_and_return_ptr',
+                     retval(FrozenType + ' *', caller_owns_return=True),
+                     [param('const std::vector< double > &', 'coefficients')],
+                     is_const=True, throw=exceptions, unblock_threads=True, custom_name='assemble_lincomb')
+    Class.add_method('memory_footprint', retval('Dune::Pymor::MemoryFootprint'), [],
+                     is_const=True, throw=exceptions)
     return Class
 
 
@@ -550,6 +603,10 @@ def wrap_affinely_decomposed_operator(cls, wrapper):
                 operators.append(self._wrapper[op.affine_part()])
                 coefficients.append(1.)
             LincombOperator.__init__(self, operators, coefficients)
+            for operator in operators:
+                operator.unlock()
+                operator._affine_operator = weakref.ref(self)
+                operator.lock()
 
         def with_(self, **kwargs):
             assert 'operators' in kwargs or 'name' in kwargs
@@ -570,5 +627,56 @@ def wrap_affinely_decomposed_operator(cls, wrapper):
             op = self._impl.freeze_parameter(mu)
             return self._wrapper[op].with_(name=self.name + '_assembled')
 
+        def _native_coefficients(self, coefficients):
+            # the coefficients of the components, the affine part (which is always last) has the coefficient 1
+            coefficients = list(coefficients)
+            if self._impl.has_affine_part():
+                if coefficients[-1] != 1.:
+                    return None
+                coefficients = coefficients[:-1]
+            return [float(c) for c in coefficients]
+
+        def apply(self, U, ind=None, mu=None):
+            # one call per vector, the thetas are evaluated and the components are combined in C++
+            assert U in self.source
+            if ind is not None and not isinstance(ind, list):
+                ind = [ind]
+            vectors = U._list if ind is None else [U._list[i] for i in ind]
+            vec_type_range = self.operators[0].vec_type_range
+            if self.parametric:
+                mu = self._wrapper.dune_parameter(self.strip_parameter(mu))
+                return ListVectorArray([vec_type_range(self._impl.apply(v._impl, mu)) for v in vectors],
+                                       subtype=self.range.subtype)
+            else:
+                return ListVectorArray([vec_type_range(self._impl.apply(v._impl)) for v in vectors],
+                                       subtype=self.range.subtype)
+
+        def apply_async(self, U, ind=None, mu=None):
+            assert U in self.source
+            if ind is not None and not isinstance(ind, list):
+                ind = [ind]
+            vectors = U._list if ind is None else [U._list[i] for i in ind]
+            vec_type_range = self.operators[0].vec_type_range
+            if self.parametric:
+                mu = self._wrapper.dune_parameter(self.strip_parameter(mu))
+            else:
+                mu = self._wrapper.DuneParameter()
+            return AsyncResult([self._impl.apply_async(v._impl, mu) for v in vectors],
+                               lambda results: ListVectorArray([vec_type_range(r) for r in results],
+                                                               subtype=self.range.subtype),
+                               owner=self)
+
+        def assemble_lincomb(self, operators, coefficients, solver_options=None, name=None):
+            # only a lincomb of the own components can be assembled in one call, pyMOR reaches this through the
+            # assemble_lincomb of the first component
+            if len(operators) != len(self.operators) or any(a is not b for a, b in izip(operators, self.operators)):
+                return None
+            native_coefficients = self._native_coefficients(coefficients)
+            if native_coefficients is None:
+                return None
+            op = self._wrapper[self._impl.assemble_lincomb(native_coefficients)]
+            op = op.with_(solver_options=solver_options) if solver_options else op
+            return op.with_(name=name) if name else op
+
     WrappedOperator.__name__ = cls.__name__
     return WrappedOperator
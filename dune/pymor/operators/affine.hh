@@ -6,12 +6,16 @@
 #ifndef DUNE_PYMOR_OPERATORS_AFFINE_HH
 #define DUNE_PYMOR_OPERATORS_AFFINE_HH
 
+#include <memory>
 #include <type_traits>
+#include <vector>
+
+#include <boost/numeric/conversion/cast.hpp>
 
-#include <dune/stuff/common/profiler.hh>
 #include <dune/stuff/la/container.hh>
 #include <dune/stuff/la/container/interfaces.hh>
 
+#include <dune/pymor/common/tracing.hh>
 #include <dune/pymor/la/container/affine.hh>
 
 #include "base.hh"
@@ -118,18 +122,60 @@ public:
 
   void apply(const SourceType& source, RangeType& range, const Parameter mu = Parameter()) const
   {
-    DUNE_STUFF_PROFILE_SCOPE(static_id() + ".apply");
+    DUNE_PYMOR_TRACE_SCOPE("pymor.operators.linearaffinelydecomposedcontainerbased.apply");
     if (mu.type() != Parametric::parameter_type())
       DUNE_THROW(Exceptions::wrong_parameter_type, "the type of mu (" << mu.type()
                  << ") does not match the parameter_type of this (" << Parametric::parameter_type() << ")!");
     if (!Parametric::parametric())
       ComponentType(affinelyDecomposedContainer_.affine_part()).apply(source, range);
     else
-      freeze_parameter(mu).apply(source, range);
+      apply_lincomb(affinelyDecomposedContainer_.thetas().evaluate(mu), source, range);
   }
 
   using BaseType::apply;
 
+  /**
+   * \brief Applies the sum of the affine part and the components weighted by coefficients, without assembling it.
+   */
+  void apply_lincomb(const std::vector< double >& coefficients, const SourceType& source, RangeType& range) const
+  {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.operators.linearaffinelydecomposedcontainerbased.apply_lincomb");
+    const DUNE_STUFF_SSIZE_T num_components = affinelyDecomposedContainer_.num_components();
+    if (coefficients.size() != boost::numeric_cast< size_t >(num_components))
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "coefficients.size() has to be " << num_components << " (is " << coefficients.size() << ")!");
+    if (source.pb_dim() != dim_source())
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the dim of source (" << source.pb_dim() << ") does not match the dim_source of this ("
+                 << dim_source() << ")!");
+    if (range.pb_dim() != dim_range())
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the dim of range (" << range.pb_dim() << ") does not match the dim_range of this ("
+                 << dim_range() << ")!");
+    DUNE_STUFF_SSIZE_T qq = 0;
+    if (affinelyDecomposedContainer_.has_affine_part())
+      affinelyDecomposedContainer_.affine_part()->mv(source, range);
+    else {
+      affinelyDecomposedContainer_.component(0)->mv(source, range);
+      range.scal(coefficients[0]);
+      ++qq;
+    }
+    if (qq < num_components) {
+      RangeType tmp(dim_range());
+      for (; qq < num_components; ++qq) {
+        affinelyDecomposedContainer_.component(qq)->mv(source, tmp);
+        range.axpy(coefficients[qq], tmp);
+      }
+    }
+  } // ... apply_lincomb(...)
+
+  RangeType* apply_lincomb_and_return_ptr(const std::vector< double >& coefficients, const SourceType& source) const
+  {
+    std::unique_ptr< RangeType > range(new RangeType(dim_range()));
+    apply_lincomb(coefficients, source, *range);
+    return range.release();
+  }
+
   static std::vector< std::string > invert_options()
   {
     return ComponentType::invert_options();
@@ -142,17 +188,32 @@ public:
 
   InverseType invert(const Stuff::Common::Configuration& option, const Parameter mu = Parameter()) const
   {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.operators.linearaffinelydecomposedcontainerbased.invert");
     return freeze_parameter(mu).invert(option);
   }
 
   FrozenType freeze_parameter(const Parameter mu = Parameter()) const
   {
-    DUNE_STUFF_PROFILE_SCOPE(static_id() + ".freeze_parameter");
+    DUNE_PYMOR_TRACE_SCOPE("pymor.operators.linearaffinelydecomposedcontainerbased.freeze_parameter");
     if (mu.type() != Parametric::parameter_type())
       DUNE_THROW(Exceptions::wrong_parameter_type,
                  "the type of mu (" << mu.type() << ") does not match the parameter_type of this ("
                  << Parametric::parameter_type() << ")!");
-    return FrozenType(new MatrixImp(affinelyDecomposedContainer_.freeze_parameter(mu)));
+    return FrozenType(affinelyDecomposedContainer_.freeze_parameter_ptr(mu));
+  }
+
+  /**
+   * \brief Assembles the sum of the affine part and the components weighted by coefficients.
+   */
+  FrozenType assemble_lincomb(const std::vector< double >& coefficients) const
+  {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.operators.linearaffinelydecomposedcontainerbased.assemble_lincomb");
+    return FrozenType(affinelyDecomposedContainer_.lincomb_ptr(coefficients));
+  }
+
+  FrozenType* assemble_lincomb_and_return_ptr(const std::vector< double >& coefficients) const
+  {
+    return new FrozenType(assemble_lincomb(coefficients));
   }
 
   const AffinelyDecomposedContainerType& container() const
@@ -160,6 +221,13 @@ public:
     return affinelyDecomposedContainer_;
   }
 
+  void memory_footprint(MemoryFootprint& footprint, const std::string prefix = "") const
+  {
+    affinelyDecomposedContainer_.memory_footprint(footprint, prefix);
+  }
+
+  using BaseType::memory_footprint;
+
 private:
   AffinelyDecomposedContainerType affinelyDecomposedContainer_;
   DUNE_STUFF_SSIZE_T dim_source_;
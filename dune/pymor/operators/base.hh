@@ -9,11 +9,14 @@
 #include <type_traits>
 
 #include <dune/stuff/common/exceptions.hh>
-#include <dune/stuff/common/profiler.hh>
 #include <dune/stuff/la/container.hh>
 #include <dune/stuff/la/container/interfaces.hh>
 #include <dune/stuff/la/solver.hh>
 
+#include <dune/pymor/common/memory.hh>
+#include <dune/pymor/common/tracing.hh>
+#include <dune/pymor/la/container/memory.hh>
+
 #include "interfaces.hh"
 
 namespace Dune {
@@ -141,6 +144,7 @@ public:
       DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
                  "the dim of range (" << range.pb_dim() << ") does not match the dim_range of this ("
                  << dim_range() << ")!");
+    DUNE_PYMOR_TRACE_SCOPE("pymor.operators.matrixbasedinversedefault.apply");
     LinearSolverType(*matrix_).apply(source, range, options_);
   } // ... apply(...)
 
@@ -180,6 +184,13 @@ public:
     return FrozenType(nullptr, invert_options()[0]);
   } // ... freeze_parameter(...)
 
+  void memory_footprint(MemoryFootprint& footprint, const std::string prefix = "") const
+  {
+    Pymor::LA::memory_footprint(*matrix_, footprint, MemoryFootprint::join(prefix, "matrix"));
+  }
+
+  using BaseType::memory_footprint;
+
 private:
   std::shared_ptr< const MatrixType > matrix_;
   const Stuff::Common::Configuration options_;
@@ -244,7 +255,7 @@ public:
 
   void apply(const SourceType& source, RangeType& range, const Parameter mu = Parameter()) const
   {
-    DUNE_STUFF_PROFILE_SCOPE(static_id() + ".apply");
+    DUNE_PYMOR_TRACE_SCOPE("pymor.operators.matrixbaseddefault.apply");
     if (!mu.empty()) DUNE_THROW(Exceptions::this_is_not_parametric,
                                 "mu has to be empty if parametric() == false (is " << mu << ")!");
     if (source.pb_dim() != dim_source())
@@ -292,6 +303,13 @@ public:
     return FrozenType(nullptr);
   } // ... freeze_parameter(...)
 
+  void memory_footprint(MemoryFootprint& footprint, const std::string prefix = "") const
+  {
+    Pymor::LA::memory_footprint(*matrix_, footprint, MemoryFootprint::join(prefix, "matrix"));
+  }
+
+  using BaseType::memory_footprint;
+
   std::shared_ptr< const ContainerType > container() const
   {
     return matrix_;
@@ -6,15 +6,19 @@
 #ifndef DUNE_PYMOR_OPERATORS_INTERFACES_HH
 #define DUNE_PYMOR_OPERATORS_INTERFACES_HH
 
+#include <memory>
+
 #include <dune/stuff/common/configuration.hh>
 #include <dune/stuff/common/crtp.hh>
-#include <dune/stuff/common/profiler.hh>
 #include <dune/stuff/common/timedlogging.hh>
 #include <dune/stuff/common/type_utils.hh>
 #include <dune/stuff/la/container/interfaces.hh>
 #include <dune/stuff/la/solver.hh>
 
 #include <dune/pymor/common/exceptions.hh>
+#include <dune/pymor/common/memory.hh>
+#include <dune/pymor/common/threading.hh>
+#include <dune/pymor/common/tracing.hh>
 #include <dune/pymor/parameters/base.hh>
 #include <dune/pymor/parameters/functional.hh>
 
@@ -95,7 +99,7 @@ public:
 
   RangeType apply(const SourceType& source, const Parameter mu = Parameter()) const
   {
-    DUNE_STUFF_PROFILE_SCOPE(static_id() + ".apply");
+    DUNE_PYMOR_TRACE_SCOPE("pymor.operators.interface.apply");
     RangeType range(dim_range());
     apply(source, range, mu);
     return range;
@@ -103,7 +107,25 @@ public:
 
   RangeType* apply_and_return_ptr(const SourceType& source, const Parameter mu = Parameter()) const
   {
-    return new RangeType(apply(source, mu));
+    std::unique_ptr< RangeType > range(new RangeType(dim_range()));
+    apply(source, *range, mu);
+    return range.release();
+  }
+
+  /**
+   * \brief Applies the operator to a copy of source on the default_thread_pool(), the operator has to outlive the
+   *        computation.
+   */
+  AsyncResult< RangeType > apply_async(const SourceType& source, const Parameter mu = Parameter()) const
+  {
+    const auto* self = this;
+    const SourceType source_copy = source.copy();
+    return run_async< RangeType >([self, source_copy, mu]() { return self->apply_and_return_ptr(source_copy, mu); });
+  }
+
+  AsyncResult< RangeType >* apply_async_and_return_ptr(const SourceType& source, const Parameter mu = Parameter()) const
+  {
+    return new AsyncResult< RangeType >(apply_async(source, mu));
   }
 
   /**
@@ -155,6 +177,7 @@ public:
                      const std::string type = invert_options()[0],
                      const Parameter mu = Parameter()) const
   {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.operators.interface.apply_inverse");
     auto logger = DSC::TimedLogger().get("dune.pymor.operators.interfaces.apply_inverse");
     logger.info() << "inverting ";
     if (!mu.empty())
@@ -168,6 +191,7 @@ public:
                      const Stuff::Common::Configuration& option,
                      const Parameter mu = Parameter()) const
   {
+    DUNE_PYMOR_TRACE_SCOPE("pymor.operators.interface.apply_inverse");
     invert(option, mu).apply(range, source);
   }
 
@@ -193,14 +217,18 @@ public:
                                            const std::string type = invert_options()[0],
                                            const Parameter mu = Parameter()) const
   {
-    return new SourceType(apply_inverse(range, type, mu));
+    std::unique_ptr< SourceType > source(new SourceType(dim_source()));
+    apply_inverse(range, *source, type, mu);
+    return source.release();
   }
 
   SourceType* apply_inverse_and_return_ptr(const RangeType& range,
                                            const Stuff::Common::Configuration& option,
                                            const Parameter mu = Parameter()) const
   {
-    return new SourceType(apply_inverse(range, option, mu));
+    std::unique_ptr< SourceType > source(new SourceType(dim_source()));
+    apply_inverse(range, *source, option, mu);
+    return source.release();
   }
 
   /**
@@ -216,6 +244,20 @@ public:
   {
     return new FrozenType(freeze_parameter(mu));
   }
+
+  /**
+   * \brief Adds the storage of this operator to footprint, the names of all entries are prefixed by prefix.
+   * \note  This default reports nothing, derived classes owning storage should implement it.
+   */
+  void memory_footprint(MemoryFootprint& /*footprint*/, const std::string /*prefix*/ = "") const
+  {}
+
+  MemoryFootprint memory_footprint() const
+  {
+    MemoryFootprint footprint;
+    this->as_imp(*this).memory_footprint(footprint, "");
+    return footprint;
+  }
 }; // class OperatorInterface
 
 
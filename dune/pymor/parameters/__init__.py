@@ -7,3 +7,5 @@ from __future__ import absolute_import
 
 from .base import inject_ParameterType, inject_Parameter, inject_Parametric
 from .functional import inject_ParameterFunctional
+from .sampling import inject_ParameterBatch, inject_ParameterSampler
+from .thetas import inject_ThetaBundle
@@ -0,0 +1,197 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include <algorithm>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/common/exceptions.hh>
+
+#include "batch.hh"
+
+namespace Dune {
+namespace Pymor {
+namespace internal {
+
+
+static size_t serialized_size_of(const ParameterType& tt)
+{
+  size_t ret = 0;
+  for (const auto& value : tt.values())
+    ret += value;
+  return ret;
+}
+
+
+} // namespace internal
+
+
+ParameterBatch::ParameterBatch()
+  : type_()
+  , serialized_size_(0)
+  , size_(0)
+{}
+
+ParameterBatch::ParameterBatch(const ParameterType& tt)
+  : type_(tt)
+  , serialized_size_(internal::serialized_size_of(tt))
+  , size_(0)
+{}
+
+ParameterBatch::ParameterBatch(const ParameterType& tt, std::vector< double >&& values)
+  : type_(tt)
+  , serialized_size_(internal::serialized_size_of(tt))
+  , size_(0)
+  , values_(std::move(values))
+{
+  if (serialized_size_ == 0) {
+    if (!values_.empty())
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match, "values has to be empty for an empty tt!");
+  } else {
+    if (values_.size() % serialized_size_ != 0)
+      DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                 "the size of values (" << values_.size() << ") is not a multiple of the serialized size of tt ("
+                 << serialized_size_ << ")!");
+    size_ = values_.size() / serialized_size_;
+  }
+} // ParameterBatch(...)
+
+ParameterBatch::ParameterBatch(const ParameterType& tt, const std::vector< double >& values)
+  : ParameterBatch(tt, std::vector< double >(values))
+{}
+
+ParameterBatch::ParameterBatch(const std::vector< Parameter >& mus)
+  : ParameterBatch(mus.empty() ? ParameterType() : mus[0].type())
+{
+  reserve(mus.size());
+  for (const auto& mu : mus)
+    append(mu);
+}
+
+const ParameterType& ParameterBatch::type() const
+{
+  return type_;
+}
+
+DUNE_STUFF_SSIZE_T ParameterBatch::size() const
+{
+  return size_;
+}
+
+bool ParameterBatch::empty() const
+{
+  return size_ == 0;
+}
+
+DUNE_STUFF_SSIZE_T ParameterBatch::serialized_size() const
+{
+  return serialized_size_;
+}
+
+void ParameterBatch::reserve(const DUNE_STUFF_SSIZE_T num_parameters)
+{
+  if (num_parameters < 0)
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given, "num_parameters has to be nonnegative (is " << num_parameters
+               << ")!");
+  values_.reserve(num_parameters*serialized_size_);
+}
+
+void ParameterBatch::append(const Parameter& mu)
+{
+  if (mu.type() != type_)
+    DUNE_THROW(Pymor::Exceptions::wrong_parameter_type,
+               "the type of mu (" << mu.type() << ") does not match the type of this batch (" << type_ << ")!");
+  for (const auto& key : mu.keys()) {
+    const auto& value = mu.get(key);
+    values_.insert(values_.end(), value.begin(), value.end());
+  }
+  ++size_;
+} // ... append(...)
+
+void ParameterBatch::append(const ParameterBatch& other)
+{
+  if (other.type_ != type_)
+    DUNE_THROW(Pymor::Exceptions::wrong_parameter_type,
+               "the type of other (" << other.type_ << ") does not match the type of this batch (" << type_ << ")!");
+  values_.insert(values_.end(), other.values_.begin(), other.values_.end());
+  size_ += other.size_;
+}
+
+void ParameterBatch::append_serialized(const std::vector< double >& values)
+{
+  if (values.size() != serialized_size_)
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+               "values has to be of size " << serialized_size_ << " (is " << values.size() << ")!");
+  values_.insert(values_.end(), values.begin(), values.end());
+  ++size_;
+}
+
+const double* ParameterBatch::data() const
+{
+  return values_.data();
+}
+
+const double* ParameterBatch::serialized(const DUNE_STUFF_SSIZE_T ii) const
+{
+  check_index(ii);
+  return values_.data() + ii*serialized_size_;
+}
+
+const std::vector< double >& ParameterBatch::values() const
+{
+  return values_;
+}
+
+Parameter ParameterBatch::parameter(const DUNE_STUFF_SSIZE_T ii) const
+{
+  check_index(ii);
+  return deserialize(type_, values_.data() + ii*serialized_size_);
+}
+
+std::vector< Parameter > ParameterBatch::parameters() const
+{
+  std::vector< Parameter > ret;
+  ret.reserve(size_);
+  for (size_t ii = 0; ii < size_; ++ii)
+    ret.emplace_back(deserialize(type_, values_.data() + ii*serialized_size_));
+  return ret;
+}
+
+Parameter ParameterBatch::deserialize(const ParameterType& tt, const double* values)
+{
+  if (tt.empty())
+    return Parameter();
+  std::vector< Parameter::ValueType > mu_values;
+  mu_values.reserve(tt.size());
+  for (const auto& key : tt.keys()) {
+    const size_t value_size = tt.get(key);
+    mu_values.emplace_back(values, values + value_size);
+    values += value_size;
+  }
+  return Parameter(tt, mu_values);
+} // ... deserialize(...)
+
+Parameter ParameterBatch::deserialize(const ParameterType& tt, const std::vector< double >& values)
+{
+  const size_t serialized_size = internal::serialized_size_of(tt);
+  if (values.size() != serialized_size)
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+               "the size of values (" << values.size() << ") does not match the serialized size of tt ("
+               << serialized_size << ")!");
+  return deserialize(tt, values.data());
+}
+
+void ParameterBatch::check_index(const DUNE_STUFF_SSIZE_T ii) const
+{
+  if (ii < 0 || ii >= size())
+    DUNE_THROW(Stuff::Exceptions::index_out_of_range,
+               "the condition 0 <= " << ii << " < size() = " << size() << " is not satisfied!");
+}
+
+
+} // namespace Pymor
+} // namespace Dune
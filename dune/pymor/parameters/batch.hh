@@ -0,0 +1,108 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_PARAMETERS_BATCH_HH
+#define DUNE_PYMOR_PARAMETERS_BATCH_HH
+
+#include <vector>
+
+#include "base.hh"
+
+namespace Dune {
+namespace Pymor {
+
+
+/**
+ * \brief A set of parameters of the same ParameterType, stored as one contiguous array of serialized parameters.
+ *
+ *        The ii-th parameter occupies data()[ii*serialized_size(), (ii + 1)*serialized_size()), its values are ordered
+ *        just like in Parameter::serialize(). A batch can thus be handed to ThetaBundle::evaluate_serialized() without
+ *        creating a single Parameter.
+ * \see   Dune::Pymor::ParameterSampler
+ */
+class ParameterBatch
+{
+public:
+  /**
+   * \brief Empty constructor to please pybindgen.
+   */
+  ParameterBatch();
+
+  explicit ParameterBatch(const ParameterType& tt);
+
+  /**
+   * \brief Takes ownership of values, which has to contain a multiple of the serialized size of tt.
+   */
+  ParameterBatch(const ParameterType& tt, std::vector< double >&& values);
+
+  ParameterBatch(const ParameterType& tt, const std::vector< double >& values);
+
+  /**
+   * \brief Serializes all mus, which have to be of the same (nonempty) type.
+   */
+  explicit ParameterBatch(const std::vector< Parameter >& mus);
+
+  const ParameterType& type() const;
+
+  DUNE_STUFF_SSIZE_T size() const;
+
+  bool empty() const;
+
+  /**
+   * \brief The length of a single serialized parameter.
+   */
+  DUNE_STUFF_SSIZE_T serialized_size() const;
+
+  void reserve(const DUNE_STUFF_SSIZE_T num_parameters);
+
+  void append(const Parameter& mu);
+
+  void append(const ParameterBatch& other);
+
+  /**
+   * \brief Appends a parameter given by its serialized_size() values.
+   */
+  void append_serialized(const std::vector< double >& values);
+
+  const double* data() const;
+
+  /**
+   * \brief Points to the serialized_size() values of the ii-th parameter.
+   */
+  const double* serialized(const DUNE_STUFF_SSIZE_T ii) const;
+
+  /**
+   * \brief The concatenation of all serialized parameters.
+   */
+  const std::vector< double >& values() const;
+
+  Parameter parameter(const DUNE_STUFF_SSIZE_T ii) const;
+
+  std::vector< Parameter > parameters() const;
+
+  /**
+   * \brief Creates a Parameter of type tt from its serialized values.
+   */
+  static Parameter deserialize(const ParameterType& tt, const double* values);
+
+  /**
+   * \brief Creates a Parameter of type tt from its serialized values, which have to be exactly as many as required.
+   */
+  static Parameter deserialize(const ParameterType& tt, const std::vector< double >& values);
+
+private:
+  void check_index(const DUNE_STUFF_SSIZE_T ii) const;
+
+  ParameterType type_;
+  size_t serialized_size_;
+  size_t size_;
+  std::vector< double > values_;
+}; // class ParameterBatch
+
+
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_PARAMETERS_BATCH_HH
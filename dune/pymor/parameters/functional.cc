@@ -7,11 +7,13 @@
 
 #include <limits>
 #include <sstream>
+#include <cctype>
 
 #include <dune/stuff/common/print.hh>
 #include <dune/stuff/common/exceptions.hh>
 
 #include <dune/pymor/common/exceptions.hh>
+#include <dune/pymor/common/tracing.hh>
 
 #include "functional.hh"
 
@@ -23,16 +25,41 @@ ParameterFunctional::ParameterFunctional(const ParameterType& tt, const std::str
   : Parametric(tt)
   , expression_(exp)
   , actual_size_(DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE)
+  , direct_read_(false)
+  , direct_component_(0)
+  , direct_index_(0)
+  , op_(nullptr)
 {
   setup();
 }
 
+ParameterFunctional::ParameterFunctional(const ParameterType& tt,
+                                         const FunctionType& function,
+                                         const std::string& description)
+  : Parametric(tt)
+  , expression_(description)
+  , function_(std::make_shared< const FunctionType >(function))
+  , actual_size_(DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE)
+  , direct_read_(false)
+  , direct_component_(0)
+  , direct_index_(0)
+  , op_(nullptr)
+{
+  if (!function)
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given, "function must not be empty!");
+  setup();
+}
+
 ParameterFunctional::ParameterFunctional(const std::string& kk,
                                          const DUNE_STUFF_SSIZE_T & vv,
                                          const std::string& exp)
   : Parametric(ParameterType(kk, vv))
   , expression_(exp)
   , actual_size_(DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE)
+  , direct_read_(false)
+  , direct_component_(0)
+  , direct_index_(0)
+  , op_(nullptr)
 {
   setup();
 }
@@ -43,6 +70,10 @@ ParameterFunctional::ParameterFunctional(const std::vector< std::string >& kk,
   : Parametric(ParameterType(kk, vv))
   , expression_(exp)
   , actual_size_(DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE)
+  , direct_read_(false)
+  , direct_component_(0)
+  , direct_index_(0)
+  , op_(nullptr)
 {
   setup();
 }
@@ -50,7 +81,12 @@ ParameterFunctional::ParameterFunctional(const std::vector< std::string >& kk,
 ParameterFunctional::ParameterFunctional(const ParameterFunctional& other)
   : Parametric(other.parameter_type())
   , expression_(other.expression_)
+  , function_(other.function_)
   , actual_size_(DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE)
+  , direct_read_(false)
+  , direct_component_(0)
+  , direct_index_(0)
+  , op_(nullptr)
 {
   setup();
 }
@@ -66,6 +102,7 @@ ParameterFunctional& ParameterFunctional::operator=(const ParameterFunctional& o
     cleanup();
     replace_parameter_type(other.parameter_type());
     expression_ = other.expression_;
+    function_ = other.function_;
     setup();
   }
   return *this;
@@ -73,7 +110,9 @@ ParameterFunctional& ParameterFunctional::operator=(const ParameterFunctional& o
 
 bool ParameterFunctional::operator==(const ParameterFunctional& other) const
 {
-  return (parameter_type() == other.parameter_type() && expression_ == other.expression());
+  return (parameter_type() == other.parameter_type()
+          && expression_ == other.expression()
+          && function_ == other.function_);
 }
 
 bool ParameterFunctional::operator!=(const ParameterFunctional& other) const
@@ -86,6 +125,11 @@ const std::string& ParameterFunctional::expression() const
   return expression_;
 }
 
+bool ParameterFunctional::callable() const
+{
+  return bool(function_);
+}
+
 std::string ParameterFunctional::report(const std::string name) const
 {
   return name + ": " + Parametric::parameter_type().report() + " -> \"" + expression_ + "\"";
@@ -93,21 +137,55 @@ std::string ParameterFunctional::report(const std::string name) const
 
 void ParameterFunctional::evaluate(const Parameter& mu, double& ret) const
 {
+  DUNE_PYMOR_TRACE_SCOPE("pymor.parameters.parameterfunctional.evaluate");
   if (mu.type() != parameter_type())
     DUNE_THROW(Pymor::Exceptions::wrong_parameter_type,
                "the type of mu (" << mu.type().report() << ") does not match the parameter_type of this ("
                << parameter_type().report() << ")!");
-  // parse argument
-  const auto serialized_mu = mu.serialize();
-  assert(serialized_mu.size() == actual_size_);
+  if (function_) {
+    ret = (*function_)(mu);
+  } else if (direct_read_) {
+    ret = mu.get(direct_key_)[direct_component_];
+  } else {
+    // parse argument
+    const auto serialized_mu = mu.serialize();
+    assert(serialized_mu.size() == actual_size_);
+    ret = evaluate_serialized(serialized_mu.data());
+  }
+  check_value(ret, mu);
+} // ... evaluate(...)
+
+double ParameterFunctional::evaluate(const Parameter& mu) const
+{
+  double ret = 0.0;
+  evaluate(mu, ret);
+  return ret;
+}
+
+double ParameterFunctional::evaluate_serialized(const double* values) const
+{
+  if (function_) {
+    const ParameterType& type = parameter_type();
+    std::vector< Parameter::ValueType > mu_values;
+    for (const auto& key : type.keys()) {
+      mu_values.emplace_back(values, values + type.get(key));
+      values += type.get(key);
+    }
+    return (*function_)(Parameter(type, mu_values));
+  }
+  if (direct_read_)
+    return values[direct_index_];
+  std::lock_guard< std::mutex > lock(mutex_);
   for (size_t ii = 0; ii < actual_size_; ++ii)
-    *(arg_[ii]) = serialized_mu[ii];
-  // copy ret
-  ret = op_->Val();
-  // perform sanity check
-  if (std::abs(ret) > (0.9 * std::numeric_limits< double >::max())) {
+    *(arg_[ii]) = values[ii];
+  return op_->Val();
+} // ... evaluate_serialized(...)
+
+void ParameterFunctional::check_value(const double& value, const Parameter& mu) const
+{
+  if (std::abs(value) > (0.9 * std::numeric_limits< double >::max())) {
     std::stringstream ss;
-    for (size_t ii = 0; ii < actual_size_; ++ii)
+    for (size_t ii = 0; ii < variables_.size() && ii < actual_size_; ++ii)
       ss << "  " << variables_[ii] << std::endl;
     DUNE_THROW(Stuff::Exceptions::internal_error,
                "evaluating this functional yielded an unlikely value!\n"
@@ -115,19 +193,63 @@ void ParameterFunctional::evaluate(const Parameter& mu, double& ret) const
                << "The variables of this functional are:\n" << ss.str()
                << "The expression of this functional is:\n  " << expression_ << "\n"
                << "You tried to evaluate it with:\n  mu = " << mu << "\n"
-               << "The result was:\n  " << ret);
+               << "The result was:\n  " << value);
   }
-} // ... evaluate(...)
+} // ... check_value(...)
 
-double ParameterFunctional::evaluate(const Parameter& mu) const
+bool ParameterFunctional::setup_direct_read()
 {
-  double ret = 0.0;
-  evaluate(mu, ret);
-  return ret;
-}
+  // strip whitespace
+  std::string exp;
+  for (const char& cc : expression_)
+    if (!std::isspace(static_cast< unsigned char >(cc)))
+      exp.push_back(cc);
+  // check for something like key[ii]
+  const size_t open = exp.find('[');
+  if (open == std::string::npos || open == 0 || exp.size() < open + 3 || exp.back() != ']')
+    return false;
+  const std::string key = exp.substr(0, open);
+  const std::string index = exp.substr(open + 1, exp.size() - open - 2);
+  if (index.find_first_not_of("0123456789") != std::string::npos)
+    return false;
+  const ParameterType& type = parameter_type();
+  if (!type.hasKey(key))
+    return false;
+  const size_t component = std::stoul(index);
+  if (component >= size_t(type.get(key)))
+    return false;
+  // compute the position of this component in the serialized parameter
+  size_t offset = 0;
+  for (const auto& kk : type.keys()) {
+    if (kk == key)
+      break;
+    offset += type.get(kk);
+  }
+  size_t total_size = 0;
+  for (const auto& vv : type.values())
+    total_size += vv;
+  direct_read_ = true;
+  direct_key_ = key;
+  direct_component_ = component;
+  direct_index_ = offset + component;
+  actual_size_ = total_size;
+  return true;
+} // ... setup_direct_read(...)
 
 void ParameterFunctional::setup()
 {
+  op_ = nullptr;
+  direct_read_ = false;
+  variables_.clear();
+  if (function_) {
+    actual_size_ = 0;
+    for (const auto& vv : parameter_type().values())
+      actual_size_ += vv;
+    return;
+  }
+  // the most common case does not require the interpreter
+  if (setup_direct_read())
+    return;
   // create variables from parameter type
   const ParameterType& type = parameter_type();
   for (auto variable_prefix : type.keys()) {
@@ -160,11 +282,14 @@ void ParameterFunctional::setup()
 
 void ParameterFunctional::cleanup()
 {
+  if (op_ == nullptr)
+    return;
   delete op_;
   for (size_t ii = 0; ii < DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE; ++ii) {
     delete var_arg_[ii];
     delete arg_[ii];
   }
+  op_ = nullptr;
 } // void cleanup()
 
 
@@ -8,6 +8,8 @@
 
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <functional>
 
 #include <dune/stuff/functions/expression/mathexpr.hh>
 
@@ -21,17 +23,33 @@ namespace Dune {
 namespace Pymor {
 
 
+// forward, to allow for friendship
+class ThetaBundle;
+
+
 /**
  * \note Given a ParameterType with keys "foo" and "bar" of sizes 2 and 1, respectively, there are the following
  *       variables available for the expression: foo[0], foo[1] and bar[0]. Note that scalar parameter components are
  *       also indexed by []!
+ * \note Expressions which only read a single component of the parameter (e.g. "foo[1]") are detected upon construction
+ *       and evaluated without the expression interpreter.
+ * \note A functional may also be given by a function (e.g. the coefficients of an empirical interpolation), in which
+ *       case expression() only describes it. Such functionals cannot be written to disk.
  */
 class ParameterFunctional
   : public Parametric
 {
 public:
+  typedef std::function< double(const Parameter&) > FunctionType;
+
   ParameterFunctional(const ParameterType& tt, const std::string& exp);
 
+  /**
+   * \brief A functional evaluating function, description is returned by expression().
+   * \note  Two such functionals are only equal if they are copies of each other.
+   */
+  ParameterFunctional(const ParameterType& tt, const FunctionType& function, const std::string& description);
+
   ParameterFunctional(const std::string& kk, const DUNE_STUFF_SSIZE_T & vv, const std::string& exp);
 
   ParameterFunctional(const std::vector< std::string >& kk,
@@ -50,6 +68,11 @@ public:
 
   const std::string& expression() const;
 
+  /**
+   * \brief Whether this functional is given by a function instead of an expression.
+   */
+  bool callable() const;
+
   std::string report(const std::string name = "ParameterFunctional") const;
 
   void evaluate(const Parameter& mu, double& ret) const;
@@ -57,13 +80,32 @@ public:
   double evaluate(const Parameter& mu) const;
 
 private:
+  friend class ThetaBundle;
+
+  /**
+   * \brief Evaluates the functional for the serialized parameter values (which have to be given in the order of the
+   *        variables of this functional).
+   */
+  double evaluate_serialized(const double* values) const;
+
+  void check_value(const double& value, const Parameter& mu) const;
+
+  bool setup_direct_read();
+
   void setup();
 
   void cleanup();
 
   std::string expression_;
+  std::shared_ptr< const FunctionType > function_;
   size_t actual_size_;
+  bool direct_read_;
+  std::string direct_key_;
+  size_t direct_component_;
+  size_t direct_index_;
   std::vector< std::string > variables_;
+  //! guards arg_, which the expression reads its variables from
+  mutable std::mutex mutex_;
   mutable double* arg_[DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE];
   RVar* var_arg_[DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE];
   RVar* vararray_[DUNE_PYMOR_PARAMETERS_FUNCTIONAL_MAX_SIZE];
@@ -0,0 +1,373 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <algorithm>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/common/exceptions.hh>
+#include <dune/pymor/common/tracing.hh>
+
+#include "sampling.hh"
+
+namespace Dune {
+namespace Pymor {
+namespace internal {
+
+
+/**
+ * \brief The direction numbers of Joe and Kuo (new-joe-kuo-6.21201) for the dimensions 2, ..., 16: the degree s and
+ *        the coefficients a of the primitive polynomial and the initial numbers m_1, ..., m_s.
+ */
+struct SobolDirections
+{
+  unsigned int s;
+  unsigned int a;
+  unsigned int m[6];
+};
+
+static const SobolDirections sobol_directions[] = {{1,  0, {1}},
+                                                   {2,  1, {1, 3}},
+                                                   {3,  1, {1, 3, 1}},
+                                                   {3,  2, {1, 1, 1}},
+                                                   {4,  1, {1, 1, 3, 3}},
+                                                   {4,  4, {1, 3, 5, 13}},
+                                                   {5,  2, {1, 1, 5, 5, 17}},
+                                                   {5,  4, {1, 1, 5, 5, 5}},
+                                                   {5,  7, {1, 1, 7, 11, 19}},
+                                                   {5, 11, {1, 1, 5, 1, 1}},
+                                                   {5, 13, {1, 1, 1, 3, 11}},
+                                                   {5, 14, {1, 3, 5, 5, 31}},
+                                                   {6,  1, {1, 3, 3, 9, 7, 49}},
+                                                   {6, 13, {1, 1, 1, 15, 21, 21}},
+                                                   {6, 16, {1, 3, 1, 13, 27, 49}}};
+
+static const size_t sobol_bits = 32;
+
+static std::vector< uint32_t > sobol_direction_numbers(const size_t dd)
+{
+  std::vector< uint32_t > vv(sobol_bits);
+  if (dd == 0) {
+    for (size_t kk = 0; kk < sobol_bits; ++kk)
+      vv[kk] = uint32_t(1) << (sobol_bits - 1 - kk);
+    return vv;
+  }
+  const auto& directions = sobol_directions[dd - 1];
+  const size_t ss = directions.s;
+  for (size_t kk = 0; kk < std::min(ss, sobol_bits); ++kk)
+    vv[kk] = uint32_t(directions.m[kk]) << (sobol_bits - 1 - kk);
+  for (size_t kk = ss; kk < sobol_bits; ++kk) {
+    vv[kk] = vv[kk - ss] ^ (vv[kk - ss] >> ss);
+    for (size_t ii = 1; ii < ss; ++ii)
+      if ((directions.a >> (ss - 1 - ii)) & 1)
+        vv[kk] ^= vv[kk - ii];
+  }
+  return vv;
+} // ... sobol_direction_numbers(...)
+
+/**
+ * \brief A portable uniform sample of [0, 1) (std::uniform_real_distribution differs between standard libraries).
+ */
+static double unit_sample(std::mt19937_64& generator)
+{
+  return (generator() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * \brief The points which are added on level l of the nested one dimensional grids, given as multiples of
+ *        2^-(max_level + 1).
+ */
+static std::vector< size_t > new_sparse_grid_points(const size_t level, const size_t max_level)
+{
+  const size_t num_intervals = size_t(1) << (max_level + 1);
+  if (level == 0)
+    return {num_intervals / 2};
+  if (level == 1)
+    return {0, num_intervals};
+  std::vector< size_t > ret;
+  const size_t step = size_t(1) << (max_level + 1 - level);
+  for (size_t kk = 1; kk < (size_t(1) << level); kk += 2)
+    ret.push_back(kk*step);
+  return ret;
+} // ... new_sparse_grid_points(...)
+
+static void add_sparse_grid_points(const size_t dimension,
+                                   const size_t max_level,
+                                   const size_t remaining_level,
+                                   std::vector< size_t >& levels,
+                                   std::vector< double >& ret)
+{
+  if (levels.size() == dimension) {
+    const double num_intervals = double(size_t(1) << (max_level + 1));
+    std::vector< std::vector< size_t > > points(dimension);
+    size_t num_points = 1;
+    for (size_t dd = 0; dd < dimension; ++dd) {
+      points[dd] = new_sparse_grid_points(levels[dd], max_level);
+      num_points *= points[dd].size();
+    }
+    std::vector< size_t > index(dimension, 0);
+    for (size_t ii = 0; ii < num_points; ++ii) {
+      for (size_t dd = 0; dd < dimension; ++dd)
+        ret.push_back(points[dd][index[dd]] / num_intervals);
+      for (size_t dd = dimension; dd > 0; --dd) {
+        if (++index[dd - 1] < points[dd - 1].size())
+          break;
+        index[dd - 1] = 0;
+      }
+    }
+    return;
+  }
+  for (size_t level = 0; level <= remaining_level; ++level) {
+    levels.push_back(level);
+    add_sparse_grid_points(dimension, max_level, remaining_level - level, levels, ret);
+    levels.pop_back();
+  }
+} // ... add_sparse_grid_points(...)
+
+
+} // namespace internal
+
+
+ParameterSampler::ParameterSampler()
+{}
+
+ParameterSampler::ParameterSampler(const ParameterType& tt, const double& minimum, const double& maximum)
+  : type_(tt)
+{
+  if (type_.empty())
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given, "tt must not be empty!");
+  size_t dimension = 0;
+  for (const auto& value : type_.values())
+    dimension += value;
+  minima_ = std::vector< double >(dimension, minimum);
+  maxima_ = std::vector< double >(dimension, maximum);
+  check_bounds();
+}
+
+ParameterSampler::ParameterSampler(const ParameterType& tt,
+                                   const std::vector< double >& minima,
+                                   const std::vector< double >& maxima)
+  : type_(tt)
+  , minima_(minima)
+  , maxima_(maxima)
+{
+  if (type_.empty())
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given, "tt must not be empty!");
+  size_t dimension = 0;
+  for (const auto& value : type_.values())
+    dimension += value;
+  if (minima_.size() != dimension || maxima_.size() != dimension)
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+               "minima (" << minima_.size() << ") and maxima (" << maxima_.size()
+               << ") have to be of the serialized size of tt (" << dimension << ")!");
+  check_bounds();
+} // ParameterSampler(...)
+
+const ParameterType& ParameterSampler::type() const
+{
+  return type_;
+}
+
+DUNE_STUFF_SSIZE_T ParameterSampler::dimension() const
+{
+  return minima_.size();
+}
+
+const std::vector< double >& ParameterSampler::minima() const
+{
+  return minima_;
+}
+
+const std::vector< double >& ParameterSampler::maxima() const
+{
+  return maxima_;
+}
+
+void ParameterSampler::set_range(const std::string& key, const double& minimum, const double& maximum)
+{
+  if (!type_.hasKey(key))
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given, "'" << key << "' is not a key of " << type_ << "!");
+  size_t offset = 0;
+  for (const auto& kk : type_.keys()) {
+    const size_t value_size = type_.get(kk);
+    if (kk == key) {
+      std::fill(minima_.begin() + offset, minima_.begin() + offset + value_size, minimum);
+      std::fill(maxima_.begin() + offset, maxima_.begin() + offset + value_size, maximum);
+      break;
+    }
+    offset += value_size;
+  }
+  check_bounds();
+} // ... set_range(...)
+
+bool ParameterSampler::contains(const Parameter& mu) const
+{
+  if (mu.type() != type_)
+    return false;
+  const auto values = mu.serialize();
+  for (size_t ii = 0; ii < values.size(); ++ii)
+    if (values[ii] < minima_[ii] || values[ii] > maxima_[ii])
+      return false;
+  return true;
+} // ... contains(...)
+
+ParameterBatch ParameterSampler::uniform(const DUNE_STUFF_SSIZE_T num_samples) const
+{
+  return uniform(std::vector< DUNE_STUFF_SSIZE_T >(minima_.size(), num_samples));
+}
+
+ParameterBatch ParameterSampler::uniform(const std::vector< DUNE_STUFF_SSIZE_T >& num_samples) const
+{
+  DUNE_PYMOR_TRACE_SCOPE("pymor.parameters.parametersampler.uniform");
+  const size_t dimension = minima_.size();
+  if (num_samples.size() != dimension)
+    DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+               "num_samples has to be of size " << dimension << " (is " << num_samples.size() << ")!");
+  size_t total = 1;
+  for (size_t dd = 0; dd < dimension; ++dd) {
+    if (num_samples[dd] <= 0)
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+                 "num_samples[" << dd << "] has to be positive (is " << num_samples[dd] << ")!");
+    if (total > std::numeric_limits< size_t >::max() / (num_samples[dd]*dimension))
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "the requested grid is too large!");
+    total *= num_samples[dd];
+  }
+  std::vector< double > samples(total*dimension);
+  std::vector< size_t > index(dimension, 0);
+  for (size_t ii = 0; ii < total; ++ii) {
+    for (size_t dd = 0; dd < dimension; ++dd)
+      samples[ii*dimension + dd] = num_samples[dd] == 1 ? 0.5 : double(index[dd]) / (num_samples[dd] - 1);
+    for (size_t dd = dimension; dd > 0; --dd) {
+      if (++index[dd - 1] < size_t(num_samples[dd - 1]))
+        break;
+      index[dd - 1] = 0;
+    }
+  }
+  return scale(std::move(samples));
+} // ... uniform(...)
+
+ParameterBatch ParameterSampler::random(const DUNE_STUFF_SSIZE_T num_samples, const DUNE_STUFF_SSIZE_T seed) const
+{
+  DUNE_PYMOR_TRACE_SCOPE("pymor.parameters.parametersampler.random");
+  if (num_samples < 0)
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given, "num_samples has to be nonnegative (is " << num_samples << ")!");
+  std::mt19937_64 generator(seed);
+  std::vector< double > samples(num_samples*minima_.size());
+  for (auto& sample : samples)
+    sample = internal::unit_sample(generator);
+  return scale(std::move(samples));
+} // ... random(...)
+
+ParameterBatch ParameterSampler::latin_hypercube(const DUNE_STUFF_SSIZE_T num_samples,
+                                                 const DUNE_STUFF_SSIZE_T seed) const
+{
+  DUNE_PYMOR_TRACE_SCOPE("pymor.parameters.parametersampler.latin_hypercube");
+  if (num_samples < 0)
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given, "num_samples has to be nonnegative (is " << num_samples << ")!");
+  const size_t dimension = minima_.size();
+  std::mt19937_64 generator(seed);
+  std::vector< double > samples(num_samples*dimension);
+  std::vector< size_t > strata(num_samples);
+  for (size_t dd = 0; dd < dimension; ++dd) {
+    // Fisher-Yates, std::shuffle differs between standard libraries
+    for (size_t ii = 0; ii < strata.size(); ++ii)
+      strata[ii] = ii;
+    for (size_t ii = strata.size(); ii > 1; --ii)
+      std::swap(strata[ii - 1], strata[generator() % ii]);
+    for (size_t ii = 0; ii < strata.size(); ++ii)
+      samples[ii*dimension + dd] = (strata[ii] + internal::unit_sample(generator)) / num_samples;
+  }
+  return scale(std::move(samples));
+} // ... latin_hypercube(...)
+
+ParameterBatch ParameterSampler::sobol(const DUNE_STUFF_SSIZE_T num_samples, const DUNE_STUFF_SSIZE_T skip) const
+{
+  DUNE_PYMOR_TRACE_SCOPE("pymor.parameters.parametersampler.sobol");
+  const size_t dimension = minima_.size();
+  if (dimension > size_t(max_sobol_dimension()))
+    DUNE_THROW(Stuff::Exceptions::requirements_not_met,
+               "the Sobol sequence is only available for up to " << max_sobol_dimension() << " dimensions (type "
+               << type_ << " has " << dimension << ")!");
+  if (num_samples < 0 || skip < 0)
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+               "num_samples (" << num_samples << ") and skip (" << skip << ") have to be nonnegative!");
+  if (uint64_t(num_samples) + uint64_t(skip) > (uint64_t(1) << internal::sobol_bits))
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+               "the Sobol sequence is limited to 2^" << internal::sobol_bits << " points!");
+  std::vector< std::vector< uint32_t > > directions(dimension);
+  for (size_t dd = 0; dd < dimension; ++dd)
+    directions[dd] = internal::sobol_direction_numbers(dd);
+  // the point with index skip is given by the gray code of skip, all subsequent points differ in one direction number
+  std::vector< uint32_t > point(dimension, 0);
+  const uint64_t gray = uint64_t(skip) ^ (uint64_t(skip) >> 1);
+  for (size_t kk = 0; kk < internal::sobol_bits; ++kk)
+    if ((gray >> kk) & 1)
+      for (size_t dd = 0; dd < dimension; ++dd)
+        point[dd] ^= directions[dd][kk];
+  const double factor = 1.0 / 4294967296.0;
+  std::vector< double > samples(num_samples*dimension);
+  for (size_t ii = 0; ii < size_t(num_samples); ++ii) {
+    for (size_t dd = 0; dd < dimension; ++dd)
+      samples[ii*dimension + dd] = point[dd]*factor;
+    // the position of the lowest zero bit of the index
+    uint64_t index = uint64_t(skip) + ii;
+    size_t cc = 0;
+    while (index & 1) {
+      index >>= 1;
+      ++cc;
+    }
+    if (cc < internal::sobol_bits)
+      for (size_t dd = 0; dd < dimension; ++dd)
+        point[dd] ^= directions[dd][cc];
+  }
+  return scale(std::move(samples));
+} // ... sobol(...)
+
+ParameterBatch ParameterSampler::sparse_grid(const DUNE_STUFF_SSIZE_T level) const
+{
+  DUNE_PYMOR_TRACE_SCOPE("pymor.parameters.parametersampler.sparse_grid");
+  if (level < 0 || level > 30)
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given, "level has to be in [0, 30] (is " << level << ")!");
+  std::vector< double > samples;
+  std::vector< size_t > levels;
+  internal::add_sparse_grid_points(minima_.size(), level, level, levels, samples);
+  return scale(std::move(samples));
+} // ... sparse_grid(...)
+
+DUNE_STUFF_SSIZE_T ParameterSampler::max_sobol_dimension()
+{
+  return 1 + sizeof(internal::sobol_directions)/sizeof(internal::SobolDirections);
+}
+
+void ParameterSampler::check_bounds() const
+{
+  if (type_.empty())
+    DUNE_THROW(Stuff::Exceptions::requirements_not_met, "do not use an empty sampler!");
+  for (size_t ii = 0; ii < minima_.size(); ++ii)
+    if (!(minima_[ii] <= maxima_[ii]))
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given,
+                 "minima[" << ii << "] = " << minima_[ii] << " must not be larger than maxima[" << ii << "] = "
+                 << maxima_[ii] << "!");
+} // ... check_bounds(...)
+
+ParameterBatch ParameterSampler::scale(std::vector< double >&& unit_samples) const
+{
+  check_bounds();
+  const size_t dimension = minima_.size();
+  for (size_t ii = 0; ii < unit_samples.size(); ++ii) {
+    const size_t dd = ii % dimension;
+    unit_samples[ii] = minima_[dd] + unit_samples[ii]*(maxima_[dd] - minima_[dd]);
+  }
+  return ParameterBatch(type_, std::move(unit_samples));
+} // ... scale(...)
+
+
+} // namespace Pymor
+} // namespace Dune
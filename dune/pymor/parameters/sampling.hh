@@ -0,0 +1,104 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_PARAMETERS_SAMPLING_HH
+#define DUNE_PYMOR_PARAMETERS_SAMPLING_HH
+
+#include <string>
+#include <vector>
+
+#include "base.hh"
+#include "batch.hh"
+
+namespace Dune {
+namespace Pymor {
+
+
+/**
+ * \brief Generates samples of the box of all parameters of a given ParameterType with componentwise bounds.
+ *
+ *        The bounds are given per component of the serialized parameter (\see Parameter::serialize()), or per key, or
+ *        once for all components. All samples are returned as a ParameterBatch. Usage example:
+\code
+ParameterSampler sampler({{"diffusion", "force"}, {2, 1}}, 0.1, 1.0);
+sampler.set_range("force", -1.0, 1.0);
+const auto training_set = sampler.latin_hypercube(1000, 42);
+const auto thetas = bundle.evaluate(training_set);
+\endcode
+ * \note  All random samples are reproducible, given the same seed.
+ */
+class ParameterSampler
+{
+public:
+  /**
+   * \brief Empty constructor to please pybindgen.
+   */
+  ParameterSampler();
+
+  ParameterSampler(const ParameterType& tt, const double& minimum, const double& maximum);
+
+  ParameterSampler(const ParameterType& tt, const std::vector< double >& minima, const std::vector< double >& maxima);
+
+  const ParameterType& type() const;
+
+  DUNE_STUFF_SSIZE_T dimension() const;
+
+  const std::vector< double >& minima() const;
+
+  const std::vector< double >& maxima() const;
+
+  void set_range(const std::string& key, const double& minimum, const double& maximum);
+
+  bool contains(const Parameter& mu) const;
+
+  /**
+   * \brief The tensor product of num_samples equidistant points (including the bounds) in each dimension.
+   * \note  The first component of the serialized parameter varies slowest.
+   */
+  ParameterBatch uniform(const DUNE_STUFF_SSIZE_T num_samples) const;
+
+  /**
+   * \brief The tensor product of num_samples[ii] equidistant points in the ii-th dimension.
+   */
+  ParameterBatch uniform(const std::vector< DUNE_STUFF_SSIZE_T >& num_samples) const;
+
+  ParameterBatch random(const DUNE_STUFF_SSIZE_T num_samples, const DUNE_STUFF_SSIZE_T seed = 0) const;
+
+  /**
+   * \brief Each dimension is split into num_samples strata, each of which contains exactly one sample.
+   */
+  ParameterBatch latin_hypercube(const DUNE_STUFF_SSIZE_T num_samples, const DUNE_STUFF_SSIZE_T seed = 0) const;
+
+  /**
+   * \brief The points skip, ..., skip + num_samples - 1 of the Sobol sequence.
+   * \note  Available for up to max_sobol_dimension() dimensions.
+   */
+  ParameterBatch sobol(const DUNE_STUFF_SSIZE_T num_samples, const DUNE_STUFF_SSIZE_T skip = 0) const;
+
+  /**
+   * \brief The points of the Smolyak sparse grid of the given level, based on nested equidistant points.
+   *
+   *        Level 0 contains the center of the box only, level 1 adds the centers of its faces and so on. In one
+   *        dimension, level l consists of the 2^l + 1 equidistant points (l > 0).
+   */
+  ParameterBatch sparse_grid(const DUNE_STUFF_SSIZE_T level) const;
+
+  static DUNE_STUFF_SSIZE_T max_sobol_dimension();
+
+private:
+  void check_bounds() const;
+
+  ParameterBatch scale(std::vector< double >&& unit_samples) const;
+
+  ParameterType type_;
+  std::vector< double > minima_;
+  std::vector< double > maxima_;
+}; // class ParameterSampler
+
+
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_PARAMETERS_SAMPLING_HH
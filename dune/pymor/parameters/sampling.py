@@ -0,0 +1,127 @@
+#! /usr/bin/env python
+# This file is part of the dune-pymor project:
+#   https://github.com/pymor/dune-pymor
+# Copyright Holders: Stephan Rave, Felix Schindler
+# License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+import pybindgen
+from pybindgen import retval, param
+
+from dune.pymor.core.buffer import DoubleBuffer
+
+
+def inject_ParameterBatch(module, exceptions, CONFIG_H):
+    assert(isinstance(module, pybindgen.module.Module))
+    assert(isinstance(exceptions, list))
+    assert(isinstance(CONFIG_H, dict))
+    namespace = module.add_cpp_namespace('Dune').add_cpp_namespace('Pymor')
+    ParameterBatch = namespace.add_class('ParameterBatch')
+    ParameterBatch.add_constructor([])
+    ParameterBatch.add_constructor([param('const Dune::Pymor::ParameterType&', 'tt')])
+    # tried first, so a contiguous numpy array of all serialized parameters is taken over with one memcpy
+    ParameterBatch.add_constructor([param('const Dune::Pymor::ParameterType&', 'tt'),
+                                    param(DoubleBuffer, 'values')],
+                                   throw=exceptions)
+    ParameterBatch.add_constructor([param('const Dune::Pymor::ParameterType&', 'tt'),
+                                    param('const std::vector< double >&', 'values')],
+                                   throw=exceptions)
+    ParameterBatch.add_copy_constructor()
+    ParameterBatch.add_method('type', retval('const Dune::Pymor::ParameterType&'), [], is_const=True)
+    ParameterBatch.add_method('size', retval(CONFIG_H['DUNE_STUFF_SSIZE_T']), [], is_const=True)
+    ParameterBatch.add_method('empty', retval('bool'), [], is_const=True)
+    ParameterBatch.add_method('serialized_size', retval(CONFIG_H['DUNE_STUFF_SSIZE_T']), [], is_const=True)
+    ParameterBatch.add_method('reserve',
+                              None,
+                              [param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'num_parameters')],
+                              throw=exceptions)
+    ParameterBatch.add_method('append',
+                              None,
+                              [param('const Dune::Pymor::Parameter&', 'mu')],
+                              throw=exceptions)
+    ParameterBatch.add_method('append',
+                              None,
+                              [param('const Dune::Pymor::ParameterBatch&', 'other')],
+                              throw=exceptions)
+    ParameterBatch.add_method('append_serialized',
+                              None,
+                              [param('const std::vector< double >&', 'values')],
+                              throw=exceptions)
+    ParameterBatch.add_method('values', retval('std::vector< double >'), [], is_const=True)
+    ParameterBatch.add_method('parameter',
+                              retval('Dune::Pymor::Parameter'),
+                              [param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'ii')],
+                              is_const=True,
+                              throw=exceptions)
+    ParameterBatch.add_method('deserialize',
+                              retval('Dune::Pymor::Parameter'),
+                              [param('const Dune::Pymor::ParameterType&', 'tt'),
+                               param(DoubleBuffer, 'values')],
+                              is_static=True,
+                              throw=exceptions)
+    return module, ParameterBatch
+
+
+def inject_ParameterSampler(module, exceptions, CONFIG_H):
+    assert(isinstance(module, pybindgen.module.Module))
+    assert(isinstance(exceptions, list))
+    assert(isinstance(CONFIG_H, dict))
+    namespace = module.add_cpp_namespace('Dune').add_cpp_namespace('Pymor')
+    ParameterSampler = namespace.add_class('ParameterSampler')
+    ParameterSampler.add_constructor([])
+    ParameterSampler.add_constructor([param('const Dune::Pymor::ParameterType&', 'tt'),
+                                      param('double', 'minimum'),
+                                      param('double', 'maximum')],
+                                     throw=exceptions)
+    ParameterSampler.add_constructor([param('const Dune::Pymor::ParameterType&', 'tt'),
+                                      param('const std::vector< double >&', 'minima'),
+                                      param('const std::vector< double >&', 'maxima')],
+                                     throw=exceptions)
+    ParameterSampler.add_copy_constructor()
+    ParameterSampler.add_method('type', retval('const Dune::Pymor::ParameterType&'), [], is_const=True)
+    ParameterSampler.add_method('dimension', retval(CONFIG_H['DUNE_STUFF_SSIZE_T']), [], is_const=True)
+    ParameterSampler.add_method('minima', retval('std::vector< double >'), [], is_const=True)
+    ParameterSampler.add_method('maxima', retval('std::vector< double >'), [], is_const=True)
+    ParameterSampler.add_method('set_range',
+                                None,
+                                [param('const std::string&', 'key'),
+                                 param('double', 'minimum'),
+                                 param('double', 'maximum')],
+                                throw=exceptions)
+    ParameterSampler.add_method('contains',
+                                retval('bool'),
+                                [param('const Dune::Pymor::Parameter&', 'mu')],
+                                is_const=True)
+    ParameterSampler.add_method('uniform',
+                                retval('Dune::Pymor::ParameterBatch'),
+                                [param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'num_samples')],
+                                is_const=True,
+                                throw=exceptions)
+    ParameterSampler.add_method('uniform',
+                                retval('Dune::Pymor::ParameterBatch'),
+                                [param('const std::vector< ' + CONFIG_H['DUNE_STUFF_SSIZE_T'] + ' >&',
+                                       'num_samples')],
+                                is_const=True,
+                                throw=exceptions)
+    for sampling in ('random', 'latin_hypercube'):
+        ParameterSampler.add_method(sampling,
+                                    retval('Dune::Pymor::ParameterBatch'),
+                                    [param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'num_samples'),
+                                     param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'seed', default_value='0')],
+                                    is_const=True,
+                                    throw=exceptions)
+    ParameterSampler.add_method('sobol',
+                                retval('Dune::Pymor::ParameterBatch'),
+                                [param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'num_samples'),
+                                 param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'skip', default_value='0')],
+                                is_const=True,
+                                throw=exceptions)
+    ParameterSampler.add_method('sparse_grid',
+                                retval('Dune::Pymor::ParameterBatch'),
+                                [param(CONFIG_H['DUNE_STUFF_SSIZE_T'], 'level')],
+                                is_const=True,
+                                throw=exceptions)
+    ParameterSampler.add_method('max_sobol_dimension',
+                                retval(CONFIG_H['DUNE_STUFF_SSIZE_T']),
+                                [],
+                                is_static=True)
+    return module, ParameterSampler
@@ -0,0 +1,213 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include "config.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <algorithm>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/common/exceptions.hh>
+#include <dune/pymor/common/tracing.hh>
+
+#include "thetas.hh"
+
+namespace Dune {
+namespace Pymor {
+
+
+ThetaBundle::ThetaBundle()
+  : Parametric()
+  , serialized_size_(0)
+  , max_num_variables_(0)
+{}
+
+ThetaBundle::ThetaBundle(const std::vector< ThetaType >& thetas)
+  : Parametric()
+  , thetas_(thetas)
+  , serialized_size_(0)
+  , direct_(thetas.size(), false)
+  , position_(thetas.size(), 0)
+  , max_num_variables_(0)
+{
+  // merge the parameter types of all thetas
+  std::map< std::string, DUNE_STUFF_SSIZE_T > merged_type;
+  for (size_t qq = 0; qq < thetas_.size(); ++qq) {
+    if (!thetas_[qq])
+      DUNE_THROW(Stuff::Exceptions::wrong_input_given, "theta " << qq << " is empty!");
+    const ParameterType& type = thetas_[qq]->parameter_type();
+    for (const auto& key : type.keys()) {
+      const auto result = merged_type.find(key);
+      if (result == merged_type.end())
+        merged_type[key] = type.get(key);
+      else if (result->second != type.get(key))
+        DUNE_THROW(Stuff::Exceptions::shapes_do_not_match,
+                   "the size for key '" << key << "' of theta " << qq << " (" << type.get(key)
+                   << ") does not match the size for '" << key << "' of the other thetas (" << result->second << ")!");
+    }
+  }
+  ParameterType type;
+  for (const auto& element : merged_type)
+    type.set(element.first, element.second);
+  replace_parameter_type(type);
+  // compute the position of each key in the serialized parameter (the keys of a map are sorted, just like in
+  // Parameter::serialize())
+  std::map< std::string, size_t > offsets;
+  for (const auto& element : merged_type) {
+    offsets[element.first] = serialized_size_;
+    serialized_size_ += element.second;
+  }
+  // sort the thetas into direct reads and those which require the interpreter, do not evaluate the latter twice
+  std::map< std::string, size_t > unique_thetas;
+  for (size_t qq = 0; qq < thetas_.size(); ++qq) {
+    const ParameterFunctional& theta = *thetas_[qq];
+    if (theta.direct_read_) {
+      direct_[qq] = true;
+      position_[qq] = offsets[theta.direct_key_] + theta.direct_component_;
+    } else {
+      // callable thetas are only identified by their function
+      const std::string id = theta.parameter_type().report() + " -> " + theta.expression()
+          + (theta.callable() ? " @ " + std::to_string(reinterpret_cast< uintptr_t >(theta.function_.get())) : "");
+      const auto result = unique_thetas.find(id);
+      if (result != unique_thetas.end())
+        position_[qq] = result->second;
+      else {
+        std::vector< size_t > variables;
+        const ParameterType& theta_type = theta.parameter_type();
+        for (const auto& key : theta_type.keys())
+          for (DUNE_STUFF_SSIZE_T ii = 0; ii < theta_type.get(key); ++ii)
+            variables.push_back(offsets[key] + ii);
+        max_num_variables_ = std::max(max_num_variables_, variables.size());
+        position_[qq] = interpreted_.size();
+        unique_thetas[id] = interpreted_.size();
+        interpreted_.push_back(thetas_[qq]);
+        variables_.push_back(variables);
+      }
+    }
+  }
+} // ThetaBundle(...)
+
+DUNE_STUFF_SSIZE_T ThetaBundle::size() const
+{
+  return thetas_.size();
+}
+
+DUNE_STUFF_SSIZE_T ThetaBundle::num_interpreted() const
+{
+  return interpreted_.size();
+}
+
+const ThetaBundle::ThetaType& ThetaBundle::theta(const DUNE_STUFF_SSIZE_T qq) const
+{
+  if (qq < 0 || qq >= size())
+    DUNE_THROW(Stuff::Exceptions::index_out_of_range,
+               "the condition 0 <= " << qq << " < size() = " << size() << " is not satisfied!");
+  return thetas_[qq];
+}
+
+void ThetaBundle::evaluate(const Parameter& mu, std::vector< double >& ret) const
+{
+  DUNE_PYMOR_TRACE_SCOPE("pymor.parameters.thetabundle.evaluate");
+  check_parameter(mu);
+  const auto serialized_mu = mu.serialize();
+  ret.resize(thetas_.size());
+  evaluate_single(serialized_mu.data(), ret.data());
+  for (size_t qq = 0; qq < thetas_.size(); ++qq)
+    thetas_[qq]->check_value(ret[qq], mu);
+} // ... evaluate(...)
+
+std::vector< double > ThetaBundle::evaluate(const Parameter& mu) const
+{
+  std::vector< double > ret;
+  evaluate(mu, ret);
+  return ret;
+}
+
+void ThetaBundle::evaluate(const std::vector< Parameter >& mus, std::vector< double >& ret) const
+{
+  std::vector< double > serialized_mus(mus.size()*serialized_size_);
+  for (size_t ii = 0; ii < mus.size(); ++ii) {
+    check_parameter(mus[ii]);
+    const auto serialized_mu = mus[ii].serialize();
+    std::copy(serialized_mu.begin(), serialized_mu.end(), serialized_mus.begin() + ii*serialized_size_);
+  }
+  ret.resize(mus.size()*thetas_.size());
+  evaluate_serialized(serialized_mus.data(), mus.size(), ret.data());
+  for (size_t ii = 0; ii < mus.size(); ++ii)
+    for (size_t qq = 0; qq < thetas_.size(); ++qq)
+      thetas_[qq]->check_value(ret[ii*thetas_.size() + qq], mus[ii]);
+} // ... evaluate(...)
+
+std::vector< double > ThetaBundle::evaluate(const std::vector< Parameter >& mus) const
+{
+  std::vector< double > ret;
+  evaluate(mus, ret);
+  return ret;
+}
+
+void ThetaBundle::evaluate(const ParameterBatch& mus, std::vector< double >& ret) const
+{
+  if (mus.type() != parameter_type())
+    DUNE_THROW(Pymor::Exceptions::wrong_parameter_type,
+               "the type of mus (" << mus.type().report() << ") does not match the parameter_type of this ("
+               << parameter_type().report() << ")!");
+  ret.resize(mus.size()*thetas_.size());
+  evaluate_serialized(mus.data(), mus.size(), ret.data());
+  // only create the parameter if the check is about to fail
+  for (size_t ii = 0; ii < size_t(mus.size()); ++ii)
+    for (size_t qq = 0; qq < thetas_.size(); ++qq)
+      if (std::abs(ret[ii*thetas_.size() + qq]) > (0.9 * std::numeric_limits< double >::max()))
+        thetas_[qq]->check_value(ret[ii*thetas_.size() + qq], mus.parameter(ii));
+} // ... evaluate(...)
+
+std::vector< double > ThetaBundle::evaluate(const ParameterBatch& mus) const
+{
+  std::vector< double > ret;
+  evaluate(mus, ret);
+  return ret;
+}
+
+void ThetaBundle::evaluate_serialized(const double* mus, const size_t num_mus, double* ret) const
+{
+  DUNE_PYMOR_TRACE_SCOPE("pymor.parameters.thetabundle.evaluate_serialized");
+  for (size_t ii = 0; ii < num_mus; ++ii)
+    evaluate_single(mus + ii*serialized_size_, ret + ii*thetas_.size());
+}
+
+size_t ThetaBundle::serialized_size() const
+{
+  return serialized_size_;
+}
+
+void ThetaBundle::check_parameter(const Parameter& mu) const
+{
+  if (mu.type() != parameter_type())
+    DUNE_THROW(Pymor::Exceptions::wrong_parameter_type,
+               "the type of mu (" << mu.type().report() << ") does not match the parameter_type of this ("
+               << parameter_type().report() << ")!");
+}
+
+void ThetaBundle::evaluate_single(const double* mu, double* ret) const
+{
+  std::vector< double > variables(max_num_variables_);
+  std::vector< double > interpreted(interpreted_.size());
+  for (size_t uu = 0; uu < interpreted_.size(); ++uu) {
+    const auto& positions = variables_[uu];
+    for (size_t ii = 0; ii < positions.size(); ++ii)
+      variables[ii] = mu[positions[ii]];
+    interpreted[uu] = interpreted_[uu]->evaluate_serialized(variables.data());
+  }
+  for (size_t qq = 0; qq < thetas_.size(); ++qq)
+    ret[qq] = direct_[qq] ? mu[position_[qq]] : interpreted[position_[qq]];
+} // ... evaluate_single(...)
+
+
+} // namespace Pymor
+} // namespace Dune
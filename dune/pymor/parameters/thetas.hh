@@ -0,0 +1,105 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_PARAMETERS_THETAS_HH
+#define DUNE_PYMOR_PARAMETERS_THETAS_HH
+
+#include <vector>
+#include <memory>
+
+#include "base.hh"
+#include "batch.hh"
+#include "functional.hh"
+
+namespace Dune {
+namespace Pymor {
+
+
+/**
+ * \brief Evaluates a list of ParameterFunctional (the coefficients, or thetas, of an affine decomposition) at once.
+ *
+ *        The ParameterType of the bundle is the union of the ParameterTypes of all thetas. Upon evaluation, the given
+ *        parameter is serialized only once and each theta reads its variables from this shared buffer. Thetas which
+ *        only read a single component of the parameter (e.g. "diffusion[0]") are copied from the buffer directly,
+ *        identical thetas (same expression and ParameterType) are only evaluated once.
+ * \note  The evaluation of a bundle, as well as the evaluation of a ParameterFunctional, is not thread safe.
+ */
+class ThetaBundle
+  : public Parametric
+{
+public:
+  typedef std::shared_ptr< const ParameterFunctional > ThetaType;
+
+  ThetaBundle();
+
+  ThetaBundle(const std::vector< ThetaType >& thetas);
+
+  /**
+   * \brief The number of thetas.
+   */
+  DUNE_STUFF_SSIZE_T size() const;
+
+  /**
+   * \brief The number of thetas which are actually evaluated using the expression interpreter.
+   */
+  DUNE_STUFF_SSIZE_T num_interpreted() const;
+
+  const ThetaType& theta(const DUNE_STUFF_SSIZE_T qq) const;
+
+  void evaluate(const Parameter& mu, std::vector< double >& ret) const;
+
+  std::vector< double > evaluate(const Parameter& mu) const;
+
+  /**
+   * \brief Evaluates all thetas for each parameter in mus.
+   * \param ret is resized to mus.size()*size(), the thetas for mus[ii] are stored in ret[ii*size(), (ii + 1)*size()).
+   */
+  void evaluate(const std::vector< Parameter >& mus, std::vector< double >& ret) const;
+
+  std::vector< double > evaluate(const std::vector< Parameter >& mus) const;
+
+  /**
+   * \brief Evaluates all thetas for each parameter in mus, without creating a single Parameter.
+   * \param ret is resized to mus.size()*size(), see above
+   */
+  void evaluate(const ParameterBatch& mus, std::vector< double >& ret) const;
+
+  std::vector< double > evaluate(const ParameterBatch& mus) const;
+
+  /**
+   * \brief Evaluates all thetas for a batch of serialized parameters.
+   * \param mus contiguous storage of num_mus serialized parameters of type parameter_type(), each of length
+   *            serialized_size()
+   * \param ret contiguous storage for num_mus*size() values, the thetas of the ii-th parameter are written to
+   *            ret[ii*size(), (ii + 1)*size())
+   */
+  void evaluate_serialized(const double* mus, const size_t num_mus, double* ret) const;
+
+  /**
+   * \brief The length of a serialized parameter of type parameter_type().
+   */
+  size_t serialized_size() const;
+
+private:
+  void check_parameter(const Parameter& mu) const;
+
+  void evaluate_single(const double* mu, double* ret) const;
+
+  std::vector< ThetaType > thetas_;
+  size_t serialized_size_;
+  //! for each theta, either its position in the serialized parameter (direct reads) or in interpreted_
+  std::vector< bool > direct_;
+  std::vector< size_t > position_;
+  //! the thetas which need the interpreter and the position of their variables in the serialized parameter
+  std::vector< ThetaType > interpreted_;
+  std::vector< std::vector< size_t > > variables_;
+  size_t max_num_variables_;
+}; // class ThetaBundle
+
+
+} // namespace Pymor
+} // namespace Dune
+
+#endif // DUNE_PYMOR_PARAMETERS_THETAS_HH
@@ -0,0 +1,42 @@
+#! /usr/bin/env python
+# This file is part of the dune-pymor project:
+#   https://github.com/pymor/dune-pymor
+# Copyright Holders: Stephan Rave, Felix Schindler
+# License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+import pybindgen
+from pybindgen import retval, param
+
+
+def inject_ThetaBundle(module, exceptions, interfaces, CONFIG_H):
+    assert(isinstance(module, pybindgen.module.Module))
+    assert(isinstance(exceptions, list))
+    assert(isinstance(interfaces, dict))
+    for element in interfaces:
+        assert(isinstance(element, str))
+        assert(len(element) > 0)
+        assert(isinstance(CONFIG_H, dict))
+    module.add_container('std::vector< Dune::Pymor::Parameter >', 'Dune::Pymor::Parameter', 'list')
+    namespace = module.add_cpp_namespace('Dune').add_cpp_namespace('Pymor')
+    ThetaBundle = namespace.add_class('ThetaBundle', parent=[interfaces['Dune::Pymor::Parametric']])
+    ThetaBundle.add_copy_constructor()
+    ThetaBundle.add_method('size', CONFIG_H['DUNE_STUFF_SSIZE_T'], [], is_const=True)
+    ThetaBundle.add_method('num_interpreted', CONFIG_H['DUNE_STUFF_SSIZE_T'], [], is_const=True)
+    ThetaBundle.add_method('evaluate',
+                           retval('std::vector< double >'),
+                           [param('const Parameter&', 'mu')],
+                           throw=exceptions,
+                           is_const=True)
+    ThetaBundle.add_method('evaluate',
+                           retval('std::vector< double >'),
+                           [param('const std::vector< Dune::Pymor::Parameter >&', 'mus')],
+                           throw=exceptions,
+                           is_const=True,
+                           custom_name='evaluate_batch')
+    ThetaBundle.add_method('evaluate',
+                           retval('std::vector< double >'),
+                           [param('const Dune::Pymor::ParameterBatch&', 'mus')],
+                           throw=exceptions,
+                           is_const=True,
+                           custom_name='evaluate_parameter_batch')
+    return module, ThetaBundle
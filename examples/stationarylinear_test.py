@@ -27,6 +27,20 @@ try:
             ['diffusion', 'force', 'neumann', 'dirichlet'],
             [[1.0, 1.0, 1.0, 1.0], [1.0, 1.0, 1.0, 1.0], [1.0, 1.0, 1.0, 1.0], [1.0, 1.0, 1.0, 1.0]])
 
+    print('converting a batch of parameters... ', end='')
+    import numpy as np
+    from pymor.parameters.base import Parameter
+    from dune.pymor.core.wrapmodule import wrap_module
+    _, wrapper = wrap_module(example_module)
+    mus = [Parameter({k: np.linspace(1.0, 2.0, 4) + ii for k in ('diffusion', 'force', 'neumann', 'dirichlet')})
+           for ii in range(3)]
+    batch = wrapper[wrapper.dune_parameter_batch(mus)]
+    assert len(batch) == len(mus)
+    for mu_1, mu_2 in zip(mus, batch):
+        assert sorted(mu_1.keys()) == sorted(mu_2.keys())
+        assert all(np.array_equal(mu_1[k], mu_2[k]) for k in mu_1.keys())
+    print('done')
+
     print('solving for mu = {}... '.format(mu.report()), end='')
     solution = discretization.create_vector()
     discretization.solve(solution, mu)
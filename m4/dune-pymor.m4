@@ -8,6 +8,9 @@ AC_DEFUN([DUNE_PYMOR_CHECKS],[
 Perhaps you should add the directory containing `eigen3.pc'
 to the PKG_CONFIG_PATH environment variable.])])
   DUNE_CPPFLAGS="$DUNE_CPPFLAGS $EIGEN_CFLAGS"
+  # std::thread (common/threading.cc)
+  ACX_PTHREAD([],
+              [AC_MSG_ERROR([POSIX threads are required for std::thread!])])
 ])
 
 AC_DEFUN([DUNE_PYMOR_CHECK_MODULE],
@@ -0,0 +1,46 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <memory>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/la/container/common.hh>
+
+#include <dune/pymor/common/memory.hh>
+#include <dune/pymor/la/container/affine.hh>
+#include <dune/pymor/parameters/functional.hh>
+
+using namespace Dune;
+using namespace Dune::Pymor;
+
+TEST(MemoryFootprint, Common_Memory)
+{
+  MemoryFootprint footprint;
+  const double values[4] = {0., 1., 2., 3.};
+  footprint.add("first", &values[0], 2*sizeof(double));
+  footprint.add("second", &values[2], 2*sizeof(double));
+  footprint.add("first_again", &values[0], 2*sizeof(double));
+  if (footprint.total() != 4*sizeof(double))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, footprint.report());
+  if (footprint.entries().size() != 3 || !footprint.entries()[2].shared)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, footprint.report());
+}
+
+TEST(MemoryFootprint, LA_AffinelyDecomposedContainer)
+{
+  typedef Stuff::LA::CommonDenseVector< double > VectorType;
+  const std::shared_ptr< const VectorType > component(new VectorType(10, 1.));
+  LA::AffinelyDecomposedConstContainer< VectorType > container(new VectorType(10, 0.));
+  container.register_component(component, new ParameterFunctional("diffusion", 1, "diffusion"));
+  container.register_component(component, new ParameterFunctional("force", 1, "force"));
+  const MemoryFootprint footprint = container.memory_footprint();
+  // the component is registered twice but counted once
+  if (footprint.entries().size() != 3)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, footprint.report());
+  if (footprint.total() != 20*sizeof(double))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, footprint.report());
+}
@@ -0,0 +1,157 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/common/threading.hh>
+
+using namespace Dune;
+using namespace Dune::Pymor;
+
+TEST(Threading, parallel_for)
+{
+  for (size_t num_threads : {1, 3, 8, 200}) {
+    std::vector< int > visited(100, 0);
+    parallel_for(0, visited.size(), [&](const size_t first, const size_t last) {
+      for (size_t ii = first; ii < last; ++ii)
+        ++visited[ii];
+    }, num_threads);
+    for (size_t ii = 0; ii < visited.size(); ++ii)
+      if (visited[ii] != 1)
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                   "index " << ii << " was visited " << visited[ii] << " times with " << num_threads << " threads!");
+  }
+}
+
+TEST(Threading, parallel_for_exception)
+{
+  bool thrown = false;
+  try {
+    parallel_for(0, 10, [](const size_t first, const size_t /*last*/) {
+      if (first > 0)
+        DUNE_THROW(Stuff::Exceptions::wrong_input_given, "");
+    }, 4);
+  } catch (Stuff::Exceptions::wrong_input_given&) {
+    thrown = true;
+  }
+  if (!thrown)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the exception was not rethrown!");
+}
+
+TEST(ThreadPool, run_async)
+{
+  ThreadPool pool(3);
+  std::atomic< size_t > callbacks(0);
+  std::vector< AsyncResult< size_t > > results;
+  for (size_t ii = 0; ii < 100; ++ii) {
+    results.push_back(run_async< size_t >([ii]() { return new size_t(ii*ii); }, pool));
+    results.back().then([&](const AsyncResult< size_t >& result) {
+      if (result.ready())
+        ++callbacks;
+    });
+  }
+  for (size_t ii = 0; ii < results.size(); ++ii)
+    if (results[ii].get() != ii*ii)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                 "result " << ii << " is " << results[ii].get() << "!");
+  // the callbacks are called by the thread setting the result after waking the waiting ones
+  for (size_t ii = 0; ii < 600 && callbacks < 100; ++ii)
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  if (callbacks != 100)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, callbacks << " callbacks were called!");
+  const std::unique_ptr< size_t > copied(results[3].get_and_return_ptr());
+  if (*copied != 9)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "copied result is " << *copied << "!");
+  // callbacks of finished results are called immediately
+  results[0].then([&](const AsyncResult< size_t >&) { ++callbacks; });
+  if (callbacks != 101)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, callbacks << " callbacks were called!");
+}
+
+TEST(ThreadPool, run_async_exception)
+{
+  ThreadPool pool(2);
+  const auto result = run_async< int >([]() -> int* {
+    DUNE_THROW(Stuff::Exceptions::wrong_input_given, "");
+  }, pool);
+  bool thrown = false;
+  try {
+    result.get();
+  } catch (Stuff::Exceptions::wrong_input_given&) {
+    thrown = true;
+  }
+  if (!thrown || !result.ready())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the exception was not rethrown!");
+}
+
+TEST(ThreadPool, nested)
+{
+  // a single worker has to run the tasks it waits for itself
+  ThreadPool pool(1);
+  std::function< size_t*(size_t) > sum = [&](const size_t nn) -> size_t* {
+    if (nn == 0)
+      return new size_t(0);
+    const auto rest = run_async< size_t >([&sum, nn]() { return sum(nn - 1); }, pool);
+    return new size_t(nn + rest.get());
+  };
+  const auto result = run_async< size_t >([&]() { return sum(20); }, pool);
+  if (!result.wait_for(60.0) || result.get() != 210)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "nested tasks did not finish!");
+}
+
+TEST(ThreadPool, waiting_worker)
+{
+  // the only worker waits for a result set by a task submitted only after it started waiting
+  ThreadPool pool(1);
+  AsyncResult< int > external(&pool);
+  const auto result = run_async< int >([external]() { return new int(2*external.get()); }, pool);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  pool.submit([external]() mutable { external.set_value(std::make_shared< int >(21)); });
+  if (!result.wait_for(60.0) || result.get() != 42)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the waiting worker did not run the submitted task!");
+  // a result set from outside the pool wakes the waiting worker as well
+  AsyncResult< int > other(&pool);
+  const auto second = run_async< int >([other]() { return new int(other.get() + 1); }, pool);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  other.set_value(std::make_shared< int >(1));
+  if (!second.wait_for(60.0) || second.get() != 2)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the waiting worker was not woken!");
+}
+
+TEST(ThreadPool, keep_alive)
+{
+  ThreadPool pool(2);
+  AsyncResult< int > external(&pool);
+  const auto result = run_async< int >([external]() { return new int(external.get()); }, pool);
+  auto object = std::make_shared< int >(7);
+  const std::weak_ptr< int > observer = object;
+  result.keep_alive(object);
+  object.reset();
+  if (observer.expired())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the object was released too early!");
+  external.set_value(std::make_shared< int >(1));
+  result.wait();
+  // the object is released by the thread setting the result after waking the waiting ones
+  for (size_t ii = 0; ii < 600 && !observer.expired(); ++ii)
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  if (!observer.expired())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the object was not released!");
+  // finished results release the object right away
+  object = std::make_shared< int >(7);
+  const std::weak_ptr< int > released = object;
+  result.keep_alive(object);
+  object.reset();
+  if (!released.expired())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the object was kept alive!");
+}
@@ -0,0 +1,52 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <string>
+#include <thread>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/common/tracing.hh>
+
+using namespace Dune;
+using namespace Dune::Pymor;
+
+static void traced()
+{
+  DUNE_PYMOR_TRACE_SCOPE("pymor.test.traced");
+}
+
+static size_t count(const std::string& str, const std::string& pattern)
+{
+  size_t ret = 0;
+  for (size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1))
+    ++ret;
+  return ret;
+}
+
+TEST(Tracing, Common_Tracing)
+{
+  Tracing::disable();
+  Tracing::clear();
+  traced();
+  if (count(Tracing::chrome_trace(), "pymor.test.traced") != 0)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  Tracing::enable(4);
+  traced();
+  std::thread thread([]() { for (size_t ii = 0; ii < 10; ++ii) traced(); });
+  thread.join();
+  Tracing::disable();
+  const std::string trace = Tracing::chrome_trace();
+  // one event of this thread, the ring buffer of the other one holds the last 4
+  if (count(trace, "pymor.test.traced") != 5)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, trace);
+  if (count(trace, "\"ph\":\"X\"") != 5)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, trace);
+  Tracing::clear();
+  if (count(Tracing::chrome_trace(), "pymor.test.traced") != 0)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+}
@@ -0,0 +1,107 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/discretizations/cache.hh>
+
+using namespace Dune;
+using namespace Dune::Pymor;
+
+/**
+ * \brief Stands in for an oversampled discretization, its size is given by the subdomain.
+ */
+struct FakeDiscretization
+{
+  size_t subdomain;
+  std::string boundary_value_type;
+}; // struct FakeDiscretization
+
+typedef DiscretizationCache< FakeDiscretization > CacheType;
+
+static std::unique_ptr< CacheType > create_cache(std::atomic< size_t >& builds, const size_t memory_budget)
+{
+  return std::unique_ptr< CacheType >(new CacheType(
+      [&](const CacheType::KeyType& key) {
+        ++builds;
+        if (key.second == "invalid")
+          DUNE_THROW(Stuff::Exceptions::wrong_input_given, "invalid boundary value type!");
+        return std::make_shared< FakeDiscretization >(FakeDiscretization{key.first, key.second});
+      },
+      [](const FakeDiscretization& discretization) { return 100*(discretization.subdomain + 1); },
+      memory_budget));
+}
+
+TEST(DiscretizationCache, get_and_evict)
+{
+  std::atomic< size_t > builds(0);
+  auto cache_ptr = create_cache(builds, 900);
+  auto& cache = *cache_ptr;
+  for (size_t ss = 0; ss < 3; ++ss)
+    if (cache.get(std::make_pair(ss, std::string("dirichlet")))->subdomain != ss)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "wrong discretization for subdomain " << ss << "!");
+  // 100 + 200 + 300 bytes, all fit
+  cache.get(std::make_pair(size_t(0), std::string("dirichlet")));
+  if (builds != 3 || cache.hits() != 1 || cache.misses() != 3 || cache.memory_used() != 600)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+               "builds: " << builds << ", hits: " << cache.hits() << ", misses: " << cache.misses()
+               << ", memory_used: " << cache.memory_used());
+  // adding 400 bytes exceeds the budget and evicts the least recently used subdomain 1
+  const auto kept_alive = cache.get(std::make_pair(size_t(1), std::string("dirichlet")));
+  cache.get(std::make_pair(size_t(0), std::string("dirichlet")));
+  cache.get(std::make_pair(size_t(2), std::string("dirichlet")));
+  cache.get(std::make_pair(size_t(3), std::string("dirichlet")));
+  if (cache.contains(std::make_pair(size_t(1), std::string("dirichlet")))
+      || !cache.contains(std::make_pair(size_t(0), std::string("dirichlet")))
+      || cache.memory_used() != 800 || cache.evictions() != 1)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+               "memory_used: " << cache.memory_used() << ", evictions: " << cache.evictions());
+  if (kept_alive->subdomain != 1)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "evicted discretization was not kept alive!");
+  cache.set_memory_budget(400);
+  if (cache.size() != 1 || cache.memory_used() != 400)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+               "size: " << cache.size() << ", memory_used: " << cache.memory_used());
+  bool caught = false;
+  try {
+    cache.get(std::make_pair(size_t(0), std::string("invalid")));
+  } catch (Stuff::Exceptions::wrong_input_given&) {
+    caught = true;
+  }
+  if (!caught || cache.contains(std::make_pair(size_t(0), std::string("invalid"))))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "failed build was not reported!");
+}
+
+TEST(DiscretizationCache, prebuild)
+{
+  std::atomic< size_t > builds(0);
+  auto cache_ptr = create_cache(builds, 0);
+  auto& cache = *cache_ptr;
+  std::vector< CacheType::KeyType > keys;
+  for (size_t ss = 0; ss < 50; ++ss)
+    for (const std::string type : {"dirichlet", "neumann"})
+      keys.emplace_back(ss, type);
+  // every key twice, each one is built once nevertheless
+  std::vector< CacheType::KeyType > duplicated_keys(keys);
+  duplicated_keys.insert(duplicated_keys.end(), keys.begin(), keys.end());
+  cache.prebuild(duplicated_keys, 4);
+  if (builds != keys.size() || cache.size() != keys.size())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+               "builds: " << builds << ", size: " << cache.size() << "!");
+  for (const auto& key : keys)
+    if (cache.get(key)->boundary_value_type != key.second)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "wrong discretization for " << key.second << "!");
+  if (builds != keys.size() || cache.hits() != keys.size())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+               "builds: " << builds << ", hits: " << cache.hits() << "!");
+}
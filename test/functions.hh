@@ -0,0 +1,79 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_TEST_FUNCTIONS_HH
+#define DUNE_PYMOR_TEST_FUNCTIONS_HH
+
+#include <dune/stuff/common/fvector.hh>
+
+/**
+ * \brief An axis aligned cube [lowerLeft, lowerLeft + width]^dim, providing as much of the entity interface as the
+ *        functions need to locate an entity.
+ */
+template< size_t dim >
+class FakeCubeEntity
+{
+public:
+  typedef Dune::Stuff::Common::FieldVector< double, dim > DomainType;
+
+  class Geometry
+  {
+  public:
+    Geometry(const DomainType& lowerLeft, const double width)
+      : lowerLeft_(lowerLeft)
+      , width_(width)
+    {}
+
+    int corners() const
+    {
+      return 1 << dim;
+    }
+
+    DomainType corner(const int cc) const
+    {
+      DomainType ret = lowerLeft_;
+      for (size_t dd = 0; dd < dim; ++dd)
+        ret[dd] += ((cc >> dd) % 2)*width_;
+      return ret;
+    }
+
+    DomainType global(const DomainType& xx) const
+    {
+      DomainType ret = lowerLeft_;
+      for (size_t dd = 0; dd < dim; ++dd)
+        ret[dd] += xx[dd]*width_;
+      return ret;
+    }
+
+    DomainType center() const
+    {
+      DomainType ret = lowerLeft_;
+      for (size_t dd = 0; dd < dim; ++dd)
+        ret[dd] += 0.5*width_;
+      return ret;
+    }
+
+  private:
+    const DomainType lowerLeft_;
+    const double width_;
+  }; // class Geometry
+
+  FakeCubeEntity(const DomainType& lowerLeft, const double width)
+    : geometry_(lowerLeft, width)
+  {}
+
+  const Geometry& geometry() const
+  {
+    return geometry_;
+  }
+
+private:
+  const Geometry geometry_;
+}; // class FakeCubeEntity
+
+
+typedef FakeCubeEntity< 2 > FakeSquareEntity;
+
+#endif // DUNE_PYMOR_TEST_FUNCTIONS_HH
@@ -0,0 +1,104 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <memory>
+#include <vector>
+
+#include <dune/stuff/common/float_cmp.hh>
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/functions/interfaces.hh>
+
+#include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/functions/batched.hh>
+#include <dune/pymor/functions/checkerboard.hh>
+#include <dune/pymor/functions/default.hh>
+
+#include "functions.hh"
+
+using namespace Dune;
+using namespace Dune::Pymor;
+
+typedef Functions::AffinelyDecomposableDefault< FakeSquareEntity, double, 2, double, 1 >  FunctionType;
+typedef Functions::Checkerboard< FakeSquareEntity, double, 2, double, 1 >                 CheckerboardType;
+typedef FunctionType::NonparametricType::LocalfunctionType                                LocalfunctionType;
+typedef internal::BatchedLocalfunctionInterface< FakeSquareEntity, double, 2, double, 1, 1 > BatchedType;
+typedef FunctionType::DomainType                                                          DomainType;
+typedef FunctionType::RangeType                                                           RangeType;
+typedef FunctionType::JacobianRangeType                                                   JacobianRangeType;
+
+
+class LinearFunction
+  : public Stuff::GlobalFunctionInterface< FakeSquareEntity, double, 2, double, 1 >
+{
+public:
+  virtual size_t order() const override
+  {
+    return 1;
+  }
+
+  virtual void evaluate(const DomainType& xx, RangeType& ret) const override
+  {
+    ret[0] = xx[0] + 2.0*xx[1];
+  }
+
+  virtual void jacobian(const DomainType& /*xx*/, JacobianRangeType& ret) const override
+  {
+    ret[0][0] = 1.0;
+    ret[0][1] = 2.0;
+  }
+}; // class LinearFunction
+
+
+static void check_batched(const LocalfunctionType& local_function)
+{
+  if (!dynamic_cast< const BatchedType* >(&local_function))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the local function does not support batches!");
+  const std::vector< DomainType > points = {{0.0, 0.0}, {0.5, 0.25}, {1.0, 1.0}, {0.2, 0.9}};
+  std::vector< RangeType > values;
+  std::vector< JacobianRangeType > jacobians;
+  Pymor::evaluate(local_function, points, values);
+  Pymor::jacobian(local_function, points, jacobians);
+  if (values.size() != points.size() || jacobians.size() != points.size())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  RangeType value(0);
+  JacobianRangeType jacobian(0);
+  for (size_t pp = 0; pp < points.size(); ++pp) {
+    local_function.evaluate(points[pp], value);
+    local_function.jacobian(points[pp], jacobian);
+    if (!Dune::FloatCmp::eq(values[pp][0], value[0]))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                 "point " << pp << ": " << values[pp][0] << " vs. " << value[0] << "!");
+    for (size_t dd = 0; dd < 2; ++dd)
+      if (!Dune::FloatCmp::eq(jacobians[pp][0][dd], jacobian[0][dd]))
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                   "point " << pp << ": " << jacobians[pp][0][dd] << " vs. " << jacobian[0][dd] << "!");
+  }
+} // ... check_batched(...)
+
+
+TEST(Batched, piecewise_constant)
+{
+  const CheckerboardType checkerboard({0.0, 0.0}, {1.0, 1.0}, {2, 2}, "value");
+  const FakeSquareEntity entity({0.5, 0.5}, 0.25);
+  check_batched(*checkerboard.with_mu(Parameter("value", {1.0, 2.0, 3.0, 4.0}))->local_function(entity));
+  check_batched(*checkerboard.component(3)->local_function(entity));
+}
+
+TEST(Batched, function_with_parameter)
+{
+  const CheckerboardType checkerboard({0.0, 0.0}, {1.0, 1.0}, {2, 2}, "value");
+  const ParameterType type("value", 4);
+  FunctionType function;
+  function.register_affine_part(new LinearFunction());
+  function.register_component(checkerboard.component(0), checkerboard.coefficient(0));
+  function.register_component(std::make_shared< const LinearFunction >(),
+                              std::make_shared< const ParameterFunctional >(type, "value[1]"));
+  for (const auto& lower_left : std::vector< DomainType >({{0.0, 0.0}, {0.5, 0.5}}))
+    check_batched(*function.with_mu(Parameter("value", {1.0, 2.0, 3.0, 4.0}))
+                   ->local_function(FakeSquareEntity(lower_left, 0.25)));
+}
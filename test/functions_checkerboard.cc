@@ -0,0 +1,93 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <vector>
+
+#include <dune/stuff/common/float_cmp.hh>
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/functions/constant.hh>
+
+#include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/functions/checkerboard.hh>
+
+#include "functions.hh"
+
+using namespace Dune;
+using namespace Dune::Pymor;
+
+typedef Functions::Checkerboard< FakeSquareEntity, double, 2, double, 1 >       CheckerboardType;
+typedef Stuff::Functions::Constant< FakeSquareEntity, double, 2, double, 1 >    ConstantType;
+typedef CheckerboardType::RangeType                                             RangeType;
+
+static double evaluate(const CheckerboardType::NonparametricType& function, const FakeSquareEntity& entity)
+{
+  RangeType ret(0);
+  function.local_function(entity)->evaluate(CheckerboardType::DomainType(0.5), ret);
+  return ret[0];
+}
+
+TEST(Checkerboard, cells)
+{
+  const CheckerboardType checkerboard({0.0, 0.0}, {1.0, 1.0}, {2, 2}, "value");
+  if (checkerboard.num_components() != 4 || checkerboard.has_affine_part())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (checkerboard.parameter_type() != ParameterType("value", 4))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, checkerboard.parameter_type());
+  const FakeSquareEntity entity({0.5, 0.0}, 0.25);
+  const size_t cell = checkerboard.cells().find(entity.geometry().center());
+  std::vector< size_t > active;
+  checkerboard.active_components(entity, active);
+  if (active != std::vector< size_t >(1, cell))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (!Dune::FloatCmp::eq(evaluate(*checkerboard.component(cell), entity), 1.0))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (checkerboard.coefficient(cell)->expression() != "value[" + DSC::toString(cell) + "]")
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, checkerboard.coefficient(cell)->expression());
+  const Parameter mu("value", {1.0, 2.0, 3.0, 4.0});
+  if (!Dune::FloatCmp::eq(evaluate(*checkerboard.with_mu(mu), entity), cell + 1.0))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+}
+
+TEST(Checkerboard, register_component)
+{
+  CheckerboardType checkerboard({0.0, 0.0}, {1.0, 1.0}, {2, 2}, "value");
+  checkerboard.register_affine_part(new ConstantType(RangeType(1.0)));
+  checkerboard.register_component(new ConstantType(RangeType(2.0)),
+                                  new ParameterFunctional(ParameterType("value", 4), "value[3]"));
+  if (checkerboard.num_components() != 5 || !checkerboard.has_affine_part())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (checkerboard.parameter_type() != ParameterType("value", 4))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, checkerboard.parameter_type());
+  if (checkerboard.coefficient(4)->expression() != "value[3]")
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, checkerboard.coefficient(4)->expression());
+  const FakeSquareEntity entity({0.0, 0.5}, 0.25);
+  const size_t cell = checkerboard.cells().find(entity.geometry().center());
+  std::vector< size_t > active;
+  checkerboard.active_components(entity, active);
+  if (active != std::vector< size_t >({cell, 4}))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  // the registered component may be restricted, the cell indicators may not
+  checkerboard.set_component_support(4, CheckerboardType::SupportType({0.5, 0.0}, {1.0, 0.25}));
+  checkerboard.active_components(entity, active);
+  if (active != std::vector< size_t >(1, cell))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  bool thrown = false;
+  try {
+    checkerboard.set_component_support(0, CheckerboardType::SupportType());
+  } catch (Stuff::Exceptions::you_are_using_this_wrong&) {
+    thrown = true;
+  }
+  if (!thrown)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the support of a cell was changed!");
+  // the registered parts take part in with_mu
+  const Parameter mu("value", {1.0, 2.0, 3.0, 4.0});
+  if (!Dune::FloatCmp::eq(evaluate(*checkerboard.with_mu(mu), entity), 1.0 + (cell + 1.0) + 2.0*4.0))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (!Dune::FloatCmp::eq(checkerboard.gamma(mu, mu), 1.0))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+}
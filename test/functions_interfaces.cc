@@ -0,0 +1,98 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <vector>
+
+#include <dune/stuff/common/float_cmp.hh>
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/functions/constant.hh>
+
+#include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/functions/checkerboard.hh>
+#include <dune/pymor/functions/default.hh>
+
+#include "functions.hh"
+
+using namespace Dune;
+using namespace Dune::Pymor;
+
+typedef Functions::AffinelyDecomposableDefault< FakeSquareEntity, double, 2, double, 1 >  FunctionType;
+typedef Functions::Checkerboard< FakeSquareEntity, double, 2, double, 1 >                 CheckerboardType;
+typedef Stuff::Functions::Constant< FakeSquareEntity, double, 2, double, 1 >              ConstantType;
+typedef FunctionType::RangeType                                                           RangeType;
+
+static void check_ratio_bounds(const FunctionType& function, const std::vector< Parameter >& mus)
+{
+  std::vector< double > gammas;
+  std::vector< double > alphas;
+  for (const auto& mu_2 : mus) {
+    function.gamma(mus, mu_2, gammas);
+    function.alpha(mus, mu_2, alphas);
+    if (gammas.size() != mus.size() || alphas.size() != mus.size())
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+    for (size_t ii = 0; ii < mus.size(); ++ii) {
+      const double gamma = function.gamma(mus[ii], mu_2);
+      const double alpha = function.alpha(mus[ii], mu_2);
+      // a zero theta of mu_2 gives an infinite ratio
+      if (gammas[ii] != gamma && !Dune::FloatCmp::eq(gammas[ii], gamma))
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                   "gamma(" << mus[ii] << ", " << mu_2 << ") is " << gamma << ", batched " << gammas[ii] << "!");
+      if (alphas[ii] != alpha && !Dune::FloatCmp::eq(alphas[ii], alpha))
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                   "alpha(" << mus[ii] << ", " << mu_2 << ") is " << alpha << ", batched " << alphas[ii] << "!");
+    }
+  }
+} // ... check_ratio_bounds(...)
+
+TEST(AffinelyDecomposableFunction, ratio_bounds)
+{
+  const ParameterType type("value", 3);
+  FunctionType function;
+  function.register_component(new ConstantType(RangeType(1.0)), new ParameterFunctional(type, "value[0]"));
+  function.register_component(new ConstantType(RangeType(2.0)), new ParameterFunctional(type, "value[1]"));
+  // the second parameter zeroes the first theta, the third one all thetas
+  const std::vector< Parameter > mus = {Parameter("value", {1.0, 2.0, 3.0}),
+                                        Parameter("value", {0.0, 1.0, 0.5}),
+                                        Parameter("value", {0.0, 0.0, -0.5}),
+                                        Parameter("value", {0.5, 3.0, 1.0})};
+  check_ratio_bounds(function, mus);
+  // identical parameters are not compared theta by theta
+  std::vector< double > gammas;
+  std::vector< double > alphas;
+  function.gamma(mus, mus[2], gammas);
+  function.alpha(mus, mus[2], alphas);
+  if (gammas[2] != 1.0 || alphas[2] != 1.0)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, gammas[2] << ", " << alphas[2]);
+  // the thetas of a component registered later are taken into account
+  function.register_affine_part(new ConstantType(RangeType(1.0)));
+  function.register_component(new ConstantType(RangeType(1.0)), new ParameterFunctional(type, "value[2]"));
+  check_ratio_bounds(function, mus);
+}
+
+TEST(AffinelyDecomposableFunction, checkerboard_ratio_bounds)
+{
+  const CheckerboardType checkerboard({0.0, 0.0}, {1.0, 1.0}, {2, 1}, "value");
+  // zero cell values give 0/0 for identical parameters
+  const std::vector< Parameter > mus = {Parameter("value", {0.0, 0.0}),
+                                        Parameter("value", {1.0, 0.5}),
+                                        Parameter("value", {0.0, 2.0})};
+  check_ratio_bounds(checkerboard, mus);
+  for (const auto& mu : mus) {
+    if (checkerboard.gamma(mu, mu) != 1.0 || checkerboard.alpha(mu, mu) != 1.0)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                 checkerboard.gamma(mu, mu) << ", " << checkerboard.alpha(mu, mu) << " for " << mu << "!");
+    std::vector< double > gammas;
+    std::vector< double > alphas;
+    checkerboard.gamma(mus, mu, gammas);
+    checkerboard.alpha(mus, mu, alphas);
+    for (size_t ii = 0; ii < mus.size(); ++ii)
+      if (mus[ii] == mu && (gammas[ii] != 1.0 || alphas[ii] != 1.0))
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                   gammas[ii] << ", " << alphas[ii] << " for " << mu << "!");
+  }
+}
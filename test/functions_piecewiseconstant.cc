@@ -0,0 +1,100 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <memory>
+#include <vector>
+
+#include <dune/stuff/common/float_cmp.hh>
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/functions/interfaces.hh>
+#include <dune/stuff/functions/constant.hh>
+
+#include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/functions/checkerboard.hh>
+#include <dune/pymor/functions/piecewiseconstant.hh>
+#include <dune/pymor/functions/default.hh>
+
+#include "functions.hh"
+
+using namespace Dune;
+using namespace Dune::Pymor;
+
+typedef Functions::AffinelyDecomposableDefault< FakeSquareEntity, double, 2, double, 1 >  FunctionType;
+typedef Functions::Checkerboard< FakeSquareEntity, double, 2, double, 1 >                 CheckerboardType;
+typedef Functions::PiecewiseConstant< FakeSquareEntity, double, 2, double, 1 >            PiecewiseConstantType;
+typedef Stuff::Functions::Constant< FakeSquareEntity, double, 2, double, 1 >              ConstantType;
+typedef FunctionType::DomainType                                                          DomainType;
+typedef FunctionType::RangeType                                                           RangeType;
+typedef FunctionType::JacobianRangeType                                                   JacobianRangeType;
+
+
+/**
+ * \brief 0 left of x[0] = 0.5 and 1 right of it, which is of order 0 but not constant.
+ */
+class StepFunction
+  : public Stuff::GlobalFunctionInterface< FakeSquareEntity, double, 2, double, 1 >
+{
+public:
+  virtual size_t order() const override
+  {
+    return 0;
+  }
+
+  virtual void evaluate(const DomainType& xx, RangeType& ret) const override
+  {
+    ret[0] = xx[0] < 0.5 ? 0.0 : 1.0;
+  }
+
+  virtual void jacobian(const DomainType& /*xx*/, JacobianRangeType& ret) const override
+  {
+    ret *= 0.0;
+  }
+}; // class StepFunction
+
+
+static double evaluate(const FunctionType::NonparametricType& function, const FakeSquareEntity& entity)
+{
+  RangeType ret(0);
+  function.local_function(entity)->evaluate(DomainType(0.5), ret);
+  return ret[0];
+}
+
+
+TEST(PiecewiseConstant, collapse)
+{
+  const CheckerboardType checkerboard({0.0, 0.0}, {1.0, 1.0}, {2, 2}, "value");
+  FunctionType function;
+  function.register_affine_part(new ConstantType(RangeType(1.0)));
+  for (DUNE_STUFF_SSIZE_T qq = 0; qq < checkerboard.num_components(); ++qq)
+    function.register_component(checkerboard.component(qq), checkerboard.coefficient(qq));
+  const auto collapsed = function.with_mu(Parameter("value", {1.0, 2.0, 3.0, 4.0}));
+  if (!std::dynamic_pointer_cast< const PiecewiseConstantType >(collapsed))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "with_mu() did not collapse!");
+  for (const auto& lower_left : std::vector< DomainType >({{0.0, 0.0}, {0.75, 0.0}, {0.0, 0.75}, {0.75, 0.75}})) {
+    const FakeSquareEntity entity(lower_left, 0.25);
+    const double expected = 2.0 + checkerboard.cells().find(entity.geometry().center());
+    if (!Dune::FloatCmp::eq(evaluate(*collapsed, entity), expected))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, evaluate(*collapsed, entity) << " vs. " << expected);
+  }
+}
+
+TEST(PiecewiseConstant, no_collapse_of_order_zero)
+{
+  const ParameterType type("value", 2);
+  FunctionType function;
+  function.register_component(new ConstantType(RangeType(1.0)), new ParameterFunctional(type, "value[0]"));
+  function.register_component(new StepFunction(), new ParameterFunctional(type, "value[1]"));
+  const auto with_mu = function.with_mu(Parameter("value", {1.0, 2.0}));
+  if (std::dynamic_pointer_cast< const ConstantType >(with_mu)
+      || std::dynamic_pointer_cast< const PiecewiseConstantType >(with_mu))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "a non-constant function of order 0 was collapsed!");
+  if (!Dune::FloatCmp::eq(evaluate(*with_mu, FakeSquareEntity({0.0, 0.0}, 0.25)), 1.0))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (!Dune::FloatCmp::eq(evaluate(*with_mu, FakeSquareEntity({0.75, 0.0}, 0.25)), 3.0))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+}
@@ -0,0 +1,233 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/common/float_cmp.hh>
+#include <dune/stuff/functions/combined.hh>
+#include <dune/stuff/functions/constant.hh>
+#include <dune/stuff/functions/spe10model2.hh>
+#include <dune/stuff/playground/functions/indicator.hh>
+
+#include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/functions/spe10data.hh>
+#include <dune/pymor/functions/spe10model2.hh>
+
+#include "functions.hh"
+
+using namespace Dune;
+using namespace Dune::Pymor;
+using Functions::Spe10::Model2Data;
+
+typedef FakeCubeEntity< 3 >                                                         CubeEntity;
+typedef Functions::Spe10::Model2< CubeEntity, double, 3, double, 3, 3 >             Model2Type;
+typedef Model2Type::NonparametricType                                               NonparametricType;
+typedef Model2Type::DomainType                                                      DomainType;
+typedef Model2Type::RangeType                                                       RangeType;
+
+static const std::string data_filename = "functions_spe10.dat";
+
+/**
+ * \brief Writes value(ii) for all 3*Model2Data::num_cells values to data_filename, leaving out the last one if
+ *        incomplete is true.
+ */
+static void write_data(const std::function< std::string(size_t) >& value, const bool incomplete = false)
+{
+  std::ofstream file(data_filename);
+  const size_t num_values = 3*Model2Data::num_cells - (incomplete ? 1 : 0);
+  for (size_t ii = 0; ii < num_values; ++ii)
+    file << value(ii) << (ii % 6 == 5 ? "\n" : " ");
+  file << "\n";
+  if (!file)
+    DUNE_THROW(Stuff::Exceptions::external_error, "could not write '" << data_filename << "'!");
+} // ... write_data(...)
+
+static std::string small_value(const size_t ii)
+{
+  return std::to_string(1 + ii % 7);
+}
+
+static std::string large_value(const size_t ii)
+{
+  return std::to_string(10 + ii % 7);
+}
+
+static void check_values(const Model2Data& data, const size_t first)
+{
+  for (size_t dd = 0; dd < 3; ++dd)
+    for (size_t ii : {size_t(0), size_t(5), Model2Data::num_cells - 1})
+      if (data.permeability(dd)[ii] != double(first + (dd*Model2Data::num_cells + ii) % 7))
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                   "permeability(" << dd << ")[" << ii << "] is " << data.permeability(dd)[ii] << "!");
+} // ... check_values(...)
+
+TEST(Spe10Model2Data, parse)
+{
+  write_data(small_value);
+  const auto data = Model2Data::load(data_filename, "");
+  if (data->from_cache())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the cache is disabled!");
+  check_values(*data, 1);
+  bool caught = false;
+  try {
+    data->permeability(3);
+  } catch (Stuff::Exceptions::index_out_of_range&) {
+    caught = true;
+  }
+  if (!caught)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "permeability(3) did not throw!");
+  // a missing file
+  caught = false;
+  try {
+    Model2Data::load("functions_spe10.does_not_exist", "");
+  } catch (Stuff::Exceptions::external_error&) {
+    caught = true;
+  }
+  if (!caught)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "a missing file did not throw!");
+  // a value too few
+  write_data(small_value, true);
+  caught = false;
+  try {
+    Model2Data::load(data_filename, "");
+  } catch (Stuff::Exceptions::wrong_input_given&) {
+    caught = true;
+  }
+  if (!caught)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "an incomplete file did not throw!");
+  // something which is not a number
+  write_data([](const size_t ii) { return ii == 1000 ? std::string("1x") : small_value(ii); });
+  caught = false;
+  try {
+    Model2Data::load(data_filename, "");
+  } catch (Stuff::Exceptions::wrong_input_given&) {
+    caught = true;
+  }
+  if (!caught)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "a malformed file did not throw!");
+  std::remove(data_filename.c_str());
+}
+
+TEST(Spe10Model2Data, cache)
+{
+  const std::string cache_filename = data_filename + ".cache";
+  std::remove(cache_filename.c_str());
+  write_data(small_value);
+  auto data = Model2Data::load(data_filename);
+  if (data->from_cache() || !std::ifstream(cache_filename))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the cache was not written!");
+  // loads of the same file share the data as long as it is alive
+  if (Model2Data::load(data_filename) != data)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the data is not shared!");
+  data.reset();
+  data = Model2Data::load(data_filename);
+  if (!data->from_cache())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the cache was not used!");
+  check_values(*data, 1);
+  data.reset();
+  // a changed file invalidates the cache, which is rebuilt
+  write_data(large_value);
+  data = Model2Data::load(data_filename);
+  if (data->from_cache())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the outdated cache was used!");
+  check_values(*data, 10);
+  data.reset();
+  data = Model2Data::load(data_filename);
+  if (!data->from_cache())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the rebuilt cache was not used!");
+  check_values(*data, 10);
+  data.reset();
+  // a broken cache is ignored and rebuilt
+  std::ofstream(cache_filename) << "broken";
+  data = Model2Data::load(data_filename);
+  if (data->from_cache())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the broken cache was used!");
+  check_values(*data, 10);
+  data.reset();
+  if (!Model2Data::load(data_filename)->from_cache())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "the broken cache was not rebuilt!");
+  std::remove(cache_filename.c_str());
+  std::remove(data_filename.c_str());
+}
+
+static RangeType evaluate(const NonparametricType& function, const CubeEntity& entity)
+{
+  RangeType ret(0);
+  function.local_function(entity)->evaluate(DomainType(0.5), ret);
+  return ret;
+}
+
+static void check_equal(const RangeType& value, const RangeType& expected, const std::string& name)
+{
+  for (size_t ii = 0; ii < 3; ++ii)
+    for (size_t jj = 0; jj < 3; ++jj)
+      if (!Stuff::Common::FloatCmp::eq(value[ii][jj], expected[ii][jj]))
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                   name << "[" << ii << "][" << jj << "] is " << value[ii][jj] << ", should be " << expected[ii][jj]
+                   << "!");
+} // ... check_equal(...)
+
+/**
+ * \brief Compares Model2 to the composition of dune-stuff functions it was built of before it was flattened.
+ */
+TEST(Spe10Model2, matches_composition)
+{
+  typedef Stuff::Functions::Spe10::Model2< CubeEntity, double, 3, double, 3, 3 > Spe10FunctionType;
+  typedef Stuff::Functions::Constant< CubeEntity, double, 3, double, 1 >         ScalarConstantFunctionType;
+  typedef Stuff::Functions::DomainIndicator< CubeEntity, double, 3, double, 1 >  ScalarIndicatorFunctionType;
+  typedef Stuff::Functions::DomainIndicator< CubeEntity, double, 3, double, 3, 3 > TensorIndicatorFunctionType;
+  // unit cells, the blockade covers the cells 100 to 119 in y direction
+  write_data([](const size_t ii) { return std::to_string(0.001 + (ii % 1013)*19.7); });
+  const DomainType lower_left(0.);
+  const DomainType upper_right({60., 220., 85.});
+  const double blockade_width = 20.;
+  const double blockade_value = 0.5;
+  const double min = 0.1;
+  const double max = 1000.;
+  const Model2Type model2(data_filename, "model2", lower_left, upper_right, blockade_width, blockade_value, true,
+                          min, max);
+  if (model2.num_components() != 1 || !model2.has_affine_part())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, model2.num_components());
+  const Parameter mu("blockade", 0.3);
+  const auto model2_with_mu = model2.with_mu(mu);
+  // the composition
+  const auto spe10 = std::make_shared< Spe10FunctionType >(data_filename, "spe10", lower_left, upper_right, true,
+                                                           min, max);
+  const DomainType blockade_lower({0., 100., 0.});
+  const DomainType blockade_upper({60., 120., 85.});
+  const auto one = std::make_shared< ScalarConstantFunctionType >(1, "one");
+  const auto blockade = std::shared_ptr< ScalarIndicatorFunctionType >(
+        new ScalarIndicatorFunctionType({{{blockade_lower, blockade_upper}, 1.}}));
+  RangeType blockade_scaled_value(0.);
+  blockade_scaled_value[0][0] = blockade_scaled_value[1][1] = blockade_scaled_value[2][2] = blockade_value;
+  const auto blockade_scaled = std::shared_ptr< TensorIndicatorFunctionType >(
+        new TensorIndicatorFunctionType({{{blockade_lower, blockade_upper}, blockade_scaled_value}}));
+  const auto blockade_remover = Stuff::Functions::make_difference(one, blockade, "blockade_remover");
+  const auto spe10_wo_blockade = Stuff::Functions::make_product(blockade_remover, spe10, "spe10_wo_blockade");
+  const auto affine_part = Stuff::Functions::make_sum(spe10_wo_blockade, blockade_scaled, "spe10_w_scaled_blockade");
+  const auto component = Stuff::Functions::make_difference(spe10, affine_part, "component");
+  // cells at the corners, within and next to the blockade
+  for (const auto& cell : {DomainType({0., 0., 0.}), DomainType({59., 219., 84.}), DomainType({7., 105., 3.}),
+                           DomainType({12., 119., 80.}), DomainType({30., 99., 40.}), DomainType({45., 120., 17.})}) {
+    const CubeEntity entity(cell, 1.);
+    const RangeType expected_affine_part = evaluate(*affine_part, entity);
+    const RangeType expected_component = evaluate(*component, entity);
+    RangeType expected_with_mu = expected_component;
+    expected_with_mu *= 0.3;
+    expected_with_mu += expected_affine_part;
+    check_equal(evaluate(*model2.affine_part(), entity), expected_affine_part, "affine_part");
+    check_equal(evaluate(*model2.component(0), entity), expected_component, "component");
+    check_equal(evaluate(*model2_with_mu, entity), expected_with_mu, "with_mu");
+  }
+  std::remove((data_filename + ".cache").c_str());
+  std::remove(data_filename.c_str());
+}
@@ -0,0 +1,78 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <memory>
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/functions/constant.hh>
+
+#include <dune/pymor/parameters/base.hh>
+#include <dune/pymor/parameters/functional.hh>
+#include <dune/pymor/functions/support.hh>
+#include <dune/pymor/functions/default.hh>
+
+#include "functions.hh"
+
+using namespace Dune;
+using namespace Dune::Pymor;
+
+typedef FunctionSupport< FakeSquareEntity, double, 2 >                                        SupportType;
+typedef Functions::AffinelyDecomposableDefault< FakeSquareEntity, double, 2, double, 1 >      FunctionType;
+typedef Stuff::Functions::Constant< FakeSquareEntity, double, 2, double, 1 >                  ConstantType;
+typedef FunctionType::RangeType                                                               RangeType;
+
+TEST(FunctionSupport, intersects)
+{
+  const FakeSquareEntity left({0.0, 0.0}, 0.25);
+  const FakeSquareEntity right({0.75, 0.0}, 0.25);
+  const SupportType everywhere;
+  if (!everywhere.everywhere() || !everywhere.intersects(left) || !everywhere.intersects(right))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  // boxes are closed, so touching counts
+  const SupportType box({0.25, 0.0}, {0.5, 1.0});
+  if (box.everywhere() || !box.intersects(left) || box.intersects(right))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  const SupportType elements(std::make_shared< const std::vector< bool > >(std::vector< bool >({false, true})),
+                             [](const FakeSquareEntity& entity) { return entity.geometry().center()[0] < 0.5 ? 0 : 1; });
+  if (elements.everywhere() || elements.intersects(left) || !elements.intersects(right))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  bool thrown = false;
+  try {
+    SupportType({1.0, 0.0}, {0.0, 1.0});
+  } catch (Stuff::Exceptions::wrong_input_given&) {
+    thrown = true;
+  }
+  if (!thrown)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "an empty box was accepted!");
+}
+
+TEST(FunctionSupport, active_components)
+{
+  const ParameterType type("diffusion", 3);
+  FunctionType function;
+  function.register_component(new ConstantType(RangeType(1.0)), new ParameterFunctional(type, "diffusion[0]"));
+  function.register_component(new ConstantType(RangeType(2.0)), new ParameterFunctional(type, "diffusion[1]"));
+  function.register_component(new ConstantType(RangeType(4.0)), new ParameterFunctional(type, "diffusion[2]"));
+  function.set_component_support(1, SupportType({0.0, 0.0}, {0.5, 1.0}));
+  function.set_component_support(2, SupportType({0.75, 0.75}, {1.0, 1.0}));
+  if (!function.component_support(0).everywhere() || function.component_support(1).everywhere())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  const FakeSquareEntity entity({0.0, 0.0}, 0.25);
+  std::vector< size_t > active;
+  function.active_components(entity, active);
+  if (active != std::vector< size_t >({0, 1}))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  bool thrown = false;
+  try {
+    function.component_support(3);
+  } catch (Stuff::Exceptions::index_out_of_range&) {
+    thrown = true;
+  }
+  if (!thrown)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "component_support(3) did not throw!");
+}
@@ -0,0 +1,52 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#ifndef DUNE_PYMOR_TEST_LA_HH
+#define DUNE_PYMOR_TEST_LA_HH
+
+#include <cmath>
+#include <vector>
+
+#include <dune/stuff/la/container.hh>
+#include <dune/stuff/common/exceptions.hh>
+
+typedef Dune::Stuff::LA::CommonDenseVector< double > VectorType;
+typedef Dune::Stuff::LA::CommonDenseMatrix< double > MatrixType;
+
+/**
+ * \brief The symmetric positive definite tridiagonal matrix with 2 + ii on the diagonal and -1 next to it, to be used
+ *        as a product.
+ */
+inline MatrixType create_product_matrix(const size_t dim)
+{
+  MatrixType matrix(dim, dim, 0.0);
+  for (size_t ii = 0; ii < dim; ++ii) {
+    matrix.set_entry(ii, ii, 2.0 + ii);
+    if (ii > 0) {
+      matrix.set_entry(ii, ii - 1, -1.0);
+      matrix.set_entry(ii - 1, ii, -1.0);
+    }
+  }
+  return matrix;
+} // ... create_product_matrix(...)
+
+inline double euclidean_product(const VectorType& xx, const VectorType& yy)
+{
+  return xx.dot(yy);
+}
+
+template< class ProductType >
+void check_orthonormality(const std::vector< VectorType >& basis, const ProductType& product)
+{
+  for (size_t ii = 0; ii < basis.size(); ++ii)
+    for (size_t jj = 0; jj < basis.size(); ++jj) {
+      const double expected = (ii == jj) ? 1.0 : 0.0;
+      if (std::abs(product(basis[ii], basis[jj]) - expected) > 1e-12)
+        DUNE_THROW(Dune::Stuff::Exceptions::results_are_not_as_expected,
+                   "(basis[" << ii << "], basis[" << jj << "]) = " << product(basis[ii], basis[jj]) << "!");
+    }
+} // ... check_orthonormality(...)
+
+#endif // DUNE_PYMOR_TEST_LA_HH
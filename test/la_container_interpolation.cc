@@ -0,0 +1,88 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <memory>
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/la/container/common.hh>
+
+#include <dune/pymor/la/container/interpolation.hh>
+#include <dune/pymor/parameters/base.hh>
+
+using namespace Dune;
+using namespace Dune::Pymor;
+
+typedef Stuff::LA::CommonDenseVector< double > VectorType;
+
+static const size_t dim = 200;
+
+static double entry(const Parameter& mu, const size_t ii)
+{
+  return 1./(1. + mu.get("mu")[0]*ii/double(dim));
+}
+
+static std::shared_ptr< const VectorType > generate(const Parameter& mu)
+{
+  auto ret = std::make_shared< VectorType >(dim);
+  for (size_t ii = 0; ii < dim; ++ii)
+    ret->set_entry(ii, entry(mu, ii));
+  return ret;
+}
+
+static std::vector< Parameter > training_set()
+{
+  std::vector< Parameter > ret;
+  for (size_t ii = 0; ii < 50; ++ii)
+    ret.emplace_back("mu", 10.*ii/49.);
+  return ret;
+}
+
+TEST(EmpiricalInterpolation, LA_Container_Interpolation)
+{
+  LA::EmpiricalInterpolation< VectorType > interpolation(generate);
+  const auto container = interpolation.build(training_set(), 30, 1e-12);
+  if (container.num_components() == 0 || container.num_components() == 30)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, container.num_components());
+  if (interpolation.max_errors().back() > 1e-12)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, interpolation.max_errors().back());
+  for (const double value : {3.3, 7.77}) {
+    const Parameter mu("mu", value);
+    auto difference = container.freeze_parameter(mu);
+    difference -= *generate(mu);
+    if (difference.sup_norm() > 1e-10)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, difference.sup_norm());
+  }
+}
+
+TEST(EmpiricalInterpolation, LA_Container_Interpolation_restricted)
+{
+  size_t num_calls = 0;
+  LA::EmpiricalInterpolation< VectorType > interpolation(
+        generate,
+        [&](const Parameter& mu, const std::vector< size_t >& indices, std::vector< double >& ret) {
+          ++num_calls;
+          ret.resize(indices.size());
+          for (size_t ii = 0; ii < indices.size(); ++ii)
+            ret[ii] = entry(mu, indices[ii]);
+        });
+  const auto container = interpolation.build(training_set(), 5);
+  if (container.num_components() != 5)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, container.num_components());
+  container.freeze_parameter(Parameter("mu", 2.));
+  // all coefficients share one evaluation
+  if (num_calls != 1)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, num_calls);
+  bool caught = false;
+  try {
+    container.save("la_container_interpolation.bin");
+  } catch (Stuff::Exceptions::you_are_using_this_wrong&) {
+    caught = true;
+  }
+  if (!caught)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "coefficients given by functions must not be saved!");
+}
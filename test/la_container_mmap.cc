@@ -0,0 +1,93 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <cstdio>
+
+#include <dune/stuff/common/exceptions.hh>
+#include <dune/stuff/common/float_cmp.hh>
+#include <dune/stuff/la/container/common.hh>
+
+#include <dune/pymor/la/container/affine.hh>
+#include <dune/pymor/parameters/functional.hh>
+
+using namespace Dune;
+using namespace Dune::Pymor;
+
+TEST(AffinelyDecomposedConstContainer, LA_Container_Mmap)
+{
+  typedef Stuff::LA::CommonDenseVector< double > VectorType;
+  typedef Stuff::LA::CommonDenseMatrix< double > MatrixType;
+  const std::string filename = "la_container_mmap.bin";
+  // vectors
+  LA::AffinelyDecomposedConstContainer< VectorType > vectors(new VectorType(10, 1.));
+  vectors.register_component(new VectorType(10, 2.), new ParameterFunctional("diffusion", 2, "diffusion[1]"));
+  vectors.register_component(new VectorType(10, 3.), new ParameterFunctional("force", 1, "sin(force[0])"));
+  vectors.save(filename);
+  const auto loaded_vectors = LA::AffinelyDecomposedConstContainer< VectorType >::load_copy(filename);
+  if (loaded_vectors.parameter_type() != vectors.parameter_type())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, loaded_vectors.parameter_type());
+  if (!loaded_vectors.has_affine_part() || loaded_vectors.num_components() != 2)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (loaded_vectors.coefficient(1)->expression() != "sin(force[0])")
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, loaded_vectors.coefficient(1)->expression());
+  // nothing has been read so far
+  if (loaded_vectors.memory_footprint().total() != 0)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, loaded_vectors.memory_footprint().report());
+  // copies share the containers read by any of them
+  const auto copied_vectors = loaded_vectors;
+  const Parameter mu({"diffusion", "force"}, {{1., 2.}, {0.5}});
+  auto difference = vectors.freeze_parameter(mu);
+  difference -= copied_vectors.freeze_parameter(mu);
+  if (Stuff::Common::FloatCmp::ne(difference.sup_norm(), 0.))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, difference.sup_norm());
+  if (loaded_vectors.memory_footprint().total() == 0 || loaded_vectors.component(1) != copied_vectors.component(1))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, loaded_vectors.memory_footprint().report());
+  // matrices, without affine part
+  LA::AffinelyDecomposedConstContainer< MatrixType > matrices(new MatrixType(3, 4, 1.),
+                                                              new ParameterFunctional("diffusion", 1, "diffusion[0]"));
+  matrices.save(filename);
+  const auto loaded_matrices = LA::AffinelyDecomposedConstContainer< MatrixType >::load_copy(filename);
+  if (loaded_matrices.has_affine_part() || loaded_matrices.num_components() != 1)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (loaded_matrices.component(0)->rows() != 3 || loaded_matrices.component(0)->cols() != 4
+      || Stuff::Common::FloatCmp::ne(loaded_matrices.component(0)->get_entry(2, 3), 1.))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  // the file contains matrices
+  bool caught = false;
+  try {
+    LA::AffinelyDecomposedConstContainer< VectorType >::load_copy(filename);
+  } catch (Stuff::Exceptions::wrong_input_given&) {
+    caught = true;
+  }
+  if (!caught)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  std::remove(filename.c_str());
+}
+
+TEST(AffinelyDecomposedConstContainer, LA_Container_Mmap_Overwrite)
+{
+  typedef Stuff::LA::CommonDenseVector< double > VectorType;
+  typedef LA::AffinelyDecomposedConstContainer< VectorType > ContainerType;
+  const std::string filename = "la_container_mmap_overwrite.bin";
+  ContainerType vectors(new VectorType(10, 1.));
+  vectors.register_component(new VectorType(10, 2.), new ParameterFunctional("diffusion", 1, "diffusion[0]"));
+  vectors.save(filename);
+  // a loaded container keeps reading the previous file if it is replaced, even if nothing has been read so far
+  const auto loaded = ContainerType::load_copy(filename);
+  ContainerType other(new VectorType(10, 3.));
+  other.register_component(new VectorType(10, 4.), new ParameterFunctional("diffusion", 1, "diffusion[0]"));
+  other.save(filename);
+  const Parameter mu("diffusion", 1.);
+  if (Stuff::Common::FloatCmp::ne(loaded.freeze_parameter(mu).get_entry(9), 3.))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, loaded.freeze_parameter(mu).get_entry(9));
+  // a loaded container may be saved to the file it was loaded from
+  const auto reloaded = ContainerType::load_copy(filename);
+  reloaded.save(filename);
+  if (Stuff::Common::FloatCmp::ne(ContainerType::load_copy(filename).freeze_parameter(mu).get_entry(9), 7.))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, reloaded.freeze_parameter(mu).get_entry(9));
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,89 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <cmath>
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/operators/base.hh>
+#include <dune/pymor/la/gram_schmidt.hh>
+
+#include "la.hh"
+
+using namespace Dune;
+using namespace Dune::Pymor;
+
+static const size_t test_dim = 50;
+
+/**
+ * \brief 40 vectors spanning a 30 dimensional space, the last ten are linear combinations of earlier ones.
+ */
+static std::vector< VectorType > create_vectors()
+{
+  std::vector< VectorType > ret;
+  for (size_t ii = 0; ii < 30; ++ii) {
+    VectorType vector(test_dim, 0.0);
+    for (size_t jj = 0; jj < test_dim; ++jj)
+      vector.set_entry(jj, std::sin(0.3*(ii + 1)*jj + ii) + (ii == jj ? 1e-3 : 0.0));
+    ret.emplace_back(vector);
+  }
+  for (size_t ii = 0; ii < 10; ++ii) {
+    VectorType vector = ret[ii].copy();
+    vector.axpy(-2.0, ret[29 - ii]);
+    ret.emplace_back(vector);
+  }
+  return ret;
+} // ... create_vectors(...)
+
+TEST(GramSchmidt, euclidean)
+{
+  for (size_t block_size : {1, 7, 64}) {
+    auto basis = create_vectors();
+    const LA::GramSchmidt< VectorType > gram_schmidt(1e-13, 1e-10, block_size, 3);
+    if (gram_schmidt.orthonormalize(basis) != 30)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "basis.size() = " << basis.size() << "!");
+    check_orthonormality(basis, euclidean_product);
+    // extending an orthonormal basis by dependent vectors does not change it
+    const auto vectors = create_vectors();
+    basis.push_back(vectors[3].copy());
+    basis.push_back(vectors[35].copy());
+    if (gram_schmidt.orthonormalize(basis, 30) != 30)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "basis.size() = " << basis.size() << "!");
+  }
+}
+
+TEST(GramSchmidt, product)
+{
+  const Operators::MatrixBasedDefault< MatrixType, VectorType > product(create_product_matrix(test_dim));
+  const auto basis = LA::gram_schmidt(create_vectors(), product, Parameter(), 0, 1e-13, 1e-10);
+  if (basis.size() != 30)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "basis.size() = " << basis.size() << "!");
+  check_orthonormality(basis, [&](const VectorType& xx, const VectorType& yy) { return product.apply2(xx, yy); });
+}
+
+TEST(GramSchmidt, removed)
+{
+  // dependent vectors in the middle and at the end of the basis
+  const auto vectors = create_vectors();
+  VectorType sum = vectors[0].copy();
+  sum.axpy(1.0, vectors[1]);
+  VectorType difference = vectors[2].copy();
+  difference.axpy(-3.0, vectors[0]);
+  for (size_t block_size : {1, 2, 64}) {
+    std::vector< VectorType > basis = {vectors[0].copy(), vectors[1].copy(), sum.copy(),
+                                       vectors[2].copy(), vectors[3].copy(), difference.copy()};
+    std::vector< size_t > removed;
+    const LA::GramSchmidt< VectorType > gram_schmidt(1e-13, 1e-10, block_size, 3);
+    if (gram_schmidt.orthonormalize(basis, LA::GramSchmidt< VectorType >::ProductApplyType(), 0, removed) != 4)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "basis.size() = " << basis.size() << "!");
+    if (removed != std::vector< size_t >({2, 5}))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                 "removed " << removed.size() << " vectors with block size " << block_size << "!");
+    check_orthonormality(basis, euclidean_product);
+  }
+}
@@ -0,0 +1,85 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <vector>
+
+#include <dune/stuff/la/container.hh>
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/la/localization.hh>
+
+using namespace Dune;
+using namespace Dune::Pymor;
+
+typedef Stuff::LA::CommonDenseVector< double > VectorType;
+
+/**
+ * \brief 7 subdomains with interleaved DoFs (subdomain ii % 7 owns DoF ii), reversed within each subdomain.
+ */
+static LA::SubdomainLocalization< VectorType > create_localization(const size_t global_size)
+{
+  std::vector< std::vector< size_t > > global_indices(7);
+  for (size_t ii = global_size; ii > 0; --ii)
+    global_indices[(ii - 1) % 7].push_back(ii - 1);
+  return LA::SubdomainLocalization< VectorType >(global_size, std::move(global_indices), 3);
+}
+
+TEST(SubdomainLocalization, localize_and_globalize)
+{
+  const size_t global_size = 100;
+  const auto localization = create_localization(global_size);
+  if (!localization.disjoint())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "subdomains are not disjoint!");
+  std::vector< VectorType > global_vectors;
+  for (size_t ii = 0; ii < 4; ++ii) {
+    VectorType vector(global_size, 0.0);
+    for (size_t jj = 0; jj < global_size; ++jj)
+      vector.set_entry(jj, 1000.0*ii + jj);
+    global_vectors.emplace_back(vector);
+  }
+  const auto blocks = localization.localize_vectors(global_vectors);
+  if (blocks.size() != 7)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "blocks.size() = " << blocks.size() << "!");
+  for (size_t ss = 0; ss < 7; ++ss) {
+    if (blocks[ss].size() != 4)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                 "blocks[" << ss << "].size() = " << blocks[ss].size() << "!");
+    for (size_t ii = 0; ii < 4; ++ii) {
+      const auto local_vector = localization.localize_vector(global_vectors[ii], ss);
+      for (size_t jj = 0; jj < local_vector.dim(); ++jj)
+        if (blocks[ss][ii].get_entry(jj) != local_vector.get_entry(jj)
+            || local_vector.get_entry(jj) != 1000.0*ii + localization.global_indices(ss)[jj])
+          DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                     "wrong entry " << jj << " of vector " << ii << " on subdomain " << ss << "!");
+    }
+  }
+  const auto globalized = localization.globalize_vectors(blocks);
+  if (globalized.size() != 4)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "globalized.size() = " << globalized.size() << "!");
+  for (size_t ii = 0; ii < 4; ++ii)
+    for (size_t jj = 0; jj < global_size; ++jj)
+      if (globalized[ii].get_entry(jj) != global_vectors[ii].get_entry(jj))
+        DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                   "wrong entry " << jj << " of globalized vector " << ii << "!");
+}
+
+TEST(SubdomainLocalization, overlapping)
+{
+  std::vector< std::vector< size_t > > global_indices = {{0, 1, 2}, {2, 3}};
+  const LA::SubdomainLocalization< VectorType > localization(4, std::move(global_indices));
+  if (localization.disjoint())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "subdomains are disjoint!");
+  const auto blocks = localization.localize_vectors({VectorType(4, 1.0)});
+  bool caught = false;
+  try {
+    localization.globalize_vectors(blocks);
+  } catch (Stuff::Exceptions::you_are_using_this_wrong&) {
+    caught = true;
+  }
+  if (!caught)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "overlapping subdomains were globalized!");
+}
@@ -0,0 +1,123 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <cmath>
+#include <vector>
+
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/operators/base.hh>
+#include <dune/pymor/la/pod.hh>
+
+#include "la.hh"
+
+using namespace Dune;
+using namespace Dune::Pymor;
+
+static const size_t test_dim = 60;
+
+/**
+ * \brief 48 snapshots in the span of 12 vectors with decaying weights.
+ */
+static std::vector< VectorType > create_snapshots()
+{
+  std::vector< VectorType > ret;
+  for (size_t ss = 0; ss < 48; ++ss) {
+    VectorType snapshot(test_dim, 0.0);
+    for (size_t kk = 0; kk < 12; ++kk) {
+      const double weight = std::pow(0.1, double(kk))*std::cos(0.7*(kk + 1)*ss);
+      for (size_t jj = 0; jj < test_dim; ++jj)
+        snapshot.add_to_entry(jj, weight*std::sin(0.05*(kk + 1)*(jj + 1) + kk));
+    }
+    ret.emplace_back(snapshot);
+  }
+  return ret;
+} // ... create_snapshots(...)
+
+template< class ProductType >
+static void check_modes(const std::vector< VectorType >& modes,
+                        const std::vector< VectorType >& snapshots,
+                        const ProductType& product,
+                        const double tolerance)
+{
+  check_orthonormality(modes, product);
+  // the snapshots are approximated by their projection onto the modes
+  for (size_t ss = 0; ss < snapshots.size(); ++ss) {
+    auto error = snapshots[ss].copy();
+    for (const auto& mode : modes)
+      error.axpy(-1.0*product(mode, snapshots[ss]), mode);
+    if (std::sqrt(std::abs(product(error, error))) > tolerance)
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                 "projection error of snapshot " << ss << " is " << std::sqrt(std::abs(product(error, error))) << "!");
+  }
+} // ... check_modes(...)
+
+/**
+ * \brief Each singular value has to belong to its mode: sigma_rr^2 = sum_ss (modes[rr], snapshots[ss])^2.
+ */
+static void check_singular_values(const LA::Pod< VectorType >& pod, const std::vector< VectorType >& snapshots)
+{
+  if (pod.singular_values().size() != pod.modes().size())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+               pod.singular_values().size() << " singular values for " << pod.modes().size() << " modes!");
+  for (size_t rr = 0; rr < pod.modes().size(); ++rr) {
+    double squared = 0.0;
+    for (const auto& snapshot : snapshots)
+      squared += std::pow(pod.modes()[rr].dot(snapshot), 2);
+    if (std::abs(std::sqrt(squared) - pod.singular_values()[rr]) > 1e-6*pod.singular_values()[0])
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                 "singular value " << rr << " is " << pod.singular_values()[rr] << ", should be " << std::sqrt(squared)
+                 << "!");
+  }
+} // ... check_singular_values(...)
+
+TEST(Pod, euclidean)
+{
+  const auto snapshots = create_snapshots();
+  LA::Pod< VectorType > pod(0, 1e-7, 0.0, true, 5, 3);
+  pod.compute(snapshots);
+  if (pod.modes().size() < 6 || pod.modes().size() > 12)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "pod.modes().size() = " << pod.modes().size() << "!");
+  for (size_t ii = 1; ii < pod.singular_values().size(); ++ii)
+    if (pod.singular_values()[ii] > pod.singular_values()[ii - 1])
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "singular values are not sorted!");
+  check_modes(pod.modes(), snapshots, euclidean_product, 1e-5);
+  check_singular_values(pod, snapshots);
+  // the modes are limited by max_modes
+  const auto modes = LA::pod(snapshots, 3);
+  if (modes.size() != 3)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "modes.size() = " << modes.size() << "!");
+}
+
+TEST(Pod, streaming)
+{
+  const auto snapshots = create_snapshots();
+  LA::Pod< VectorType > full(0, 1e-8);
+  full.compute(snapshots);
+  LA::Pod< VectorType > streamed(0, 1e-8);
+  for (size_t first = 0; first < snapshots.size(); first += 10)
+    streamed.extend(std::vector< VectorType >(snapshots.begin() + first,
+                                              snapshots.begin() + std::min(first + 10, snapshots.size())));
+  if (streamed.num_snapshots() != snapshots.size())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+               "streamed.num_snapshots() = " << streamed.num_snapshots() << "!");
+  check_modes(streamed.modes(), snapshots, euclidean_product, 1e-5);
+  const size_t num_compared = std::min(size_t(4), std::min(full.modes().size(), streamed.modes().size()));
+  for (size_t ii = 0; ii < num_compared; ++ii)
+    if (std::abs(full.singular_values()[ii] - streamed.singular_values()[ii]) > 1e-8*full.singular_values()[0])
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected,
+                 "singular value " << ii << " differs: " << full.singular_values()[ii] << " vs. "
+                 << streamed.singular_values()[ii] << "!");
+}
+
+TEST(Pod, product)
+{
+  const Operators::MatrixBasedDefault< MatrixType, VectorType > product(create_product_matrix(test_dim));
+  const auto snapshots = create_snapshots();
+  const auto modes = LA::pod(snapshots, product, Parameter(), 0, 1e-7);
+  check_modes(modes, snapshots, [&](const VectorType& xx, const VectorType& yy) { return product.apply2(xx, yy); }, 1e-4);
+}
@@ -0,0 +1,94 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <memory>
+#include <vector>
+
+#include <dune/stuff/common/float_cmp.hh>
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/parameters/batch.hh>
+#include <dune/pymor/parameters/sampling.hh>
+#include <dune/pymor/parameters/thetas.hh>
+
+using namespace Dune;
+using namespace Dune::Pymor;
+
+TEST(ParameterBatch, Parameters_Sampling)
+{
+  const ParameterType type({"diffusion", "force"}, {2, 1});
+  const Parameter mu1(type, {{1.0, 2.0}, {3.0}});
+  const Parameter mu2(type, {{4.0, 5.0}, {6.0}});
+  const ParameterBatch batch(std::vector< Parameter >({mu1, mu2}));
+  if (batch.size() != 2) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (batch.serialized_size() != 3) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  const std::vector< double > expected = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+  if (batch.values() != expected) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (batch.parameter(1) != mu2) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  try {
+    ParameterBatch(type, std::vector< double >(4, 0.0));
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  } catch (Stuff::Exceptions::shapes_do_not_match&) {}
+  if (ParameterBatch::deserialize(type, std::vector< double >({4.0, 5.0, 6.0})) != mu2)
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  try {
+    ParameterBatch::deserialize(type, std::vector< double >(2, 0.0));
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  } catch (Stuff::Exceptions::shapes_do_not_match&) {}
+}
+
+TEST(ParameterSampler, Parameters_Sampling)
+{
+  const ParameterType type({"diffusion", "force"}, {2, 1});
+  ParameterSampler sampler(type, 0.0, 1.0);
+  sampler.set_range("force", -1.0, 1.0);
+  // uniform
+  const auto grid = sampler.uniform({3, 2, 2});
+  if (grid.size() != 12) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (grid.parameter(0) != Parameter(type, {{0.0, 0.0}, {-1.0}}))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (grid.parameter(11) != Parameter(type, {{1.0, 1.0}, {1.0}}))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  // random and latin hypercube are reproducible and within the bounds
+  const ParameterBatch random = sampler.random(100, 1);
+  if (random.values() != sampler.random(100, 1).values())
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  const ParameterBatch lhs = sampler.latin_hypercube(100, 1);
+  for (const auto& mu : lhs.parameters())
+    if (!sampler.contains(mu)) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  // each stratum of the latin hypercube (and of the first 2^k Sobol points) contains exactly one sample
+  const ParameterBatch sobol = sampler.sobol(64);
+  for (const auto* samples : {&lhs, &sobol}) {
+    const size_t num = samples->size();
+    for (size_t dd = 0; dd < 3; ++dd) {
+      std::vector< size_t > counts(num, 0);
+      for (size_t ii = 0; ii < num; ++ii) {
+        const double unit = (samples->serialized(ii)[dd] - sampler.minima()[dd])
+                            / (sampler.maxima()[dd] - sampler.minima()[dd]);
+        ++counts[std::min(num - 1, size_t(unit*num))];
+      }
+      for (const auto& count : counts)
+        if (count != 1) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+    }
+  }
+  if (sobol.parameter(1) != Parameter(type, {{0.5, 0.5}, {0.0}}))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (sampler.sobol(4, 60).values() != std::vector< double >(sobol.values().begin() + 180, sobol.values().end()))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  // sparse grids
+  if (sampler.sparse_grid(0).size() != 1) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (sampler.sparse_grid(1).size() != 7) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (sampler.sparse_grid(2).size() != 25) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  // feed a batch into a bundle
+  const ThetaBundle bundle({std::make_shared< ParameterFunctional >("diffusion", 2, "diffusion[0]*diffusion[1]"),
+                            std::make_shared< ParameterFunctional >("force", 1, "force[0]")});
+  const auto thetas = bundle.evaluate(random);
+  const auto expected = bundle.evaluate(random.parameters());
+  if (thetas.size() != 200) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  for (size_t ii = 0; ii < thetas.size(); ++ii)
+    if (!Dune::FloatCmp::eq(thetas[ii], expected[ii])) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+}
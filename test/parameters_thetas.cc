@@ -0,0 +1,55 @@
+// This file is part of the dune-pymor project:
+//   https://github.com/pymor/dune-pymor
+// Copyright holders: Stephan Rave, Felix Schindler
+// License: BSD 2-Clause License (http://opensource.org/licenses/BSD-2-Clause)
+
+#include <dune/stuff/test/main.hxx>
+
+#include <memory>
+#include <vector>
+
+#include <dune/stuff/common/float_cmp.hh>
+#include <dune/stuff/common/exceptions.hh>
+
+#include <dune/pymor/parameters/thetas.hh>
+
+using namespace Dune;
+using namespace Dune::Pymor;
+
+TEST(ThetaBundle, Parameters_Thetas)
+{
+  typedef std::shared_ptr< const ParameterFunctional > ThetaType;
+  const std::vector< ThetaType > thetas = {std::make_shared< ParameterFunctional >("diffusion", 2, "diffusion[1]"),
+                                           std::make_shared< ParameterFunctional >("force", 1, "sin(force[0])"),
+                                           std::make_shared< ParameterFunctional >("force", 1, "sin(force[0])"),
+                                           std::make_shared< ParameterFunctional >(
+                                             ParameterType({"diffusion", "force"}, {2, 1}),
+                                             "diffusion[0] + exp(force[0])")};
+  const ThetaBundle bundle(thetas);
+  if (bundle.size() != 4) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (bundle.num_interpreted() != 2) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (bundle.parameter_type() != ParameterType({"diffusion", "force"}, {2, 1}))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  const Parameter mu1({"diffusion", "force"}, {{1.0, 2.0}, {0.0}});
+  const Parameter mu2({"diffusion", "force"}, {{3.0, 4.0}, {0.0}});
+  const auto values = bundle.evaluate(mu1);
+  if (values.size() != 4) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (!Dune::FloatCmp::eq(values[0], thetas[0]->evaluate(Parameter("diffusion", {1.0, 2.0}))))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (!Dune::FloatCmp::eq(values[1], thetas[1]->evaluate(Parameter("force", 0.0))))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (!Dune::FloatCmp::eq(values[2], values[1])) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  if (!Dune::FloatCmp::eq(values[3], thetas[3]->evaluate(mu1)))
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  const auto batch = bundle.evaluate(std::vector< Parameter >({mu1, mu2}));
+  if (batch.size() != 8) DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  const std::vector< double > expected = {2.0, 0.0, 0.0, 2.0, 4.0, 0.0, 0.0, 4.0};
+  for (size_t ii = 0; ii < expected.size(); ++ii)
+    if (!Dune::FloatCmp::eq(batch[ii], expected[ii]))
+      DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  // wrong type
+  try {
+    bundle.evaluate(Parameter("diffusion", {1.0, 2.0}));
+    DUNE_THROW(Stuff::Exceptions::results_are_not_as_expected, "");
+  } catch (Pymor::Exceptions::wrong_parameter_type&) {}
+}